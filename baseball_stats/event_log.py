@@ -0,0 +1,100 @@
+"""
+Read the engine's binary play-by-play log (engine/sim/event_log.hpp) without copying it:
+the file is memory-mapped as a numpy structured array, and decoded columns are only
+built on request.
+
+Layout: a 64-byte header (magic "3U3DEVNT", u32 version, u32 record size) followed by
+32-byte little-endian records. `state` is GameState::raw() before the PA; its bit fields
+are unpacked by decode_state().
+
+Usage: python event_log.py events.bin [--parquet events.parquet]
+"""
+import argparse
+import struct
+from pathlib import Path
+
+import numpy as np
+
+from pa_data import OUTCOME_ORDER
+
+LOG_MAGIC = b"3U3DEVNT"
+LOG_VERSION = 1
+LOG_HEADER_SIZE = 64
+
+EVENT_DTYPE = np.dtype([
+    ("game_id", "<u8"),
+    ("state", "<u8"),
+    ("batter", "<u4"),
+    ("pitcher", "<u4"),
+    ("pa_index", "<u2"),
+    ("result", "u1"),
+    ("runs", "u1"),
+    ("reserved", "<u4"),
+])
+
+# GameState bit fields: name -> (shift, width).
+STATE_FIELDS = {
+    "bases": (0, 3),
+    "outs": (3, 2),
+    "count_id": (5, 4),
+    "bottom": (9, 1),
+    "inning": (11, 6),
+    "away_slot": (17, 4),
+    "home_slot": (21, 4),
+    "away_score": (32, 16),
+    "home_score": (48, 16),
+}
+
+
+def open_event_log(path) -> np.ndarray:
+    """Memory-mapped view of every complete record (a trailing partial one is ignored)."""
+    path = Path(path)
+    with open(path, "rb") as f:
+        header = f.read(LOG_HEADER_SIZE)
+    if len(header) < LOG_HEADER_SIZE or header[:8] != LOG_MAGIC:
+        raise ValueError(f"{path}: not a threeup3down event log")
+    version, record_size = struct.unpack_from("<2I", header, 8)
+    if version != LOG_VERSION or record_size != EVENT_DTYPE.itemsize:
+        raise ValueError(f"{path}: unsupported event log version {version} / record size {record_size}")
+    count = (path.stat().st_size - LOG_HEADER_SIZE) // EVENT_DTYPE.itemsize
+    if count == 0:
+        return np.zeros(0, dtype=EVENT_DTYPE)
+    return np.memmap(path, dtype=EVENT_DTYPE, mode="r", offset=LOG_HEADER_SIZE, shape=(count,))
+
+
+def decode_state(state: np.ndarray) -> dict:
+    """Unpacks GameState::raw() words into one integer column per field."""
+    state = np.asarray(state, dtype=np.uint64)
+    columns = {}
+    for name, (shift, width) in STATE_FIELDS.items():
+        field = (state >> np.uint64(shift)) & np.uint64((1 << width) - 1)
+        columns[name] = field.astype(np.uint16 if width > 8 else np.uint8)
+    return columns
+
+
+def to_dataframe(events: np.ndarray):
+    """One row per PA with the state unpacked and the result named as in OUTCOME_ORDER."""
+    import pandas as pd
+
+    columns = {name: events[name] for name in ("game_id", "pa_index", "batter", "pitcher", "runs")}
+    columns.update(decode_state(events["state"]))
+    columns["result"] = pd.Categorical.from_codes(events["result"].astype(np.int8), categories=OUTCOME_ORDER)
+    return pd.DataFrame(columns)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("log", type=Path)
+    parser.add_argument("--parquet", type=Path, help="write the decoded table as Parquet (needs pyarrow)")
+    args = parser.parse_args()
+
+    events = open_event_log(args.log)
+    games = np.unique(events["game_id"]).size
+    print(f"{args.log}: {events.size} PAs over {games} games")
+    if args.parquet:
+        to_dataframe(events).to_parquet(args.parquet, index=False)
+        print(f"Wrote {args.parquet}")
+
+
+if __name__ == "__main__":
+    main()
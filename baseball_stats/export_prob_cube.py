@@ -0,0 +1,69 @@
+"""
+Enumerate the trained PA outcome model over its whole (tiny) feature space and write it
+as a flat binary cube the C++ engine can mmap (engine/model/probability_cube.hpp).
+
+Cube axes: count_id (16, balls*4 + strikes) x platoon_same (2) x inning (1..N) x outs (3).
+Each cell is the cumulative outcome distribution in OUTCOME_ORDER (8 little-endian f32s, last
+== 1), so a sim-time lookup is one indexed load of a 32-byte row.
+
+Usage: python export_prob_cube.py [--innings 12] [--out pa_outcome_cube.bin]
+"""
+import argparse
+import struct
+from pathlib import Path
+
+import numpy as np
+
+from pa_data import OUTCOME_ORDER
+from pa_model import outcome_probs_for_sim
+from sim_rates import load_outcome_model
+
+CUBE_MAGIC = b"3U3DCUBE"
+CUBE_VERSION = 1
+CUBE_HEADER_SIZE = 64  # keeps every 32-byte row aligned in the mapped file
+NUM_COUNTS = 16
+NUM_PLATOON = 2
+NUM_OUTS = 3
+FIRST_INNING = 1
+
+
+def build_cube(clf, le, meta: dict, innings: int) -> np.ndarray:
+    """Probabilities for every cell via outcome_probs_for_sim, as cumulative rows."""
+    cube = np.zeros((NUM_COUNTS, NUM_PLATOON, innings, NUM_OUTS, len(OUTCOME_ORDER)), dtype=np.float32)
+    feature_names = meta.get("feature_names")
+    for count_id in range(NUM_COUNTS):
+        for platoon_same in range(NUM_PLATOON):
+            for i in range(innings):
+                for outs in range(NUM_OUTS):
+                    probs = outcome_probs_for_sim(clf, le, count_id=count_id, platoon_same=platoon_same,
+                                                  inning=FIRST_INNING + i, outs=outs, feature_names=feature_names)
+                    row = np.array([probs.get(o, 0.0) for o in OUTCOME_ORDER], dtype=np.float64)
+                    cumulative = np.cumsum(row / row.sum())
+                    cumulative[-1] = 1.0
+                    cube[count_id, platoon_same, i, outs] = cumulative
+    return cube
+
+
+def write_cube(cube: np.ndarray, path) -> None:
+    counts, platoon, innings, outs, outcomes = cube.shape
+    header = CUBE_MAGIC + struct.pack("<7I", CUBE_VERSION, counts, platoon, innings, outs, outcomes, FIRST_INNING)
+    header = header.ljust(CUBE_HEADER_SIZE, b"\0")
+    with open(path, "wb") as f:
+        f.write(header)
+        f.write(cube.astype("<f4").tobytes())
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--innings", type=int, default=12, help="innings tabulated; later innings reuse the last")
+    parser.add_argument("--out", type=Path, default=Path(__file__).parent / "pa_outcome_cube.bin")
+    args = parser.parse_args()
+
+    clf, le, meta = load_outcome_model()
+    cube = build_cube(clf, le, meta, args.innings)
+    write_cube(cube, args.out)
+    print(f"Wrote {cube.shape[:-1]} cube ({args.out.stat().st_size:,} bytes) -> {args.out}")
+
+
+if __name__ == "__main__":
+    main()
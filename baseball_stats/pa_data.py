@@ -2,11 +2,20 @@
 Load plate-appearance-level data from Statcast for ML modeling.
 Each row = one completed PA with outcome (events) and context (count, batter, pitcher, etc.).
 Event -> outcome mapping is derived from Statcast data via rule-based logic (no hardcoded event list).
+
+Pulled PAs are cached as Parquet under CACHE_DIR (one file per date range), so reruns over
+the same window never go back to pybaseball.
 """
+from pathlib import Path
+
+import numpy as np
 import pandas as pd
-from pybaseball import statcast
 
 OUTCOME_ORDER = ["Walk", "HBP", "Single", "Double", "Triple", "HR", "Strikeout", "Out"]
+PLATOON_MATCHUPS = ["opposite", "same"]  # indexed by platoon_same
+NUM_COUNTS = 16  # count_id = balls * 4 + strikes
+
+CACHE_DIR = Path(__file__).parent / "cache"
 
 
 def _event_to_outcome(event: str) -> str:
@@ -39,25 +48,50 @@ def _event_to_outcome(event: str) -> str:
     return "Out"
 
 
-def fetch_statcast_pas(start_dt: str, end_dt: str) -> pd.DataFrame:
+def outcomes_from_events(events: pd.Series) -> pd.Categorical:
+    """
+    Vectorized _event_to_outcome: the rules run once per distinct event string (a few dozen),
+    then every row is mapped through the category codes. Missing events read as "Out".
+    """
+    events = events.astype("category")
+    # One slot per category plus a trailing "Out" that code -1 (missing) indexes.
+    lookup = np.array([OUTCOME_ORDER.index(_event_to_outcome(e)) for e in events.cat.categories]
+                      + [OUTCOME_ORDER.index("Out")], dtype=np.int8)
+    return pd.Categorical.from_codes(lookup[events.cat.codes.to_numpy()], categories=OUTCOME_ORDER)
+
+
+def _cache_path(start_dt: str, end_dt: str, cache_dir) -> Path:
+    return Path(cache_dir) / f"statcast_pas_{start_dt}_{end_dt}.parquet"
+
+
+def fetch_statcast_pas(start_dt: str, end_dt: str, cache_dir=CACHE_DIR, refresh: bool = False) -> pd.DataFrame:
     """
     Fetch Statcast data and keep one row per plate appearance (rows where events is set).
-    start_dt / end_dt: 'YYYY-MM-DD'
+    start_dt / end_dt: 'YYYY-MM-DD'. The PA rows are cached as Parquet in cache_dir
+    (None disables the cache); refresh=True ignores an existing file and re-pulls.
     """
+    path = _cache_path(start_dt, end_dt, cache_dir) if cache_dir is not None else None
+    if path is not None and path.exists() and not refresh:
+        return pd.read_parquet(path)
+
     import pybaseball
+    from pybaseball import statcast
     pybaseball.cache.enable()
     raw = statcast(start_dt=start_dt, end_dt=end_dt)
     if raw is None or raw.empty:
         return pd.DataFrame()
     # Only the final pitch of each PA has 'events' set
-    pas = raw[raw["events"].notna()].copy()
+    pas = raw[raw["events"].notna()].reset_index(drop=True)
+    if path is not None:
+        path.parent.mkdir(parents=True, exist_ok=True)
+        pas.to_parquet(path, index=False)
     return pas
 
 
 def map_events_to_outcomes(pas: pd.DataFrame) -> pd.DataFrame:
     """Add outcome category from Statcast 'events' using rule-based mapping (no hardcoded event list)."""
     pas = pas.copy()
-    pas["outcome"] = pas["events"].map(_event_to_outcome)
+    pas["outcome"] = outcomes_from_events(pas["events"])
     return pas
 
 
@@ -71,18 +105,60 @@ def add_platoon_info(pas: pd.DataFrame) -> pd.DataFrame:
         return pas
     
     # Same hand = 1, opposite = 0
-    same_hand = (pas["stand"].str.upper() == pas["p_throws"].str.upper())
-    pas["platoon_same"] = same_hand.astype(int)
-    pas["platoon_matchup"] = same_hand.map({True: "same", False: "opposite"})
+    same_hand = (pas["stand"].str.upper() == pas["p_throws"].str.upper()).to_numpy()
+    pas["platoon_same"] = same_hand.astype(np.int8)
+    pas["platoon_matchup"] = pd.Categorical.from_codes(same_hand.astype(np.int8), categories=PLATOON_MATCHUPS)
     return pas
 
 
-def load_pa_dataset(start_dt: str, end_dt: str) -> pd.DataFrame:
+def outcome_counts(pas: pd.DataFrame) -> pd.DataFrame:
+    """
+    One groupby pass: PA counts indexed by (platoon_same, count_id) with one column per
+    outcome in OUTCOME_ORDER. Every cell of the 2 x 16 grid is present (zeros included).
+    """
+    if "outcome" not in pas.columns:
+        pas = map_events_to_outcomes(pas)
+    if "platoon_same" not in pas.columns:
+        pas = add_platoon_info(pas)
+    count_id = pas["balls"].astype(int) * 4 + pas["strikes"].astype(int)
+    counts = (
+        pd.DataFrame({"platoon_same": pas["platoon_same"].astype(int), "count_id": count_id,
+                      "outcome": pd.Categorical(pas["outcome"], categories=OUTCOME_ORDER)})
+        .groupby(["platoon_same", "count_id", "outcome"], observed=False)
+        .size()
+        .unstack("outcome")
+    )
+    grid = pd.MultiIndex.from_product([range(len(PLATOON_MATCHUPS)), range(NUM_COUNTS)], names=["platoon_same", "count_id"])
+    return counts.reindex(index=grid, columns=OUTCOME_ORDER, fill_value=0).fillna(0).astype(np.int64)
+
+
+def rate_tables(pas: pd.DataFrame) -> dict:
+    """
+    All league rate tables from a single outcome_counts() pass:
+      "overall", "same", "opposite": {outcome: rate}
+      "by_count": DataFrame of rates indexed by (platoon_same, count_id), columns OUTCOME_ORDER
+    """
+    counts = outcome_counts(pas)
+
+    def to_rates(row: pd.Series) -> dict:
+        n = row.sum()
+        return {o: float(row[o] / n) if n else 0.0 for o in OUTCOME_ORDER}
+
+    per_platoon = counts.groupby(level="platoon_same").sum()
+    tables = {"overall": to_rates(counts.sum())}
+    for same, matchup in enumerate(PLATOON_MATCHUPS):
+        tables[matchup] = to_rates(per_platoon.loc[same])
+    totals = counts.sum(axis=1).replace(0, np.nan)
+    tables["by_count"] = counts.div(totals, axis=0).fillna(0.0)
+    return tables
+
+
+def load_pa_dataset(start_dt: str, end_dt: str, cache_dir=CACHE_DIR, refresh: bool = False) -> pd.DataFrame:
     """
     Load PA-level dataset with outcome and basic context for modeling.
     Returns DataFrame with columns including: outcome, balls, strikes, p_throws (L/R), stand (L/R), etc.
     """
-    pas = fetch_statcast_pas(start_dt, end_dt)
+    pas = fetch_statcast_pas(start_dt, end_dt, cache_dir=cache_dir, refresh=refresh)
     if pas.empty:
         return pas
     pas = map_events_to_outcomes(pas)
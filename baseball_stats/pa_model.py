@@ -11,9 +11,12 @@ Model choice (accuracy-focused, no compute limits):
 - Neural net: Can match or beat boosting with lots of data and tuning; for this dataset size
   and feature set, XGBoost is usually the best tradeoff.
 """
+import argparse
 import json
 import pickle
+import struct
 import warnings
+from collections import deque
 from pathlib import Path
 
 import numpy as np
@@ -26,7 +29,7 @@ from xgboost import XGBClassifier
 warnings.filterwarnings('ignore', category=FutureWarning, module='pybaseball')
 
 import pybaseball
-from pa_data import load_pa_dataset, OUTCOME_ORDER
+from pa_data import NUM_COUNTS, OUTCOME_ORDER, PLATOON_MATCHUPS, load_pa_dataset, rate_tables
 
 
 def build_features(pas: pd.DataFrame):
@@ -100,32 +103,224 @@ def outcome_probs_for_sim(clf, le, count_id: int, platoon_same: int, inning: int
     return dict(zip(le.classes_, probs))
 
 
+TREE_MODEL_MAGIC = b"3U3DXGB1"
+TREE_MODEL_VERSION = 1
+# Largest |exported - predict_proba| an export may show; the trees are float32, as in xgboost.
+EXPORT_TOLERANCE = 1e-5
+
+
+def _flatten_tree(tree: dict, feature_index: dict, offset: int) -> list:
+    """
+    Renumber one dumped XGBoost tree breadth-first so the two children of a split sit
+    next to each other (yes at `child`, no at `child + 1`), the layout the C++
+    OutcomeModel walks. Returns (value, feature, child, default_left) per node, with
+    child indices already offset into the shared node array.
+    """
+    nodes = [None]
+    queue = deque([(tree, 0)])
+    while queue:
+        node, slot = queue.popleft()
+        if "leaf" in node:
+            nodes[slot] = (float(node["leaf"]), -1, 0, 0)
+            continue
+        children = {c["nodeid"]: c for c in node["children"]}
+        child = len(nodes)
+        nodes.extend([None, None])
+        default_left = int(node.get("missing", node["yes"]) == node["yes"])
+        nodes[slot] = (float(node["split_condition"]), feature_index[node["split"]], offset + child, default_left)
+        queue.append((children[node["yes"]], child))
+        queue.append((children[node["no"]], child + 1))
+    return nodes
+
+
+def _base_scores(booster, num_classes: int) -> list:
+    """Initial margin per class from the booster config (scalar in xgboost 2.x, per-class in 3.x)."""
+    config = json.loads(booster.save_config())
+    raw = str(config["learner"]["learner_model_param"].get("base_score", "0.5"))
+    values = [float(v) for v in raw.strip("[]").split(",") if v.strip()]
+    if len(values) == 1:
+        values = values * num_classes
+    return values
+
+
+def export_model_trees(clf, le, meta: dict, path) -> None:
+    """
+    Write the trained classifier as a flat little-endian tree file for the C++
+    OutcomeModel (engine/model/outcome_model.hpp):
+
+        magic "3U3DXGB1", u32 version, u32 num_features, u32 num_classes,
+        u32 num_trees, u32 num_nodes,
+        num_features x (u32 length, utf-8 name),
+        u32 class_outcome[num_classes]   (index into OUTCOME_ORDER),
+        f32 base_score[num_classes],
+        u32 tree_offsets[num_trees + 1],
+        num_nodes x (f32 value, i32 feature, u32 child, u32 default_left)
+
+    Only the rounds predict_proba uses (up to best_iteration) are exported.
+    """
+    booster = clf.get_booster()
+    best = getattr(clf, "best_iteration", None)
+    if best is not None:
+        booster = booster[: best + 1]
+    feature_names = list(meta.get("feature_names") or booster.feature_names or [])
+    feature_index = {name: i for i, name in enumerate(feature_names)}
+    feature_index.update({f"f{i}": i for i in range(len(feature_names))})
+
+    classes = list(le.classes_)
+    class_outcomes = [OUTCOME_ORDER.index(c) for c in classes]
+    base_scores = _base_scores(booster, len(classes))
+
+    trees, offsets = [], [0]
+    for dump in booster.get_dump(dump_format="json"):
+        tree = _flatten_tree(json.loads(dump), feature_index, offsets[-1])
+        trees.append(tree)
+        offsets.append(offsets[-1] + len(tree))
+
+    with open(path, "wb") as f:
+        f.write(TREE_MODEL_MAGIC)
+        f.write(struct.pack("<5I", TREE_MODEL_VERSION, len(feature_names), len(classes), len(trees), offsets[-1]))
+        for name in feature_names:
+            encoded = name.encode("utf-8")
+            f.write(struct.pack("<I", len(encoded)))
+            f.write(encoded)
+        f.write(struct.pack(f"<{len(classes)}I", *class_outcomes))
+        f.write(struct.pack(f"<{len(classes)}f", *base_scores))
+        f.write(struct.pack(f"<{len(offsets)}I", *offsets))
+        for tree in trees:
+            for value, feature, child, default_left in tree:
+                f.write(struct.pack("<fiII", value, feature, child, default_left))
+
+
+def predict_proba_exported(path, X: pd.DataFrame) -> np.ndarray:
+    """
+    Reference evaluator for an export_model_trees() file, mirroring the C++ engine.
+    Returns probabilities with columns in OUTCOME_ORDER.
+    """
+    data = Path(path).read_bytes()
+    if data[:8] != TREE_MODEL_MAGIC:
+        raise ValueError(f"{path} is not an exported tree model")
+    pos = 8
+    version, num_features, num_classes, num_trees, num_nodes = struct.unpack_from("<5I", data, pos)
+    pos += 20
+    if version != TREE_MODEL_VERSION:
+        raise ValueError(f"{path}: unsupported version {version}")
+    names = []
+    for _ in range(num_features):
+        (length,) = struct.unpack_from("<I", data, pos)
+        pos += 4
+        names.append(data[pos:pos + length].decode("utf-8"))
+        pos += length
+    class_outcomes = struct.unpack_from(f"<{num_classes}I", data, pos)
+    pos += 4 * num_classes
+    base_scores = np.array(struct.unpack_from(f"<{num_classes}f", data, pos), dtype=np.float32)
+    pos += 4 * num_classes
+    offsets = struct.unpack_from(f"<{num_trees + 1}I", data, pos)
+    pos += 4 * (num_trees + 1)
+    nodes = np.frombuffer(data, dtype=[("value", "<f4"), ("feature", "<i4"), ("child", "<u4"), ("default_left", "<u4")],
+                          count=num_nodes, offset=pos)
+
+    rows = X[names].to_numpy(dtype=np.float32)
+    out = np.zeros((len(rows), len(OUTCOME_ORDER)))
+    for r, x in enumerate(rows):
+        margin = base_scores.copy()
+        for t in range(num_trees):
+            i = offsets[t]
+            while nodes["feature"][i] >= 0:
+                v = x[nodes["feature"][i]]
+                right = (v >= nodes["value"][i]) or (np.isnan(v) and not nodes["default_left"][i])
+                i = nodes["child"][i] + int(right)
+            margin[t % num_classes] += nodes["value"][i]
+        e = np.exp(margin - margin.max())
+        for c, slot in enumerate(class_outcomes):
+            out[r, slot] = e[c] / e.sum()
+    return out
+
+
+def proba_in_outcome_order(clf, le, X: pd.DataFrame) -> np.ndarray:
+    """clf.predict_proba(X) with columns in OUTCOME_ORDER (0 for classes never seen in training)."""
+    return pd.DataFrame(clf.predict_proba(X), columns=le.classes_).reindex(columns=OUTCOME_ORDER, fill_value=0.0).to_numpy()
+
+
+def check_export(clf, le, path, X: pd.DataFrame) -> float:
+    """
+    Max |p - predict_proba| of an export_model_trees() file over the rows of X.
+    Raises ValueError above EXPORT_TOLERANCE, so a bad export never ships.
+    """
+    max_err = float(np.abs(predict_proba_exported(path, X) - proba_in_outcome_order(clf, le, X)).max())
+    if max_err > EXPORT_TOLERANCE:
+        raise ValueError(f"{path}: exported trees differ from predict_proba by {max_err:.2e} "
+                         f"(tolerance {EXPORT_TOLERANCE:.0e})")
+    return max_err
+
+
+TEST_FIXTURE_NAME = "outcome_model_xgb"
+
+
+def write_test_fixture(out_dir) -> None:
+    """
+    A small real XGBClassifier for tests/outcome_model.cpp: trained on synthetic PAs
+    (same features as build_features, some innings missing so splits learn a default
+    direction), exported to <out_dir>/outcome_model_xgb.trees, with its predict_proba
+    on a fixed set of rows in <out_dir>/outcome_model_xgb.expected. Each line of that
+    file is the feature values (nan = missing) then the probabilities in OUTCOME_ORDER;
+    the first line names the columns.
+    """
+    rng = np.random.default_rng(7)
+    n = 4000
+    X = pd.DataFrame({
+        "count_id": rng.integers(0, NUM_COUNTS, n),
+        "platoon_same": rng.integers(0, 2, n),
+        "inning": rng.integers(1, 10, n).astype(float),
+        "outs_when_up": rng.integers(0, 3, n),
+    })
+    X.loc[rng.random(n) < 0.05, "inning"] = np.nan
+    # Strikes tilt toward strikeouts, balls toward walks, same hand toward outs.
+    balls, strikes = X["count_id"] // 4, X["count_id"] % 4
+    logits = np.tile(np.log([0.08, 0.01, 0.14, 0.045, 0.004, 0.03, 0.22, 0.47]), (n, 1))
+    logits[:, 0] += 0.6 * balls
+    logits[:, 6] += 0.5 * strikes
+    logits[:, 7] += 0.3 * X["platoon_same"] + 0.05 * X["outs_when_up"]
+    p = np.exp(logits)
+    p /= p.sum(axis=1, keepdims=True)
+    y = np.array([OUTCOME_ORDER[rng.choice(len(OUTCOME_ORDER), p=row)] for row in p])
+
+    le = LabelEncoder()
+    y_enc = le.fit_transform(y)
+    X_train, X_test, y_train, y_test = train_test_split(X, y_enc, test_size=0.25, random_state=0, stratify=y_enc)
+    clf = XGBClassifier(n_estimators=40, max_depth=3, learning_rate=0.3, random_state=0,
+                        early_stopping_rounds=5, eval_metric="mlogloss")
+    clf.fit(X_train, y_train, eval_set=[(X_test, y_test)], verbose=False)
+    meta = {"classes": list(le.classes_), "feature_names": list(X.columns)}
+
+    out_dir = Path(out_dir)
+    out_dir.mkdir(parents=True, exist_ok=True)
+    trees_path = out_dir / f"{TEST_FIXTURE_NAME}.trees"
+    export_model_trees(clf, le, meta, trees_path)
+
+    check = pd.concat([X.iloc[:60], pd.DataFrame({
+        "count_id": [0, 14, 3], "platoon_same": [1, 0, 1], "inning": [np.nan, np.nan, 12.0], "outs_when_up": [2, 0, 1],
+    })], ignore_index=True)
+    max_err = check_export(clf, le, trees_path, check)
+    expected = proba_in_outcome_order(clf, le, check)
+    with open(out_dir / f"{TEST_FIXTURE_NAME}.expected", "w") as f:
+        f.write(" ".join(list(check.columns) + OUTCOME_ORDER) + "\n")
+        for features, probs in zip(check.to_numpy(dtype=np.float64), expected):
+            f.write(" ".join(f"{v:.9g}" for v in list(features) + list(probs)) + "\n")
+    print(f"Wrote {trees_path} ({len(check)} expected rows, max |p - predict_proba| = {max_err:.2e})")
+
+
 def league_rates_from_data(pas: pd.DataFrame, platoon_filter: str = None) -> dict:
     """
     Simple fallback: empirical outcome rates from data (no ML).
     Use when you just need overall walk%, hit%, K%, etc. for the sim.
+    For several tables at once, call pa_data.rate_tables() (one pass over the data).
     
     Args:
         pas: DataFrame with plate appearance data
         platoon_filter: If "same" or "opposite", filter to that platoon matchup.
                        If None, use all data.
     """
-    from pa_data import map_events_to_outcomes
-    if "outcome" not in pas.columns:
-        pas = map_events_to_outcomes(pas)
-    
-    # Filter by platoon matchup if specified
-    if platoon_filter is not None:
-        if "platoon_matchup" not in pas.columns:
-            from pa_data import add_platoon_info
-            pas = add_platoon_info(pas)
-        pas = pas[pas["platoon_matchup"] == platoon_filter].copy()
-    
-    n = len(pas)
-    rates = {}
-    for outcome in OUTCOME_ORDER:
-        rates[outcome] = (pas["outcome"] == outcome).sum() / n if n else 0.0
-    return rates
+    return rate_tables(pas)["overall" if platoon_filter is None else platoon_filter]
 
 
 def main():
@@ -151,24 +346,33 @@ def main():
             pct = count / len(pas) * 100
             print(f"  {matchup}: {count:,} ({pct:.1f}%)")
 
-    # Overall empirical rates (no ML) – always useful for the sim
-    rates = league_rates_from_data(pas)
+    # Empirical rates (no ML) – always useful for the sim. Overall, per platoon matchup
+    # and per platoon x count all come out of one groupby pass.
+    tables = rate_tables(pas)
     out_path = Path(__file__).parent / "pa_outcome_rates.json"
     with open(out_path, "w") as f:
-        json.dump(rates, f, indent=2)
+        json.dump(tables["overall"], f, indent=2)
     print(f"\nWrote overall league outcome rates -> {out_path}")
 
-    # Separate rates by platoon matchup
     if "platoon_matchup" in pas.columns:
         print("\nGenerating platoon-specific rates...")
         for matchup in ["same", "opposite"]:
-            matchup_rates = league_rates_from_data(pas, platoon_filter=matchup)
+            matchup_rates = tables[matchup]
             matchup_path = Path(__file__).parent / f"pa_outcome_rates_{matchup}.json"
             with open(matchup_path, "w") as f:
                 json.dump(matchup_rates, f, indent=2)
             print(f"  Wrote {matchup}-hand rates -> {matchup_path}")
             print(f"    Sample: Walk={matchup_rates['Walk']:.4f}, K={matchup_rates['Strikeout']:.4f}, HR={matchup_rates['HR']:.4f}")
 
+        # Rates at the count the PA ended on: {"same": {"<count_id>": {outcome: rate}}}
+        by_count = tables["by_count"]
+        nested = {matchup: {str(c): by_count.loc[(same, c)].to_dict() for c in range(NUM_COUNTS)}
+                  for same, matchup in enumerate(PLATOON_MATCHUPS)}
+        by_count_path = Path(__file__).parent / "pa_outcome_rates_by_count.json"
+        with open(by_count_path, "w") as f:
+            json.dump(nested, f, indent=2)
+        print(f"  Wrote platoon x count rates -> {by_count_path}")
+
     # Train ML model for context-dependent probs (uses all data, includes platoon as feature)
     print("\nTraining outcome classifier...")
     clf, le, meta = train_model(pas)
@@ -179,6 +383,13 @@ def main():
         pickle.dump({"clf": clf, "le": le, "meta": meta}, f)
     print(f"Saved model -> {model_path}")
 
+    # Flat tree export for native inference in the C++ engine; check it against predict_proba.
+    trees_path = Path(__file__).parent / "pa_outcome_model.trees"
+    export_model_trees(clf, le, meta, trees_path)
+    X_check, _ = build_features(pas.sample(n=min(len(pas), 2000), random_state=0))
+    max_err = check_export(clf, le, trees_path, X_check)
+    print(f"Exported trees -> {trees_path} (max |p - predict_proba| = {max_err:.2e})")
+
     # Optional: Train separate models for each platoon matchup
     if "platoon_matchup" in pas.columns:
         print("\nTraining platoon-specific models...")
@@ -194,6 +405,10 @@ def main():
             with open(matchup_model_path, "wb") as f:
                 pickle.dump({"clf": matchup_clf, "le": matchup_le, "meta": matchup_meta}, f)
             print(f"    Saved {matchup}-hand model -> {matchup_model_path} (accuracy: {matchup_meta['accuracy']:.4f})")
+            matchup_trees = Path(__file__).parent / f"pa_outcome_model_{matchup}.trees"
+            export_model_trees(matchup_clf, matchup_le, matchup_meta, matchup_trees)
+            X_matchup, _ = build_features(matchup_pas.sample(n=min(len(matchup_pas), 2000), random_state=0))
+            check_export(matchup_clf, matchup_le, matchup_trees, X_matchup)
 
     # Example: probs for 0-0 count, opposite hand
     probs = outcome_probs_for_sim(clf, le, count_id=0, platoon_same=0, feature_names=meta.get("feature_names"))
@@ -201,4 +416,11 @@ def main():
 
 
 if __name__ == "__main__":
-    main()
+    parser = argparse.ArgumentParser(description="Train the PA outcome model and export it for the engine.")
+    parser.add_argument("--write-test-fixture", type=Path, metavar="DIR",
+                        help="only write the small synthetic model tests/outcome_model.cpp checks (e.g. tests/data)")
+    args = parser.parse_args()
+    if args.write_test_fixture:
+        write_test_fixture(args.write_test_fixture)
+    else:
+        main()
@@ -1,27 +1,52 @@
 """
 Use in your baseball simulator: load league rates or the ML model to get PA outcome probabilities.
+
+Models and rate files are loaded once per process and reused. For many PAs at once,
+get_outcome_probs_batch() answers them all with one predict_proba call per model.
 """
 import json
 import pickle
+from functools import lru_cache
 from pathlib import Path
 
+import numpy as np
+import pandas as pd
+
+from pa_data import OUTCOME_ORDER, PLATOON_MATCHUPS
+
 _path = Path(__file__).parent
 
 
-def load_league_rates() -> dict:
-    """Load empirical outcome rates (Walk, Single, HR, Strikeout, Out, etc.) from JSON."""
-    rates_path = _path / "pa_outcome_rates.json"
+@lru_cache(maxsize=None)
+def _read_rates(name: str) -> tuple:
+    rates_path = _path / name
     if not rates_path.exists():
         raise FileNotFoundError(
             f"Run pa_model.py first to generate {rates_path}"
         )
     with open(rates_path) as f:
-        return json.load(f)
+        rates = json.load(f)
+    return tuple(float(rates.get(o, 0.0)) for o in OUTCOME_ORDER)
+
 
+def load_league_rates(matchup: str = None) -> dict:
+    """
+    Load empirical outcome rates (Walk, Single, HR, Strikeout, Out, etc.) from JSON.
+    matchup: None for overall rates, or "same" / "opposite" for the platoon-specific files.
+    """
+    name = "pa_outcome_rates.json" if matchup is None else f"pa_outcome_rates_{matchup}.json"
+    return dict(zip(OUTCOME_ORDER, _read_rates(name)))
 
-def load_outcome_model():
-    """Load trained classifier, label encoder, and meta (includes feature_names). Returns (clf, le, meta)."""
-    model_path = _path / "pa_outcome_model.pkl"
+
+@lru_cache(maxsize=None)
+def load_outcome_model(matchup: str = None):
+    """
+    Load trained classifier, label encoder, and meta (includes feature_names). Returns (clf, le, meta).
+    matchup: None for the combined model, or "same" / "opposite" for pa_outcome_model_{matchup}.pkl.
+    The result is cached, so repeated calls cost nothing.
+    """
+    name = "pa_outcome_model.pkl" if matchup is None else f"pa_outcome_model_{matchup}.pkl"
+    model_path = _path / name
     if not model_path.exists():
         raise FileNotFoundError(
             f"Run pa_model.py first to train and save {model_path}"
@@ -32,20 +57,66 @@ def load_outcome_model():
     return data["clf"], data["le"], meta
 
 
-def get_outcome_probs(count_balls: int, count_strikes: int, same_hand: bool, use_ml: bool = True) -> dict:
+def _predict(model, count_id, platoon_same, inning, outs) -> np.ndarray:
+    """One predict_proba call; columns reordered to OUTCOME_ORDER (absent classes get 0)."""
+    clf, le, meta = model
+    fnames = meta.get("feature_names")
+    if fnames is None:
+        fnames = getattr(clf, "feature_names_in_", None)
+    if fnames is None:
+        fnames = ["count_id", "platoon_same"]
+    columns = {"count_id": count_id, "platoon_same": platoon_same, "inning": inning, "outs_when_up": outs}
+    X = pd.DataFrame({c: columns[c] for c in fnames if c in columns})
+    probs = clf.predict_proba(X)
+    out = np.zeros((len(X), len(OUTCOME_ORDER)))
+    out[:, [OUTCOME_ORDER.index(c) for c in le.classes_]] = probs
+    return out
+
+
+def get_outcome_probs_batch(balls, strikes, same_hand, inning=5, outs=0,
+                            use_ml: bool = True, platoon_models: bool = False) -> np.ndarray:
+    """
+    Outcome probabilities for many PAs at once. Arguments are arrays (or scalars, broadcast)
+    of the PA context; returns an (n, len(OUTCOME_ORDER)) array with columns in OUTCOME_ORDER.
+    platoon_models: use the same/opposite-hand models (and rate files) instead of the combined one.
+    Falls back to league rates when the model files are missing or use_ml is False.
+    """
+    balls, strikes, same_hand, inning, outs = np.broadcast_arrays(
+        np.asarray(balls, dtype=np.int64), np.asarray(strikes, dtype=np.int64),
+        np.asarray(same_hand).astype(np.int64), np.asarray(inning, dtype=np.int64), np.asarray(outs, dtype=np.int64))
+    balls, strikes, same_hand, inning, outs = (np.atleast_1d(a).ravel() for a in (balls, strikes, same_hand, inning, outs))
+    count_id = balls * 4 + strikes
+    out = np.empty((len(count_id), len(OUTCOME_ORDER)))
+
+    # (rows, which model / rate file) groups: one group overall, or one per platoon side.
+    if platoon_models:
+        groups = [(same_hand == same, PLATOON_MATCHUPS[same]) for same in range(len(PLATOON_MATCHUPS))]
+    else:
+        groups = [(np.ones(len(count_id), dtype=bool), None)]
+    for rows, matchup in groups:
+        if not rows.any():
+            continue
+        if use_ml:
+            try:
+                model = load_outcome_model(matchup)
+            except FileNotFoundError:
+                model = None
+            if model is not None:
+                out[rows] = _predict(model, count_id[rows], same_hand[rows], inning[rows], outs[rows])
+                continue
+        out[rows] = _read_rates("pa_outcome_rates.json" if matchup is None else f"pa_outcome_rates_{matchup}.json")
+    return out
+
+
+def get_outcome_probs(count_balls: int, count_strikes: int, same_hand: bool, use_ml: bool = True,
+                      inning: int = 5, outs: int = 0, platoon_models: bool = False) -> dict:
     """
     Get outcome probabilities for one plate appearance.
     same_hand: True if batter and pitcher use same hand (e.g. L vs L).
     use_ml: if True and model exists, use ML; else use league rates.
     Returns dict: outcome name -> probability (e.g. "Walk", "Single", "Strikeout", "Out", ...).
+    Prefer get_outcome_probs_batch() in loops: this is a batch of one.
     """
-    if use_ml:
-        try:
-            from pa_model import outcome_probs_for_sim
-            clf, le, meta = load_outcome_model()
-            count_id = count_balls * 4 + count_strikes
-            platoon_same = 1 if same_hand else 0
-            return outcome_probs_for_sim(clf, le, count_id=count_id, platoon_same=platoon_same, feature_names=meta.get("feature_names"))
-        except FileNotFoundError:
-            pass
-    return load_league_rates()
+    probs = get_outcome_probs_batch(count_balls, count_strikes, int(same_hand), inning, outs,
+                                    use_ml=use_ml, platoon_models=platoon_models)[0]
+    return dict(zip(OUTCOME_ORDER, (float(p) for p in probs)))
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "engine/model/roster_store.hpp"
+#include "engine/model/team.hpp"
+#include "engine/sim/game.hpp"
+#include "engine/sim/lineup_optimizer.hpp"
+#include "engine/sim/matchup_table.hpp"
+#include "engine/sim/run_expectancy.hpp"
+#include "engine/sim/season_simulator.hpp"
+#include "engine/sim/win_probability.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+inline Player make_bench_player(float r, Handedness hand = Handedness::RIGHT) {
+    BatterRatings bat{r, 1.0f - r, r, 0.5f, 0.5f, 0.5f};
+    PitcherRatings pit{r, 1.0f - r, r, 0.5f};
+    DefenseRatings def{0.5f, 0.5f, 0.5f, 0.5f, 0.5f};
+    CatcherRatings cat{0.5f, 0.5f, 0.5f, 0.5f};
+    return Player{
+        "Bench Player", 27, false, false,
+        hand, hand,
+        Ratings<BatterRatings>{bat, bat},
+        Ratings<PitcherRatings>{pit, pit},
+        Ratings<DefenseRatings>{def, def},
+        Ratings<CatcherRatings>{cat, cat},
+        std::nullopt
+    };
+}
+
+// A small league with spread-out ratings and mixed handedness: `num_teams` nine-man
+// lineups plus one starter each, a double round-robin schedule, and the league-wide
+// MatchupTable the game loop reads.
+struct BenchLeague {
+    RosterStore roster;
+    std::vector<Team> teams;
+    std::vector<ScheduledGame> schedule;
+    std::vector<GameLineup> lineups;
+    // Table row/column -> PlayerId.
+    std::vector<PlayerId> batters;
+    std::vector<PlayerId> pitchers;
+    MatchupTable table;
+
+    // Members above `table` are constructed first, so build() can fill them in.
+    explicit BenchLeague(std::uint32_t num_teams = 2) : table(build(num_teams)) {}
+
+private:
+    MatchupTable build(std::uint32_t num_teams) {
+        for (std::uint32_t t = 0; t < num_teams; ++t) {
+            Team team;
+            team.name = "Bench " + std::to_string(t);
+            GameLineup lineup;
+            for (std::size_t s = 0; s < kLineupSize; ++s) {
+                const Handedness hand = (s % 3 == 0) ? Handedness::LEFT : Handedness::RIGHT;
+                const PlayerId id = roster.add(make_bench_player(0.2f + 0.07f * s + 0.02f * t, hand));
+                team.lineup.push_back(id);
+                lineup.batters[s] = static_cast<std::uint32_t>(batters.size());
+                batters.push_back(id);
+            }
+            team.starting_pitcher = roster.add(make_bench_player(0.45f + 0.05f * t));
+            lineup.pitcher = static_cast<std::uint32_t>(pitchers.size());
+            pitchers.push_back(team.starting_pitcher);
+            teams.push_back(team);
+            lineups.push_back(lineup);
+        }
+        for (std::uint32_t h = 0; h < num_teams; ++h) {
+            for (std::uint32_t a = 0; a < num_teams; ++a) {
+                if (h != a) schedule.push_back({h, a});
+            }
+        }
+        return MatchupTable(roster, batters, pitchers);
+    }
+};
+
+// Reports throughput as PAs/sec and the inverse as ns/PA (both time-normalized by
+// the framework, so they diff cleanly between --benchmark_format=json runs).
+inline void set_pa_counters(benchmark::State& state, double plate_appearances) {
+    state.counters["PAs/s"] = benchmark::Counter(plate_appearances, benchmark::Counter::kIsRate);
+    state.counters["s/PA"] = benchmark::Counter(
+        plate_appearances, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
@@ -0,0 +1,48 @@
+#!/usr/bin/env python3
+"""
+Diff two Google Benchmark JSON runs of threeup3down_bench (see the bench_json target).
+
+Prints ns/PA where a benchmark reports it (falling back to real time per iteration) and
+the relative change, so throughput regressions between commits stand out.
+
+Usage: compare_bench.py baseline.json candidate.json
+"""
+import json
+import sys
+
+
+def load(path):
+    with open(path) as f:
+        runs = json.load(f)["benchmarks"]
+    out = {}
+    for b in runs:
+        if b.get("run_type", "iteration") != "iteration":
+            continue
+        if "s/PA" in b:
+            out[b["name"]] = ("ns/PA", b["s/PA"] * 1e9)
+        else:
+            out[b["name"]] = (b["time_unit"], b["real_time"])
+    return out
+
+
+def main():
+    if len(sys.argv) != 3:
+        print(__doc__)
+        return 2
+    base, cand = load(sys.argv[1]), load(sys.argv[2])
+    width = max((len(n) for n in base.keys() | cand.keys()), default=10)
+    print(f"{'benchmark':<{width}}  {'unit':>6}  {'baseline':>12}  {'candidate':>12}  {'change':>8}")
+    for name in sorted(base.keys() | cand.keys()):
+        if name not in base or name not in cand:
+            only = "candidate" if name in cand else "baseline"
+            print(f"{name:<{width}}  (only in {only})")
+            continue
+        unit, old = base[name]
+        _, new = cand[name]
+        change = (new - old) / old * 100 if old else float("nan")
+        print(f"{name:<{width}}  {unit:>6}  {old:>12.3f}  {new:>12.3f}  {change:>+7.1f}%")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,121 @@
+#include "bench_common.hpp"
+
+namespace {
+
+void BM_HalfInning(benchmark::State& state) {
+    BenchLeague league;
+    RNG rng(42);
+    std::size_t slot = 0;
+    double pas = 0;
+    for (auto _ : state) {
+        const HalfInningResult r = simulate_half_inning(league.table, league.lineups[0], league.lineups[1].pitcher, slot, -1, rng);
+        benchmark::DoNotOptimize(r);
+        pas += r.plate_appearances;
+    }
+    set_pa_counters(state, pas);
+}
+BENCHMARK(BM_HalfInning);
+
+void BM_Game(benchmark::State& state) {
+    BenchLeague league;
+    RNG rng(42);
+    double pas = 0;
+    for (auto _ : state) {
+        const GameResult r = simulate_game(league.table, league.lineups[0], league.lineups[1], rng);
+        benchmark::DoNotOptimize(r);
+        pas += r.plate_appearances;
+    }
+    set_pa_counters(state, pas);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Game);
+
+// Same game walked pitch by pitch; compare s/PA against BM_Game.
+void BM_GamePitchMode(benchmark::State& state) {
+    BenchLeague league;
+    const PitchMatchupTable pitches(league.roster, league.table, league.batters, league.pitchers);
+    RNG rng(42);
+    double pas = 0;
+    double thrown = 0;
+    for (auto _ : state) {
+        const GameResult r = simulate_game(pitches, league.lineups[0], league.lineups[1], rng);
+        benchmark::DoNotOptimize(r);
+        pas += r.plate_appearances;
+        thrown += r.home_pitches + r.away_pitches;
+    }
+    set_pa_counters(state, pas);
+    state.counters["pitches/PA"] = thrown / pas;
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_GamePitchMode);
+
+// Exact expected runs per nine innings for one lineup: the analytic stand-in for
+// thousands of BM_Game iterations.
+void BM_RunExpectancySolve(benchmark::State& state) {
+    BenchLeague league;
+    for (auto _ : state) {
+        const RunExpectancySolver solver(league.table, league.lineups[0], league.lineups[1].pitcher);
+        benchmark::DoNotOptimize(solver.expected_runs());
+    }
+}
+BENCHMARK(BM_RunExpectancySolve)->Unit(benchmark::kMicrosecond);
+
+// One batting order's expected runs, the unit of work LineupOptimizer repeats.
+void BM_LineupEvaluate(benchmark::State& state) {
+    BenchLeague league;
+    const LineupOptimizer optimizer(league.table, league.lineups[0], league.lineups[1].pitcher);
+    std::array<std::size_t, kLineupSize> order;
+    for (std::size_t s = 0; s < kLineupSize; ++s) order[s] = s;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(optimizer.evaluate(order));
+    }
+}
+BENCHMARK(BM_LineupEvaluate)->Unit(benchmark::kMicrosecond);
+
+// Building one game's live win-probability table, and one lookup from it (the
+// per-pitch broadcast query).
+void BM_WinProbabilityBuild(benchmark::State& state) {
+    BenchLeague league;
+    for (auto _ : state) {
+        const WinProbabilityTable wp(league.table, league.lineups[0], league.lineups[1]);
+        benchmark::DoNotOptimize(wp.lookup(GameState()));
+    }
+}
+BENCHMARK(BM_WinProbabilityBuild)->Unit(benchmark::kMillisecond);
+
+void BM_WinProbabilityLookup(benchmark::State& state) {
+    BenchLeague league;
+    const PitchMatchupTable pitches(league.roster, league.table, league.batters, league.pitchers);
+    const WinProbabilityTable wp(league.table, pitches, league.lineups[0], league.lineups[1]);
+    GameState s;
+    s.set_inning(7, true);
+    s.set_base_out(13);
+    s.set_score(3, 2);
+    // Every count a PA can be in, then the next PA's 0-0.
+    const unsigned counts[] = {0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14};
+    std::size_t i = 0;
+    for (auto _ : state) {
+        s.set_count_id(counts[i]);
+        i = i + 1 == std::size(counts) ? 0 : i + 1;
+        benchmark::DoNotOptimize(wp.lookup(s));
+    }
+}
+BENCHMARK(BM_WinProbabilityLookup);
+
+// One replication of a 30-team double round-robin (870 games), single thread.
+void BM_SeasonReplication(benchmark::State& state) {
+    BenchLeague league(30);
+    SeasonSimulator sim(league.roster, league.teams, league.schedule);
+    SeasonResults results = sim.empty_results();
+    Arena scratch;
+    std::size_t rep = 0;
+    for (auto _ : state) {
+        sim.simulate_replication(42, rep++, results, nullptr, &scratch);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(league.schedule.size()));
+    state.counters["games/s"] = benchmark::Counter(
+        static_cast<double>(state.iterations() * league.schedule.size()), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_SeasonReplication)->Unit(benchmark::kMillisecond);
+
+}  // namespace
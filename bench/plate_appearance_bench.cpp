@@ -0,0 +1,124 @@
+#include "bench_common.hpp"
+
+#include "engine/sim/batch_resolver.hpp"
+#include "engine/sim/plate_appearence.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+// Nine-man lineup against a single pitcher, the shape of a real half-inning loop.
+struct Lineup {
+    std::vector<Player> players;
+    Player pitcher = make_bench_player(0.6f);
+
+    Lineup() {
+        for (int i = 0; i < 9; ++i) players.push_back(make_bench_player(0.2f + 0.07f * i));
+    }
+};
+
+// Construction + resolve() straight from Player objects (recomputes the distribution).
+void BM_ResolveFromPlayers(benchmark::State& state) {
+    Lineup lineup;
+    RNG rng(42);
+    std::size_t slot = 0;
+    for (auto _ : state) {
+        PlateAppearance pa(lineup.players[slot], lineup.pitcher, rng);
+        benchmark::DoNotOptimize(pa.resolve());
+        slot = slot == 8 ? 0 : slot + 1;
+    }
+    set_pa_counters(state, static_cast<double>(state.iterations()));
+}
+BENCHMARK(BM_ResolveFromPlayers);
+
+// Construction + resolve() from a precomputed MatchupTable row.
+void BM_ResolveFromMatchupTable(benchmark::State& state) {
+    Lineup lineup;
+    RosterStore roster;
+    std::vector<PlayerId> batters;
+    for (const Player& p : lineup.players) batters.push_back(roster.add(p));
+    MatchupTable table(roster, batters, {roster.add(lineup.pitcher)});
+    RNG rng(42);
+    std::size_t slot = 0;
+    for (auto _ : state) {
+        PlateAppearance pa(table.at(slot, 0), rng);
+        benchmark::DoNotOptimize(pa.resolve());
+        slot = slot == 8 ? 0 : slot + 1;
+    }
+    set_pa_counters(state, static_cast<double>(state.iterations()));
+}
+BENCHMARK(BM_ResolveFromMatchupTable);
+
+// Sampling over a spread of matchup distributions with live draws: the 7-compare
+// threshold scan against the alias method.
+struct SamplingFixture {
+    std::vector<OutcomeDistribution> dists;
+    std::vector<OutcomeAliasTable> aliases;
+
+    SamplingFixture() {
+        RNG rng(7);
+        for (int i = 0; i < 1024; ++i) {
+            dists.push_back(outcome_distribution(
+                rng.uniform(), rng.uniform(), rng.uniform(), rng.uniform(), rng.uniform(), rng.uniform(), i & 1));
+            aliases.push_back(make_alias_table(dists.back()));
+        }
+    }
+};
+
+void BM_SampleThresholdScan(benchmark::State& state) {
+    SamplingFixture f;
+    RNG rng(42);
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sample_outcome(f.dists[i], rng.uniform()));
+        i = (i + 1) & 1023;
+    }
+    set_pa_counters(state, static_cast<double>(state.iterations()));
+}
+BENCHMARK(BM_SampleThresholdScan);
+
+void BM_SampleAlias(benchmark::State& state) {
+    SamplingFixture f;
+    RNG rng(42);
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sample_outcome(f.aliases[i], rng.uniform()));
+        i = (i + 1) & 1023;
+    }
+    set_pa_counters(state, static_cast<double>(state.iterations()));
+}
+BENCHMARK(BM_SampleAlias);
+
+// Resolves state.range(0) independent PAs per iteration with the given kernel.
+void BM_ResolveBatch(benchmark::State& state, BatchKernel kernel) {
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    RNG rng(42);
+    std::vector<float> contact(n), power(n), eye(n), stuff(n), control(n), movement(n), uniforms(n);
+    std::vector<std::uint8_t> same_hand(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        same_hand[i] = static_cast<std::uint8_t>(i & 1u);
+        contact[i] = rng.uniform();
+        power[i] = rng.uniform();
+        eye[i] = rng.uniform();
+        stuff[i] = rng.uniform();
+        control[i] = rng.uniform();
+        movement[i] = rng.uniform();
+        uniforms[i] = rng.uniform();
+    }
+    PlateAppearanceBatch batch{
+        contact.data(), power.data(), eye.data(),
+        stuff.data(), control.data(), movement.data(),
+        same_hand.data(), uniforms.data(), n
+    };
+    std::vector<PlateAppearanceResult> out(n);
+    for (auto _ : state) {
+        resolve_batch(batch, out.data(), kernel);
+        benchmark::ClobberMemory();
+    }
+    set_pa_counters(state, static_cast<double>(state.iterations() * state.range(0)));
+}
+BENCHMARK_CAPTURE(BM_ResolveBatch, scalar, BatchKernel::SCALAR)->Arg(4096);
+BENCHMARK_CAPTURE(BM_ResolveBatch, best, best_batch_kernel())->Arg(4096);
+
+}  // namespace
@@ -0,0 +1,40 @@
+#include "engine/core/rng.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+namespace {
+
+template<typename Engine>
+void BM_RNGUniform(benchmark::State& state) {
+    BasicRNG<Engine> rng(42);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(rng.uniform());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_RNGUniform, Pcg32);
+BENCHMARK_TEMPLATE(BM_RNGUniform, Xoshiro128Plus);
+
+void BM_RNGFillUniform(benchmark::State& state) {
+    RNG rng(42);
+    std::vector<float> out(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        rng.fill_uniform(out.data(), out.size());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RNGFillUniform)->Arg(4096);
+
+void BM_RNGAdvance(benchmark::State& state) {
+    Pcg32 engine(42, 1);
+    for (auto _ : state) {
+        engine.advance(1000003);
+        benchmark::DoNotOptimize(engine);
+    }
+}
+BENCHMARK(BM_RNGAdvance);
+
+}  // namespace
@@ -0,0 +1,68 @@
+#include "bench_common.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+namespace {
+
+// A league-plus-affiliates sized roster, written once as CSV and as a snapshot.
+constexpr std::size_t kBenchRosterSize = 30000;
+
+struct RosterFiles {
+    std::string csv = "bench_roster.csv";
+    std::string snapshot = "bench_roster.bin";
+
+    RosterFiles() {
+        std::ofstream out(csv, std::ios::trunc);
+        out << "name,age,bats,throws,contact,power,eye,speed,contact_potential,power_potential,"
+               "stuff,control,movement,stamina,range,hands,fastball_velocity,fastball_movement,"
+               "fastball_control,fastball_usage\n";
+        for (std::size_t i = 0; i < kBenchRosterSize; ++i) {
+            const float r = static_cast<float>(i % 997) / 997.f;
+            out << "Player " << i << ',' << 20 + i % 20 << ',' << (i % 3 ? 'R' : 'L') << ",R,"
+                << r << ',' << 1 - r << ',' << r << ",0.5," << r << ',' << r << ','
+                << r << ',' << 1 - r << ",0.5,0.6,0.5,0.5,";
+            if (i % 4 == 0) out << "0.9,0.4,0.6,1";
+            else out << ",,,";
+            out << '\n';
+        }
+        out.close();
+        load_roster_csv(csv).save_snapshot(snapshot);
+    }
+
+    ~RosterFiles() {
+        std::remove(csv.c_str());
+        std::remove(snapshot.c_str());
+    }
+};
+
+const RosterFiles& roster_files() {
+    static const RosterFiles files;
+    return files;
+}
+
+void BM_RosterLoadCsv(benchmark::State& state) {
+    const RosterFiles& files = roster_files();
+    for (auto _ : state) {
+        RosterStore roster = load_roster_csv(files.csv);
+        benchmark::DoNotOptimize(roster.contact());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(kBenchRosterSize));
+}
+BENCHMARK(BM_RosterLoadCsv)->Unit(benchmark::kMillisecond);
+
+// Open plus one pass over a hot column, which is all sim setup needs.
+void BM_RosterOpenSnapshot(benchmark::State& state) {
+    const RosterFiles& files = roster_files();
+    for (auto _ : state) {
+        RosterStore roster = RosterStore::open_snapshot(files.snapshot);
+        float sum = 0.f;
+        for (std::size_t i = 0; i < roster.size(); ++i) sum += roster.contact()[i];
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(kBenchRosterSize));
+}
+BENCHMARK(BM_RosterOpenSnapshot)->Unit(benchmark::kMicrosecond);
+
+}  // namespace
@@ -0,0 +1,41 @@
+# Turns the league outcome-rate exports from baseball_stats/pa_model.py into a
+# constexpr C++ header, so the engine never reads JSON at runtime and can't drift
+# from the Python side. Run in script mode:
+#
+#   cmake -DRATES_DIR=<baseball_stats> -DOUTPUT=<header> -P generate_outcome_rates.cmake
+
+# Must match OUTCOME_ORDER in baseball_stats/pa_data.py.
+set(OUTCOME_ORDER Walk HBP Single Double Triple HR Strikeout Out)
+
+function(emit_rates json_file var_name out_var)
+  file(READ "${json_file}" json)
+  set(values "")
+  foreach(outcome IN LISTS OUTCOME_ORDER)
+    string(JSON value ERROR_VARIABLE err GET "${json}" "${outcome}")
+    if(err)
+      message(FATAL_ERROR "${json_file}: missing outcome '${outcome}' (${err})")
+    endif()
+    string(APPEND values "    ${value}f,  // ${outcome}\n")
+  endforeach()
+  set(${out_var} "inline constexpr float ${var_name}[kNumOutcomeRates] = {\n${values}};\n" PARENT_SCOPE)
+endfunction()
+
+emit_rates("${RATES_DIR}/pa_outcome_rates.json" kLeagueOutcomeProbs league)
+emit_rates("${RATES_DIR}/pa_outcome_rates_same.json" kSameHandOutcomeProbs same)
+emit_rates("${RATES_DIR}/pa_outcome_rates_opposite.json" kOppositeHandOutcomeProbs opposite)
+
+set(content "// Generated by cmake/generate_outcome_rates.cmake from baseball_stats/pa_outcome_rates*.json.
+// Do not edit; rerun pa_model.py and rebuild instead.
+#pragma once
+
+#include <cstddef>
+
+// Entries follow OUTCOME_ORDER in baseball_stats/pa_data.py.
+constexpr std::size_t kNumOutcomeRates = 8;
+
+${league}
+${same}
+${opposite}")
+
+# Only touch the file when it changes so dependents don't rebuild needlessly.
+file(CONFIGURE OUTPUT "${OUTPUT}" CONTENT "${content}" @ONLY)
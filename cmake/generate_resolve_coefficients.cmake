@@ -0,0 +1,39 @@
+# Turns baseball_stats/resolve_coefficients.json (written by threeup3down_calibrate)
+# into a constexpr C++ header of the outcome_distribution() rating coefficients.
+# Run in script mode:
+#
+#   cmake -DCOEFFICIENTS=<resolve_coefficients.json> -DOUTPUT=<header> -P generate_resolve_coefficients.cmake
+
+# Must match ResolveCoefficientIndex in engine/model/resolve_coefficients.hpp.
+set(COEFFICIENT_ORDER
+  walk_scale walk_control
+  strikeout_scale strikeout_contact strikeout_stuff_base strikeout_stuff
+  homerun_scale homerun_movement
+  walk_min walk_max strikeout_min strikeout_max homerun_min homerun_max in_play_min in_play_max)
+
+file(READ "${COEFFICIENTS}" json)
+set(values "")
+list(LENGTH COEFFICIENT_ORDER count)
+foreach(name IN LISTS COEFFICIENT_ORDER)
+  string(JSON value ERROR_VARIABLE err GET "${json}" "${name}")
+  if(err)
+    message(FATAL_ERROR "${COEFFICIENTS}: missing coefficient '${name}' (${err})")
+  endif()
+  string(APPEND values "    ${value}f,  // ${name}\n")
+endforeach()
+
+set(content "// Generated by cmake/generate_resolve_coefficients.cmake from baseball_stats/resolve_coefficients.json.
+// Do not edit; rerun threeup3down_calibrate and rebuild instead.
+#pragma once
+
+#include <cstddef>
+
+// Entries follow ResolveCoefficientIndex in engine/model/resolve_coefficients.hpp.
+constexpr std::size_t kNumResolveCoefficients = ${count};
+
+inline constexpr float kResolveCoefficientValues[kNumResolveCoefficients] = {
+${values}};
+")
+
+# Only touch the file when it changes so dependents don't rebuild needlessly.
+file(CONFIGURE OUTPUT "${OUTPUT}" CONTENT "${content}" @ONLY)
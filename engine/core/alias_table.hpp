@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Walker/Vose alias table over N outcomes. One uniform picks a column (its high
+// bits) and flips that column's biased coin (its low bits), so a draw is one load
+// and one select no matter how many outcomes there are.
+template<std::size_t N>
+class AliasTable {
+    static_assert(N > 0 && N <= 256, "alias indices are stored as bytes");
+
+public:
+    AliasTable() = default;
+
+    // Vose's construction. probs need not be normalized; they must not all be zero.
+    explicit AliasTable(const float (&probs)[N]) {
+        double total = 0.0;
+        for (std::size_t i = 0; i < N; ++i) total += probs[i];
+
+        double scaled[N];
+        std::size_t small[N];
+        std::size_t large[N];
+        std::size_t num_small = 0;
+        std::size_t num_large = 0;
+        for (std::size_t i = 0; i < N; ++i) {
+            scaled[i] = probs[i] * N / total;
+            if (scaled[i] < 1.0) {
+                small[num_small++] = i;
+            } else {
+                large[num_large++] = i;
+            }
+        }
+        while (num_small > 0 && num_large > 0) {
+            const std::size_t s = small[--num_small];
+            const std::size_t l = large[num_large - 1];
+            keep_[s] = static_cast<float>(scaled[s]);
+            alias_[s] = static_cast<std::uint8_t>(l);
+            scaled[l] -= 1.0 - scaled[s];
+            if (scaled[l] < 1.0) {
+                --num_large;
+                small[num_small++] = l;
+            }
+        }
+        // Whatever is left is 1 up to rounding.
+        while (num_large > 0) {
+            const std::size_t l = large[--num_large];
+            keep_[l] = 1.0f;
+            alias_[l] = static_cast<std::uint8_t>(l);
+        }
+        while (num_small > 0) {
+            const std::size_t s = small[--num_small];
+            keep_[s] = 1.0f;
+            alias_[s] = static_cast<std::uint8_t>(s);
+        }
+    }
+
+    // u in [0, 1). For power-of-two N the column/coin split of u is exact.
+    std::size_t sample(float u) const {
+        const float scaled = u * static_cast<float>(N);
+        std::size_t column = static_cast<std::size_t>(scaled);
+        column = column < N ? column : N - 1;
+        const float coin = scaled - static_cast<float>(column);
+        // Select by mask rather than ?: so the compiler can't turn it into a branch;
+        // the coin is a fair random bit and would mispredict about half the time.
+        const std::size_t take_alias = 0 - static_cast<std::size_t>(coin >= keep_[column]);
+        return column ^ ((column ^ alias_[column]) & take_alias);
+    }
+
+    // Probability that sample() returns `outcome`, for checking a table.
+    double probability(std::size_t outcome) const {
+        double p = 0.0;
+        for (std::size_t i = 0; i < N; ++i) {
+            if (i == outcome) p += keep_[i];
+            if (alias_[i] == outcome) p += 1.0 - keep_[i];
+        }
+        return p / N;
+    }
+
+    // Raw columns, for copying the table somewhere sample() can't go (a device).
+    float keep(std::size_t column) const { return keep_[column]; }
+    std::uint8_t alias(std::size_t column) const { return alias_[column]; }
+
+private:
+    float keep_[N];
+    std::uint8_t alias_[N];
+};
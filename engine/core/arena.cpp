@@ -0,0 +1,59 @@
+#include "engine/core/arena.hpp"
+
+#include "engine/core/instrument.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace {
+
+constexpr std::size_t kBlockAlignment = alignof(std::max_align_t);
+
+}  // namespace
+
+Arena::Arena(std::size_t initial_bytes, std::pmr::memory_resource* upstream) : upstream_(upstream) {
+    blocks_.reserve(8);
+    add_block(std::max<std::size_t>(initial_bytes, 1));
+}
+
+Arena::~Arena() { release_blocks(); }
+
+void Arena::reset() {
+    // Grown past the first block: trade the chain for one block that holds it all.
+    if (blocks_.size() > 1) {
+        const std::size_t total = capacity_;
+        release_blocks();
+        add_block(total);
+    }
+    used_ = 0;
+    retired_bytes_ = 0;
+}
+
+void* Arena::do_allocate(std::size_t bytes, std::size_t alignment) {
+    THREEUP3DOWN_COUNT(ALLOCATIONS);
+    Block& block = blocks_.back();
+    const auto base = reinterpret_cast<std::uintptr_t>(block.data);
+    std::size_t offset = ((base + used_ + alignment - 1) & ~(alignment - 1)) - base;
+    if (offset + bytes > block.size) {
+        retired_bytes_ += used_;
+        add_block(std::max(bytes + alignment, capacity_));  // at least doubles the total
+        const auto fresh = reinterpret_cast<std::uintptr_t>(blocks_.back().data);
+        offset = ((fresh + alignment - 1) & ~(alignment - 1)) - fresh;
+    }
+    used_ = offset + bytes;
+    return blocks_.back().data + offset;
+}
+
+void Arena::add_block(std::size_t min_bytes) {
+    auto* data = static_cast<std::byte*>(upstream_->allocate(min_bytes, kBlockAlignment));
+    blocks_.push_back({data, min_bytes});
+    capacity_ += min_bytes;
+    used_ = 0;
+    ++upstream_allocations_;
+}
+
+void Arena::release_blocks() {
+    for (const Block& b : blocks_) upstream_->deallocate(b.data, b.size, kBlockAlignment);
+    blocks_.clear();
+    capacity_ = 0;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+// Bump allocator for scratch that lives for one unit of work (a game, a
+// replication). Allocation is a pointer bump, deallocate is a no-op, and reset()
+// rewinds everything at once. After the first reset it keeps a single block big
+// enough for the largest unit seen so far, so steady-state work never touches the
+// upstream heap. Plug into std::pmr containers; one per worker, not thread-safe
+// (and cache-line aligned, so an array of them doesn't false-share).
+class alignas(64) Arena : public std::pmr::memory_resource {
+public:
+    explicit Arena(std::size_t initial_bytes = 64 << 10,
+                   std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+    ~Arena() override;
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    // Invalidates everything allocated since the last reset.
+    void reset();
+
+    std::size_t bytes_allocated() const { return used_ + retired_bytes_; }  // since the last reset
+    std::size_t capacity() const { return capacity_; }
+    std::size_t upstream_allocations() const { return upstream_allocations_; }  // ever, for tests
+
+private:
+    struct Block {
+        std::byte* data;
+        std::size_t size;
+    };
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void*, std::size_t, std::size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    void add_block(std::size_t min_bytes);
+    void release_blocks();
+
+    std::pmr::memory_resource* upstream_;
+    std::vector<Block> blocks_;  // current block last
+    std::size_t used_ = 0;       // in the current block
+    std::size_t retired_bytes_ = 0;  // used in earlier blocks
+    std::size_t capacity_ = 0;
+    std::size_t upstream_allocations_ = 0;
+};
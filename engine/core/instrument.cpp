@@ -0,0 +1,227 @@
+#include "engine/core/instrument.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace instrument {
+
+struct TraceEvent {
+    const char* name;
+    std::uint64_t start_ns;
+    std::uint64_t duration_ns;
+    std::uint32_t tid;
+};
+
+struct ThreadState {
+    std::atomic<std::uint64_t> counters[kNumCounters] = {};
+    std::uint32_t tid = 0;
+    std::vector<TraceEvent> events;  // pushed by the owner, drained under the registry lock
+    std::size_t dropped = 0;
+};
+
+std::atomic<bool> tracing{false};
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Leaked so that threads exiting during static destruction can still retire.
+struct Registry {
+    std::mutex mutex;
+    std::vector<ThreadState*> live;
+    CounterTotals retired;                 // counters of threads that have exited
+    std::vector<TraceEvent> retired_events;
+    std::size_t retired_dropped = 0;
+    std::uint32_t next_tid = 1;
+    TraceConfig config;
+    Clock::time_point epoch = Clock::now();
+};
+
+Registry& registry() {
+    static Registry* r = new Registry;
+    return *r;
+}
+
+std::uint64_t now_ns() {
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - registry().epoch).count());
+}
+
+// Trace names are string literals from THREEUP3DOWN_SCOPE, but escape anyway.
+void write_json_string(std::ofstream& out, const char* s) {
+    out << '"';
+    for (; *s; ++s) {
+        if (*s == '"' || *s == '\\') {
+            out << '\\' << *s;
+        } else if (static_cast<unsigned char>(*s) < 0x20) {
+            char buf[8];
+            std::snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned>(*s));
+            out << buf;
+        } else {
+            out << *s;
+        }
+    }
+    out << '"';
+}
+
+}  // namespace
+
+const char* counter_name(Counter c) {
+    switch (c) {
+    case Counter::PLATE_APPEARANCES: return "plate_appearances";
+    case Counter::RNG_DRAWS: return "rng_draws";
+    case Counter::TABLE_LOOKUPS: return "table_lookups";
+    case Counter::ALLOCATIONS: return "allocations";
+    case Counter::CACHE_REBUILDS: return "cache_rebuilds";
+    }
+    return "unknown";
+}
+
+ThreadState& register_thread() {
+    Registry& r = registry();
+    ThreadState* s = new ThreadState;
+    std::lock_guard<std::mutex> lock(r.mutex);
+    s->tid = r.next_tid++;
+    r.live.push_back(s);
+    return *s;
+}
+
+ThreadSlot::ThreadSlot() {
+    state = &register_thread();
+    counters = state->counters;
+}
+
+ThreadSlot::~ThreadSlot() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (std::size_t i = 0; i < kNumCounters; ++i) r.retired.values[i] += state->counters[i].load(std::memory_order_relaxed);
+    r.retired_events.insert(r.retired_events.end(), state->events.begin(), state->events.end());
+    r.retired_dropped += state->dropped;
+    r.live.erase(std::find(r.live.begin(), r.live.end(), state));
+    delete state;
+}
+
+CounterTotals counter_totals() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    CounterTotals out = r.retired;
+    for (const ThreadState* s : r.live) {
+        for (std::size_t i = 0; i < kNumCounters; ++i) out.values[i] += s->counters[i].load(std::memory_order_relaxed);
+    }
+    return out;
+}
+
+// Zeroing another thread's counter races with its load+store, so a reset while
+// sims are running may lose a few counts; call it between runs.
+void reset_counters() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.retired = CounterTotals();
+    for (ThreadState* s : r.live) {
+        for (std::atomic<std::uint64_t>& c : s->counters) c.store(0, std::memory_order_relaxed);
+    }
+}
+
+void start_trace(const TraceConfig& config) {
+    if (config.sample_every == 0) throw std::invalid_argument("trace: sample_every must be at least 1");
+    Registry& r = registry();
+    {
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.config = config;
+    }
+    tracing.store(true, std::memory_order_release);
+}
+
+void stop_trace() {
+    tracing.store(false, std::memory_order_release);
+}
+
+// Like reset_counters(), these read the per-thread buffers, so call them once
+// the traced run is over.
+std::size_t recorded_events() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    std::size_t n = r.retired_events.size();
+    for (const ThreadState* s : r.live) n += s->events.size();
+    return n;
+}
+
+std::size_t dropped_events() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    std::size_t n = r.retired_dropped;
+    for (const ThreadState* s : r.live) n += s->dropped;
+    return n;
+}
+
+void write_chrome_trace(const std::string& path) {
+    const CounterTotals totals = counter_totals();
+    Registry& r = registry();
+    std::vector<TraceEvent> events;
+    std::uint64_t end_ns = 0;
+    {
+        std::lock_guard<std::mutex> lock(r.mutex);
+        events.swap(r.retired_events);
+        for (ThreadState* s : r.live) {
+            events.insert(events.end(), s->events.begin(), s->events.end());
+            s->events.clear();
+        }
+    }
+    std::sort(events.begin(), events.end(), [](const TraceEvent& a, const TraceEvent& b) {
+        return a.tid != b.tid ? a.tid < b.tid : a.start_ns < b.start_ns;
+    });
+
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) throw std::runtime_error("trace path " + path + ": cannot open for writing");
+    // Chrome trace timestamps are microseconds; keep the nanoseconds as fractions.
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first = true;
+    char buf[96];
+    for (const TraceEvent& e : events) {
+        out << (first ? "\n" : ",\n") << "{\"name\":";
+        first = false;
+        write_json_string(out, e.name);
+        std::snprintf(buf, sizeof(buf), ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+                      e.start_ns / 1000.0, e.duration_ns / 1000.0, e.tid);
+        out << buf;
+        end_ns = std::max(end_ns, e.start_ns + e.duration_ns);
+    }
+    std::snprintf(buf, sizeof(buf), "%.3f", end_ns / 1000.0);
+    out << (first ? "\n" : ",\n") << "{\"name\":\"counters\",\"ph\":\"C\",\"ts\":" << buf << ",\"pid\":1,\"args\":{";
+    for (std::size_t i = 0; i < kNumCounters; ++i) {
+        out << (i ? "," : "") << '"' << counter_name(static_cast<Counter>(i)) << "\":" << totals.values[i];
+    }
+    out << "}}\n]}\n";
+    if (!out) throw std::runtime_error("trace path " + path + ": write failed");
+}
+
+bool ScopedTimer::sampled(std::uint32_t& countdown) {
+    if (countdown != 0) {
+        --countdown;
+        return false;
+    }
+    countdown = static_cast<std::uint32_t>(registry().config.sample_every - 1);
+    return true;
+}
+
+void ScopedTimer::begin(const char* name) {
+    name_ = name;
+    start_ns_ = now_ns();
+}
+
+void ScopedTimer::end() {
+    const std::uint64_t stop = now_ns();
+    ThreadState& s = *thread_slot.state;
+    if (s.events.size() >= registry().config.max_events_per_thread) {
+        ++s.dropped;
+        return;
+    }
+    s.events.push_back({name_, start_ns_, stop - start_ns_, s.tid});
+}
+
+}  // namespace instrument
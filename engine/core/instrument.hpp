@@ -0,0 +1,125 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Hot-path instrumentation: per-thread event counters and scoped timers that
+// export a Chrome trace (chrome://tracing, ui.perfetto.dev).
+//
+// Compiled in only when the engine is configured with -DTHREEUP3DOWN_INSTRUMENT=ON.
+// Otherwise the THREEUP3DOWN_COUNT / THREEUP3DOWN_SCOPE macros expand to nothing,
+// so the sim loop is the same code with or without this header. The query
+// functions below exist in both builds, so tools can call them unconditionally;
+// they just report zeros when instrumentation is off.
+
+enum class Counter : std::size_t {
+    PLATE_APPEARANCES,  // PAs resolved
+    RNG_DRAWS,          // uniforms drawn
+    TABLE_LOOKUPS,      // matchup / pitch alias-table reads in the game loop
+    ALLOCATIONS,        // arena allocations
+    CACHE_REBUILDS,     // matchup tables built, checkpointed games replayed
+};
+
+constexpr std::size_t kNumCounters = 5;
+
+namespace instrument {
+
+#ifdef THREEUP3DOWN_INSTRUMENT
+constexpr bool kEnabled = true;
+#else
+constexpr bool kEnabled = false;
+#endif
+
+const char* counter_name(Counter c);
+
+struct CounterTotals {
+    std::uint64_t values[kNumCounters] = {};
+
+    std::uint64_t operator[](Counter c) const { return values[static_cast<std::size_t>(c)]; }
+};
+
+// Sum over every thread that has counted, including ones that have exited.
+CounterTotals counter_totals();
+void reset_counters();
+
+// Tracing records one in `sample_every` passes through each scope (per thread),
+// up to `max_events_per_thread`; the rest are dropped and counted in dropped_events().
+struct TraceConfig {
+    std::size_t sample_every = 1;
+    std::size_t max_events_per_thread = std::size_t(1) << 20;
+};
+
+void start_trace(const TraceConfig& config = TraceConfig());
+void stop_trace();
+std::size_t recorded_events();
+std::size_t dropped_events();
+
+// Writes every recorded scope as a complete ("X") event, one track per thread,
+// plus the counter totals; clears the recorded events. Call it once the traced
+// run is over, not while sim threads are still recording. Throws
+// std::runtime_error if the file can't be written.
+void write_chrome_trace(const std::string& path);
+
+// ---- hooks behind the macros; only called in instrumented builds ----
+
+struct ThreadState;
+ThreadState& register_thread();
+
+struct ThreadSlot {
+    ThreadState* state = nullptr;
+    std::atomic<std::uint64_t>* counters = nullptr;
+    ThreadSlot();
+    ~ThreadSlot();
+};
+
+inline thread_local ThreadSlot thread_slot;
+
+// Only the owning thread writes its counters, so a relaxed load+store (no locked add) is enough.
+inline void count(Counter c, std::uint64_t n = 1) {
+    std::atomic<std::uint64_t>& v = thread_slot.counters[static_cast<std::size_t>(c)];
+    v.store(v.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+extern std::atomic<bool> tracing;
+
+class ScopedTimer {
+public:
+    // `countdown` is the scope site's own per-thread sampling counter.
+    ScopedTimer(const char* name, std::uint32_t& countdown) {
+        if (tracing.load(std::memory_order_relaxed) && sampled(countdown)) begin(name);
+    }
+    ~ScopedTimer() {
+        if (name_) end();
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    static bool sampled(std::uint32_t& countdown);
+    void begin(const char* name);
+    void end();
+
+    const char* name_ = nullptr;
+    std::uint64_t start_ns_ = 0;
+};
+
+}  // namespace instrument
+
+#define THREEUP3DOWN_CONCAT_INNER(a, b) a##b
+#define THREEUP3DOWN_CONCAT(a, b) THREEUP3DOWN_CONCAT_INNER(a, b)
+
+#ifdef THREEUP3DOWN_INSTRUMENT
+#define THREEUP3DOWN_COUNT(counter) ::instrument::count(::Counter::counter)
+#define THREEUP3DOWN_COUNT_N(counter, n) ::instrument::count(::Counter::counter, (n))
+#define THREEUP3DOWN_SCOPE(name)                                                              \
+    static thread_local std::uint32_t THREEUP3DOWN_CONCAT(threeup3down_scope_site_, __LINE__) = 0; \
+    const ::instrument::ScopedTimer THREEUP3DOWN_CONCAT(threeup3down_scope_, __LINE__)(       \
+        name, THREEUP3DOWN_CONCAT(threeup3down_scope_site_, __LINE__))
+#else
+#define THREEUP3DOWN_COUNT(counter) ((void)0)
+#define THREEUP3DOWN_COUNT_N(counter, n) ((void)0)
+#define THREEUP3DOWN_SCOPE(name) ((void)0)
+#endif
@@ -0,0 +1,130 @@
+#include "engine/core/socket.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <thread>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+TcpListener::TcpListener(std::string name) : name_(std::move(name)) {}
+
+TcpListener::~TcpListener() {
+    if (fd_ >= 0) ::close(fd_);
+}
+
+std::uint16_t TcpListener::listen(std::uint16_t port, const std::string& address, int backlog) {
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = AI_PASSIVE;
+    addrinfo* found = nullptr;
+    if (::getaddrinfo(address.c_str(), std::to_string(port).c_str(), &hints, &found) != 0 || !found) {
+        throw std::runtime_error(name_ + " " + address + ": cannot resolve");
+    }
+    const int fd = ::socket(found->ai_family, found->ai_socktype, found->ai_protocol);
+    const int one = 1;
+    const bool ok = fd >= 0 && ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one)) == 0 &&
+                    ::bind(fd, found->ai_addr, found->ai_addrlen) == 0 && ::listen(fd, backlog) == 0;
+    ::freeaddrinfo(found);
+    if (!ok) {
+        const std::string what = std::strerror(errno);
+        if (fd >= 0) ::close(fd);
+        throw std::runtime_error(name_ + " " + address + ":" + std::to_string(port) + ": " + what);
+    }
+    sockaddr_storage bound{};
+    socklen_t len = sizeof(bound);
+    ::getsockname(fd, reinterpret_cast<sockaddr*>(&bound), &len);
+    if (fd_ >= 0) ::close(fd_);
+    fd_ = fd;
+    return ntohs(bound.ss_family == AF_INET6 ? reinterpret_cast<sockaddr_in6&>(bound).sin6_port
+                                             : reinterpret_cast<sockaddr_in&>(bound).sin_port);
+}
+
+void TcpListener::serve(const std::function<void(int)>& handle, std::size_t max_connections) {
+    if (fd_ < 0) throw std::runtime_error(name_ + ": serve() before listen()");
+    if (max_connections == 0) throw std::invalid_argument(name_ + ": max_connections must be positive");
+
+    // Slot s runs at most one connection at a time; a slot on the free list has
+    // no thread or a finished one, joined before the slot is reused.
+    std::vector<std::thread> slots(max_connections > 1 ? max_connections : 0);
+    std::vector<std::size_t> free_slots;
+    for (std::size_t s = slots.size(); s-- > 0;) free_slots.push_back(s);
+    auto join_all = [&] {
+        for (std::thread& t : slots) {
+            if (t.joinable()) t.join();
+        }
+    };
+
+    while (!stopping_) {
+        std::size_t slot = 0;
+        if (!slots.empty()) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            slot_free_.wait(lock, [&] { return stopping_ || !free_slots.empty(); });
+            if (stopping_) break;
+            slot = free_slots.back();
+            free_slots.pop_back();
+        }
+        const int fd = ::accept(fd_, nullptr, nullptr);
+        if (fd < 0) {
+            if (!slots.empty()) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                free_slots.push_back(slot);
+            }
+            if (stopping_) break;
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            const std::string what = std::strerror(errno);
+            join_all();
+            throw std::runtime_error(name_ + ": accept: " + what);
+        }
+        if (slots.empty()) {
+            handle(fd);
+            ::close(fd);
+            continue;
+        }
+        if (slots[slot].joinable()) slots[slot].join();
+        slots[slot] = std::thread([&, slot, fd] {
+            handle(fd);
+            ::close(fd);
+            std::lock_guard<std::mutex> lock(mutex_);
+            free_slots.push_back(slot);
+            slot_free_.notify_one();
+        });
+    }
+    join_all();
+}
+
+void TcpListener::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    slot_free_.notify_all();
+    // Wakes a blocked accept().
+    if (fd_ >= 0) ::shutdown(fd_, SHUT_RDWR);
+}
+
+bool send_all(int fd, const void* data, std::size_t n) {
+    const char* p = static_cast<const char*>(data);
+    while (n > 0) {
+        const ssize_t sent = ::send(fd, p, n, MSG_NOSIGNAL);
+        if (sent < 0 && errno == EINTR) continue;
+        if (sent <= 0) return false;
+        p += sent;
+        n -= static_cast<std::size_t>(sent);
+    }
+    return true;
+}
+
+void set_socket_timeouts(int fd, int timeout_ms) {
+    timeval tv{};
+    tv.tv_sec = timeout_ms / 1000;
+    tv.tv_usec = (timeout_ms % 1000) * 1000;
+    ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    ::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+
+// The listening side of the engine's TCP services (the shard worker and the
+// HTTP front): bind, the accept loop and a stop() that wakes it.
+//
+// serve() hands each accepted connection to handle(fd) and closes it
+// afterwards. With max_connections == 1 that happens on the calling thread,
+// one connection after another; otherwise each connection gets its own
+// thread, at most max_connections at once. When they are all busy, serve()
+// stops accepting (the kernel backlog holds new peers) until one finishes, and
+// finished threads are joined as their slots are reused, so a long-lived
+// listener holds at most max_connections threads. serve() returns once stop()
+// has been called and every connection it started has been answered.
+class TcpListener {
+public:
+    // `name` ("shard worker", "sim service") prefixes every error message.
+    explicit TcpListener(std::string name);
+    ~TcpListener();
+
+    TcpListener(const TcpListener&) = delete;
+    TcpListener& operator=(const TcpListener&) = delete;
+
+    // Binds and listens; port 0 picks a free one. Returns the bound port.
+    // Throws std::runtime_error if the socket can't be set up.
+    std::uint16_t listen(std::uint16_t port, const std::string& address, int backlog);
+
+    // Throws std::runtime_error before listen() or if accept() fails, and
+    // std::invalid_argument for max_connections == 0.
+    void serve(const std::function<void(int)>& handle, std::size_t max_connections = 1);
+
+    // Callable from any thread, before or during serve().
+    void stop();
+    bool stopping() const { return stopping_; }
+
+private:
+    const std::string name_;
+    int fd_ = -1;
+    std::atomic<bool> stopping_{false};
+    std::mutex mutex_;
+    std::condition_variable slot_free_;  // a connection finished, or stop()
+};
+
+// Writes all n bytes (no SIGPIPE); false if the peer went away or timed out.
+bool send_all(int fd, const void* data, std::size_t n);
+
+// SO_RCVTIMEO and SO_SNDTIMEO, so a silent peer can't hold a thread forever.
+void set_socket_timeouts(int fd, int timeout_ms);
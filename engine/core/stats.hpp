@@ -0,0 +1,143 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+// Streaming mean / variance (Welford), with Chan et al.'s pairwise combine so
+// per-thread accumulators can be merged in any tree shape. Merging is exact in
+// count/min/max; mean and variance agree across merge orders to rounding (a
+// fixed merge order, as ReplicationFold uses, makes them bit-identical).
+class RunningStats {
+public:
+    void add(double x) {
+        ++count_;
+        const double delta = x - mean_;
+        mean_ += delta / static_cast<double>(count_);
+        m2_ += delta * (x - mean_);
+        min_ = std::min(min_, x);
+        max_ = std::max(max_, x);
+    }
+
+    void merge(const RunningStats& other) {
+        if (other.count_ == 0) return;
+        if (count_ == 0) {
+            *this = other;
+            return;
+        }
+        const double n_a = static_cast<double>(count_);
+        const double n_b = static_cast<double>(other.count_);
+        const double n = n_a + n_b;
+        const double delta = other.mean_ - mean_;
+        mean_ += delta * (n_b / n);
+        m2_ += other.m2_ + delta * delta * (n_a * n_b / n);
+        count_ += other.count_;
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+    }
+
+    std::uint64_t count() const { return count_; }
+    double mean() const { return mean_; }
+    // Sample variance (n - 1); 0 with fewer than two values.
+    double variance() const { return count_ > 1 ? m2_ / static_cast<double>(count_ - 1) : 0.0; }
+    double stddev() const { return std::sqrt(variance()); }
+    double min() const { return min_; }
+    double max() const { return max_; }
+    // Sum of squared deviations from the mean; with count/mean/min/max the whole state.
+    double m2() const { return m2_; }
+
+    // Rebuilds an accumulator from its state (e.g. one sent between processes).
+    static RunningStats from_state(std::uint64_t count, double mean, double m2, double min, double max) {
+        RunningStats s;
+        s.count_ = count;
+        s.mean_ = mean;
+        s.m2_ = m2;
+        s.min_ = min;
+        s.max_ = max;
+        return s;
+    }
+
+private:
+    std::uint64_t count_ = 0;
+    double mean_ = 0.0;
+    double m2_ = 0.0;
+    double min_ = std::numeric_limits<double>::infinity();
+    double max_ = -std::numeric_limits<double>::infinity();
+};
+
+// Fixed-width bins over [lo, hi) plus underflow/overflow counts. Integer counts,
+// so merges are exact whatever order partial histograms arrive in.
+class Histogram {
+public:
+    Histogram() = default;
+
+    Histogram(double lo, double hi, std::size_t bins) : lo_(lo), hi_(hi), counts_(bins, 0) {
+        if (bins == 0 || !(hi > lo)) throw std::invalid_argument("histogram needs bins over a non-empty range");
+        scale_ = static_cast<double>(bins) / (hi - lo);
+    }
+
+    void add(double x) {
+        if (x < lo_) {
+            ++underflow_;
+        } else if (x >= hi_) {
+            ++overflow_;
+        } else {
+            // Rounding can land x just under hi_ one past the last bin.
+            const std::size_t bin = std::min(static_cast<std::size_t>((x - lo_) * scale_), counts_.size() - 1);
+            ++counts_[bin];
+        }
+    }
+
+    // Both histograms must share a binning.
+    void merge(const Histogram& other) {
+        if (other.counts_.size() != counts_.size() || other.lo_ != lo_ || other.hi_ != hi_) {
+            throw std::invalid_argument("merging histograms with different bins");
+        }
+        for (std::size_t b = 0; b < counts_.size(); ++b) counts_[b] += other.counts_[b];
+        underflow_ += other.underflow_;
+        overflow_ += other.overflow_;
+    }
+
+    std::size_t bins() const { return counts_.size(); }
+    double bin_lo(std::size_t bin) const { return lo_ + static_cast<double>(bin) / scale_; }
+    std::uint64_t operator[](std::size_t bin) const { return counts_[bin]; }
+    std::uint64_t underflow() const { return underflow_; }
+    std::uint64_t overflow() const { return overflow_; }
+
+    // Adds counts straight into a bin / the tails (e.g. ones sent between processes).
+    void add_to_bin(std::size_t bin, std::uint64_t n) { counts_.at(bin) += n; }
+    void add_underflow(std::uint64_t n) { underflow_ += n; }
+    void add_overflow(std::uint64_t n) { overflow_ += n; }
+
+    std::uint64_t total() const {
+        std::uint64_t n = underflow_ + overflow_;
+        for (std::uint64_t c : counts_) n += c;
+        return n;
+    }
+
+    // Lower edge of the bin holding the q-quantile (underflow reads as lo, overflow as hi).
+    double quantile(double q) const {
+        const std::uint64_t n = total();
+        if (n == 0) return lo_;
+        const double target = q * static_cast<double>(n);
+        double seen = static_cast<double>(underflow_);
+        if (seen > target) return lo_;
+        for (std::size_t b = 0; b < counts_.size(); ++b) {
+            seen += static_cast<double>(counts_[b]);
+            if (seen > target) return bin_lo(b);
+        }
+        return hi_;
+    }
+
+private:
+    double lo_ = 0.0;
+    double hi_ = 1.0;
+    double scale_ = 1.0;
+    std::vector<std::uint64_t> counts_;
+    std::uint64_t underflow_ = 0;
+    std::uint64_t overflow_ = 0;
+};
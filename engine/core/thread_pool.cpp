@@ -0,0 +1,117 @@
+#include "engine/core/thread_pool.hpp"
+
+#include <algorithm>
+
+namespace {
+
+std::uint64_t pack(std::uint32_t begin, std::uint32_t end) {
+    return (static_cast<std::uint64_t>(end) << 32) | begin;
+}
+
+std::uint32_t range_begin(std::uint64_t r) { return static_cast<std::uint32_t>(r); }
+std::uint32_t range_end(std::uint64_t r) { return static_cast<std::uint32_t>(r >> 32); }
+
+}  // namespace
+
+WorkStealingPool::WorkStealingPool(std::size_t threads)
+    : num_workers_(threads ? threads : std::max(1u, std::thread::hardware_concurrency())),
+      slots_(new Slot[num_workers_]) {
+    threads_.reserve(num_workers_ - 1);
+    for (std::size_t id = 1; id < num_workers_; ++id) {
+        threads_.emplace_back([this, id] { worker_loop(id); });
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    start_cv_.notify_all();
+    for (auto& t : threads_) t.join();
+}
+
+void WorkStealingPool::parallel_for(std::size_t n, const std::function<void(std::size_t, std::size_t)>& body) {
+    if (n == 0) return;
+    const std::size_t chunk = n / num_workers_;
+    const std::size_t extra = n % num_workers_;
+    std::size_t begin = 0;
+    for (std::size_t id = 0; id < num_workers_; ++id) {
+        const std::size_t end = begin + chunk + (id < extra ? 1 : 0);
+        slots_[id].range.store(pack(static_cast<std::uint32_t>(begin), static_cast<std::uint32_t>(end)), std::memory_order_relaxed);
+        begin = end;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        body_ = &body;
+        running_ = num_workers_ - 1;
+        ++generation_;
+    }
+    start_cv_.notify_all();
+
+    drain(0);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cv_.wait(lock, [this] { return running_ == 0; });
+    body_ = nullptr;
+}
+
+void WorkStealingPool::worker_loop(std::size_t id) {
+    std::uint64_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            start_cv_.wait(lock, [&] { return stop_ || generation_ != seen; });
+            if (stop_) return;
+            seen = generation_;
+        }
+        drain(id);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            --running_;
+        }
+        done_cv_.notify_one();
+    }
+}
+
+void WorkStealingPool::drain(std::size_t id) {
+    const auto& body = *body_;
+    std::size_t index;
+    while (pop(id, index) || steal(id, index)) {
+        body(id, index);
+    }
+}
+
+bool WorkStealingPool::pop(std::size_t id, std::size_t& index) {
+    auto& range = slots_[id].range;
+    std::uint64_t cur = range.load(std::memory_order_acquire);
+    for (;;) {
+        const std::uint32_t b = range_begin(cur);
+        const std::uint32_t e = range_end(cur);
+        if (b >= e) return false;
+        if (range.compare_exchange_weak(cur, pack(b + 1, e), std::memory_order_acq_rel)) {
+            index = b;
+            return true;
+        }
+    }
+}
+
+bool WorkStealingPool::steal(std::size_t id, std::size_t& index) {
+    for (std::size_t k = 1; k < num_workers_; ++k) {
+        auto& victim = slots_[(id + k) % num_workers_].range;
+        std::uint64_t cur = victim.load(std::memory_order_acquire);
+        for (;;) {
+            const std::uint32_t b = range_begin(cur);
+            const std::uint32_t e = range_end(cur);
+            if (b >= e) break;
+            const std::uint32_t mid = b + (e - b) / 2;
+            if (victim.compare_exchange_weak(cur, pack(b, mid), std::memory_order_acq_rel)) {
+                // Our own slot is empty, so only thieves look at it; publish the rest of the loot.
+                slots_[id].range.store(pack(mid + 1, e), std::memory_order_release);
+                index = mid;
+                return true;
+            }
+        }
+    }
+    return false;
+}
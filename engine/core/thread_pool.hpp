@@ -0,0 +1,54 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed-size pool that runs index ranges with work stealing. Each worker starts
+// with an equal slice of [0, n) and takes indices from its front; a worker that
+// runs dry steals the back half of another worker's remaining slice. The calling
+// thread takes part as worker 0, so a pool of size 1 runs everything inline.
+class WorkStealingPool {
+public:
+    // threads == 0 uses std::thread::hardware_concurrency().
+    explicit WorkStealingPool(std::size_t threads = 0);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    std::size_t size() const { return num_workers_; }
+
+    // Calls body(worker, index) once for every index in [0, n), worker in [0, size()).
+    // Blocks until all indices are done. n must fit in 32 bits.
+    void parallel_for(std::size_t n, const std::function<void(std::size_t, std::size_t)>& body);
+
+private:
+    // [begin, end) packed into one word so owner pops and thief splits are single CASes.
+    struct alignas(64) Slot {
+        std::atomic<std::uint64_t> range{0};
+    };
+
+    void worker_loop(std::size_t id);
+    void drain(std::size_t id);
+    bool pop(std::size_t id, std::size_t& index);
+    bool steal(std::size_t id, std::size_t& index);
+
+    std::size_t num_workers_;
+    std::unique_ptr<Slot[]> slots_;
+    std::vector<std::thread> threads_;
+
+    std::mutex mutex_;
+    std::condition_variable start_cv_;
+    std::condition_variable done_cv_;
+    const std::function<void(std::size_t, std::size_t)>* body_ = nullptr;
+    std::uint64_t generation_ = 0;
+    std::size_t running_ = 0;
+    bool stop_ = false;
+};
@@ -1,6 +0,0 @@
-#include "engine/model/player.hpp"
-
-// Placeholder translation unit so the project builds and clangd gets compile flags.
-// Feel free to remove once you have real .cpp files in the engine.
-void threeup3down_engine_placeholder() {}
-
@@ -0,0 +1,130 @@
+#include "engine/model/outcome_model.hpp"
+
+#include "engine/model/outcome_rates.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+
+constexpr char kMagic[8] = {'3', 'U', '3', 'D', 'X', 'G', 'B', '1'};
+constexpr std::uint32_t kVersion = 1;
+
+// Upper bounds that only catch corrupt headers before we size vectors from them.
+constexpr std::uint32_t kMaxFeatures = 1024;
+constexpr std::uint32_t kMaxNameLength = 256;
+
+class Reader {
+public:
+    explicit Reader(const std::string& path) : in_(path, std::ios::binary), path_(path) {
+        if (!in_) throw std::runtime_error("cannot open outcome model " + path);
+    }
+
+    template<typename T>
+    T read() {
+        T v;
+        bytes(&v, sizeof(v));
+        return v;
+    }
+
+    template<typename T>
+    void read_array(std::vector<T>& out, std::size_t n) {
+        out.resize(n);
+        bytes(out.data(), n * sizeof(T));
+    }
+
+    void bytes(void* dst, std::size_t n) {
+        in_.read(static_cast<char*>(dst), static_cast<std::streamsize>(n));
+        if (!in_) fail("truncated file");
+    }
+
+    [[noreturn]] void fail(const std::string& what) const {
+        throw std::runtime_error("outcome model " + path_ + ": " + what);
+    }
+
+private:
+    std::ifstream in_;
+    std::string path_;
+};
+
+}  // namespace
+
+OutcomeModel OutcomeModel::load(const std::string& path) {
+    Reader r(path);
+    char magic[sizeof(kMagic)];
+    r.bytes(magic, sizeof(magic));
+    if (std::memcmp(magic, kMagic, sizeof(kMagic)) != 0) r.fail("not an exported tree model");
+    if (r.read<std::uint32_t>() != kVersion) r.fail("unsupported version");
+
+    const auto num_features = r.read<std::uint32_t>();
+    const auto num_classes = r.read<std::uint32_t>();
+    const auto num_trees = r.read<std::uint32_t>();
+    const auto num_nodes = r.read<std::uint32_t>();
+    if (num_features == 0 || num_features > kMaxFeatures) r.fail("bad feature count");
+    if (num_classes == 0 || num_classes > kNumOutcomeRates) r.fail("bad class count");
+    if (num_trees % num_classes != 0) r.fail("tree count is not a multiple of the class count");
+
+    OutcomeModel model;
+    model.feature_names_.resize(num_features);
+    for (auto& name : model.feature_names_) {
+        const auto len = r.read<std::uint32_t>();
+        if (len > kMaxNameLength) r.fail("bad feature name");
+        name.resize(len);
+        r.bytes(&name[0], len);
+    }
+    r.read_array(model.class_outcome_, num_classes);
+    r.read_array(model.base_score_, num_classes);
+    std::vector<std::uint32_t> offsets;
+    r.read_array(offsets, num_trees + std::size_t{1});
+    r.read_array(model.nodes_, num_nodes);
+
+    for (std::uint32_t slot : model.class_outcome_) {
+        if (slot >= kNumOutcomeRates) r.fail("class maps to an unknown outcome");
+    }
+    if (offsets.back() != num_nodes) r.fail("tree offsets do not cover the node array");
+    model.roots_.assign(offsets.begin(), offsets.end() - 1);
+    for (std::size_t t = 0; t < num_trees; ++t) {
+        if (offsets[t] >= offsets[t + 1]) r.fail("empty tree");
+    }
+    for (const TreeNode& node : model.nodes_) {
+        if (node.feature >= 0 && (static_cast<std::uint32_t>(node.feature) >= num_features || node.child + 1 >= num_nodes)) {
+            r.fail("split node out of range");
+        }
+    }
+    return model;
+}
+
+float OutcomeModel::tree_margin(std::size_t tree, const float* features) const {
+    const TreeNode* nodes = nodes_.data();
+    std::uint32_t i = roots_[tree];
+    while (nodes[i].feature >= 0) {
+        const TreeNode& n = nodes[i];
+        const float x = features[n.feature];
+        const bool right = (x >= n.value) | (std::isnan(x) & !n.default_left);
+        i = n.child + static_cast<std::uint32_t>(right);
+    }
+    return nodes[i].value;
+}
+
+void OutcomeModel::predict_proba(const float* features, float* probs) const {
+    const std::size_t num_classes = class_outcome_.size();
+    float margin[kNumOutcomeRates];
+    std::copy(base_score_.begin(), base_score_.end(), margin);
+    for (std::size_t t = 0; t < roots_.size(); ++t) {
+        margin[t % num_classes] += tree_margin(t, features);
+    }
+
+    const float max_margin = *std::max_element(margin, margin + num_classes);
+    float total = 0.f;
+    for (std::size_t c = 0; c < num_classes; ++c) {
+        margin[c] = std::exp(margin[c] - max_margin);
+        total += margin[c];
+    }
+    std::fill(probs, probs + kNumOutcomeRates, 0.f);
+    for (std::size_t c = 0; c < num_classes; ++c) {
+        probs[class_outcome_[c]] = margin[c] / total;
+    }
+}
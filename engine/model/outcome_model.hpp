@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// One node of an exported gradient-boosted tree. Siblings are stored next to each
+// other (left at `child`, right at `child + 1`), so descending is an index bump
+// instead of a data-dependent branch. Leaves have feature == -1 and carry their
+// margin contribution in `value`; splits send x < value left, like XGBoost.
+struct TreeNode {
+    float value;
+    std::int32_t feature;
+    std::uint32_t child;
+    std::uint32_t default_left;  // direction for NaN inputs
+};
+
+static_assert(sizeof(TreeNode) == 16, "TreeNode is read straight from the export file");
+
+// Native evaluator for the XGBoost PA outcome classifier trained in
+// baseball_stats/pa_model.py and written by export_model_trees(). All trees of the
+// boosted ensemble live in one contiguous node array.
+class OutcomeModel {
+public:
+    // Throws std::runtime_error if the file is missing or malformed.
+    static OutcomeModel load(const std::string& path);
+
+    // Feature columns in training order (see build_features in pa_model.py).
+    const std::vector<std::string>& feature_names() const { return feature_names_; }
+    std::size_t num_features() const { return feature_names_.size(); }
+    std::size_t num_trees() const { return roots_.size(); }
+
+    // Softmax class probabilities for one row of num_features() values, written to
+    // `probs` in OUTCOME_ORDER (kNumOutcomeRates entries). Outcomes the model never
+    // saw in training get probability 0.
+    void predict_proba(const float* features, float* probs) const;
+
+private:
+    float tree_margin(std::size_t tree, const float* features) const;
+
+    std::vector<std::string> feature_names_;
+    std::vector<std::uint32_t> class_outcome_;  // model class -> OUTCOME_ORDER slot
+    std::vector<float> base_score_;             // initial margin per model class
+    std::vector<std::uint32_t> roots_;          // tree t belongs to class t % num classes
+    std::vector<TreeNode> nodes_;
+};
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "engine/generated/outcome_rates_data.hpp"
+#include "engine/model/player.hpp"
+
+#include <cstddef>
+
+// Indices into league outcome-rate tables, in baseball_stats/pa_data.py OUTCOME_ORDER.
+enum OutcomeRateIndex : std::size_t {
+    RATE_WALK,
+    RATE_HBP,
+    RATE_SINGLE,
+    RATE_DOUBLE,
+    RATE_TRIPLE,
+    RATE_HR,
+    RATE_STRIKEOUT,
+    RATE_OUT
+};
+
+struct OutcomeRates {
+    float prob[kNumOutcomeRates];
+    float cumulative[kNumOutcomeRates];  // normalized; cumulative[kNumOutcomeRates - 1] == 1
+};
+
+constexpr OutcomeRates make_outcome_rates(const float (&prob)[kNumOutcomeRates]) {
+    OutcomeRates rates{};
+    double total = 0.0;
+    for (std::size_t i = 0; i < kNumOutcomeRates; ++i) total += prob[i];
+    double running = 0.0;
+    for (std::size_t i = 0; i < kNumOutcomeRates; ++i) {
+        rates.prob[i] = prob[i];
+        running += prob[i];
+        rates.cumulative[i] = static_cast<float>(running / total);
+    }
+    rates.cumulative[kNumOutcomeRates - 1] = 1.0f;
+    return rates;
+}
+
+inline constexpr OutcomeRates kLeagueOutcomeRates = make_outcome_rates(kLeagueOutcomeProbs);
+
+// Indexed by platoon_same(): [0] = opposite hands, [1] = same hand, matching the
+// platoon_same feature in baseball_stats/pa_model.py.
+inline constexpr OutcomeRates kPlatoonOutcomeRates[2] = {
+    make_outcome_rates(kOppositeHandOutcomeProbs),
+    make_outcome_rates(kSameHandOutcomeProbs),
+};
+
+// Outcome a uniform draw in [0, 1) selects from a cumulative row (OutcomeRates::cumulative,
+// ProbabilityCube::row). Counts thresholds at or below u, so there is no early exit.
+inline OutcomeRateIndex sample_cumulative(const float* cumulative, float u) {
+    std::size_t idx = 0;
+    for (std::size_t i = 0; i + 1 < kNumOutcomeRates; ++i) {
+        idx += (u >= cumulative[i]);
+    }
+    return static_cast<OutcomeRateIndex>(idx);
+}
+
+// 1 if batter and pitcher share a hand, else 0. Switch hitters always take the
+// opposite side, so they never count as same-handed.
+constexpr int platoon_same(Handedness bats, Handedness throws) {
+    return static_cast<int>(bats == throws) & static_cast<int>(bats != Handedness::SWITCH);
+}
+
+// Platoon rate relative to the league rate for one outcome, e.g. how much more
+// often same-handed matchups strike out than average.
+constexpr float platoon_adjustment(int same, OutcomeRateIndex outcome) {
+    return kPlatoonOutcomeRates[same].prob[outcome] / kLeagueOutcomeRates.prob[outcome];
+}
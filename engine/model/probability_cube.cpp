@@ -0,0 +1,99 @@
+#include "engine/model/probability_cube.hpp"
+
+#include "engine/model/outcome_rates.hpp"
+
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr char kMagic[8] = {'3', 'U', '3', 'D', 'C', 'U', 'B', 'E'};
+constexpr std::uint32_t kVersion = 1;
+constexpr std::size_t kHeaderSize = 64;
+
+struct CubeHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t num_counts;
+    std::uint32_t num_platoon;
+    std::uint32_t num_innings;
+    std::uint32_t num_outs;
+    std::uint32_t num_outcomes;
+    std::uint32_t first_inning;
+};
+
+static_assert(sizeof(CubeHeader) <= kHeaderSize, "cube header must fit in its reserved block");
+static_assert(ProbabilityCube::kRowSize == kNumOutcomeRates, "one cumulative row per cell");
+
+[[noreturn]] void fail(const std::string& path, const std::string& what) {
+    throw std::runtime_error("probability cube " + path + ": " + what);
+}
+
+}  // namespace
+
+ProbabilityCube ProbabilityCube::open(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) fail(path, "cannot open");
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        fail(path, "cannot stat");
+    }
+    const auto size = static_cast<std::size_t>(st.st_size);
+    if (size < kHeaderSize) {
+        ::close(fd);
+        fail(path, "truncated header");
+    }
+    void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) fail(path, "mmap failed");
+
+    ProbabilityCube cube;
+    cube.mapping_ = mapping;
+    cube.mapping_size_ = size;
+
+    CubeHeader h;
+    std::memcpy(&h, mapping, sizeof(h));
+    if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0) fail(path, "not a probability cube");
+    if (h.version != kVersion) fail(path, "unsupported version");
+    if (h.num_counts != kNumCounts || h.num_platoon != kNumPlatoon || h.num_outs != kNumOuts ||
+        h.num_outcomes != kNumOutcomeRates || h.num_innings == 0) {
+        fail(path, "unexpected cube shape");
+    }
+    const std::size_t cells = kNumCounts * kNumPlatoon * h.num_innings * kNumOuts;
+    if (size != kHeaderSize + cells * kRowSize * sizeof(float)) fail(path, "size does not match header");
+
+    cube.rows_ = reinterpret_cast<const float*>(static_cast<const char*>(mapping) + kHeaderSize);
+    cube.first_inning_ = static_cast<int>(h.first_inning);
+    cube.num_innings_ = static_cast<int>(h.num_innings);
+    return cube;
+}
+
+ProbabilityCube::ProbabilityCube(ProbabilityCube&& other) noexcept
+    : mapping_(std::exchange(other.mapping_, nullptr)),
+      mapping_size_(std::exchange(other.mapping_size_, 0)),
+      rows_(std::exchange(other.rows_, nullptr)),
+      first_inning_(other.first_inning_),
+      num_innings_(other.num_innings_) {}
+
+ProbabilityCube& ProbabilityCube::operator=(ProbabilityCube&& other) noexcept {
+    if (this != &other) {
+        if (mapping_) ::munmap(mapping_, mapping_size_);
+        mapping_ = std::exchange(other.mapping_, nullptr);
+        mapping_size_ = std::exchange(other.mapping_size_, 0);
+        rows_ = std::exchange(other.rows_, nullptr);
+        first_inning_ = other.first_inning_;
+        num_innings_ = other.num_innings_;
+    }
+    return *this;
+}
+
+ProbabilityCube::~ProbabilityCube() {
+    if (mapping_) ::munmap(mapping_, mapping_size_);
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Context-conditioned outcome distributions precomputed from the ML model by
+// baseball_stats/export_prob_cube.py and mapped read-only straight from disk.
+// Axes: count_id (balls*4 + strikes) x platoon_same x inning x outs; every cell is
+// a cumulative row of kNumOutcomeRates floats in OUTCOME_ORDER. Games draw from it
+// through CubeOutcomeTable (engine/sim/cube_outcome_table.hpp).
+class ProbabilityCube {
+public:
+    static constexpr std::size_t kNumCounts = 16;
+    static constexpr std::size_t kNumPlatoon = 2;
+    static constexpr std::size_t kNumOuts = 3;
+
+    // Maps the file with one mmap. Throws std::runtime_error if it is missing or malformed.
+    static ProbabilityCube open(const std::string& path);
+
+    ProbabilityCube(ProbabilityCube&& other) noexcept;
+    ProbabilityCube& operator=(ProbabilityCube&& other) noexcept;
+    ProbabilityCube(const ProbabilityCube&) = delete;
+    ProbabilityCube& operator=(const ProbabilityCube&) = delete;
+    ~ProbabilityCube();
+
+    // Innings past the last tabulated one (extras) reuse its rows.
+    std::size_t cell(int count_id, int same_hand, int inning, int outs) const {
+        int i = inning - first_inning_;
+        i = i < 0 ? 0 : (i >= num_innings_ ? num_innings_ - 1 : i);
+        return ((static_cast<std::size_t>(count_id) * kNumPlatoon + same_hand) * num_innings_ + i) * kNumOuts + outs;
+    }
+
+    const float* row(int count_id, int same_hand, int inning, int outs) const {
+        return cell_row(cell(count_id, same_hand, inning, outs));
+    }
+    const float* cell_row(std::size_t cell) const { return rows_ + cell * kRowSize; }
+
+    int first_inning() const { return first_inning_; }
+    int num_innings() const { return num_innings_; }
+    std::size_t num_cells() const { return kNumCounts * kNumPlatoon * static_cast<std::size_t>(num_innings_) * kNumOuts; }
+
+    static constexpr std::size_t kRowSize = 8;
+
+private:
+    ProbabilityCube() = default;
+
+    void* mapping_ = nullptr;
+    std::size_t mapping_size_ = 0;
+    const float* rows_ = nullptr;
+    int first_inning_ = 1;
+    int num_innings_ = 0;
+};
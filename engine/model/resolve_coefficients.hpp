@@ -0,0 +1,56 @@
+#pragma once
+
+#include "engine/generated/resolve_coefficients_data.hpp"
+
+#include <cstddef>
+
+// Indices into ResolveCoefficients, in cmake/generate_resolve_coefficients.cmake
+// COEFFICIENT_ORDER. See outcome_distribution() for where each one enters.
+enum ResolveCoefficientIndex : std::size_t {
+    COEF_WALK_SCALE,           // walk = scale * eye * (1 - control * walk_control)
+    COEF_WALK_CONTROL,
+    COEF_STRIKEOUT_SCALE,      // K = scale * (1 - contact * k_contact) * (base + stuff * k_stuff)
+    COEF_STRIKEOUT_CONTACT,
+    COEF_STRIKEOUT_STUFF_BASE,
+    COEF_STRIKEOUT_STUFF,
+    COEF_HOMERUN_SCALE,        // HR = scale * power * (1 - movement * hr_movement)
+    COEF_HOMERUN_MOVEMENT,
+    COEF_WALK_MIN,             // clamp bounds, applied after the platoon split
+    COEF_WALK_MAX,
+    COEF_STRIKEOUT_MIN,
+    COEF_STRIKEOUT_MAX,
+    COEF_HOMERUN_MIN,
+    COEF_HOMERUN_MAX,
+    COEF_IN_PLAY_MIN,
+    COEF_IN_PLAY_MAX
+};
+
+static_assert(COEF_IN_PLAY_MAX + 1 == kNumResolveCoefficients, "indices mirror COEFFICIENT_ORDER");
+
+// The rating -> walk / strikeout / home-run coefficients of outcome_distribution().
+// A plain array so the calibration tool can treat them as one parameter vector.
+struct ResolveCoefficients {
+    float value[kNumResolveCoefficients];
+
+    constexpr float operator[](std::size_t i) const { return value[i]; }
+    constexpr float& operator[](std::size_t i) { return value[i]; }
+};
+
+constexpr ResolveCoefficients make_resolve_coefficients(const float (&values)[kNumResolveCoefficients]) {
+    ResolveCoefficients c{};
+    for (std::size_t i = 0; i < kNumResolveCoefficients; ++i) c.value[i] = values[i];
+    return c;
+}
+
+// Baked in from baseball_stats/resolve_coefficients.json; what the sim uses
+// unless a caller passes its own.
+inline constexpr ResolveCoefficients kResolveCoefficients = make_resolve_coefficients(kResolveCoefficientValues);
+
+// Names as in resolve_coefficients.json, by index.
+inline constexpr const char* kResolveCoefficientNames[kNumResolveCoefficients] = {
+    "walk_scale", "walk_control",
+    "strikeout_scale", "strikeout_contact", "strikeout_stuff_base", "strikeout_stuff",
+    "homerun_scale", "homerun_movement",
+    "walk_min", "walk_max", "strikeout_min", "strikeout_max",
+    "homerun_min", "homerun_max", "in_play_min", "in_play_max",
+};
@@ -0,0 +1,286 @@
+#include "engine/model/roster_store.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+// Column names (header row, any order):
+//   name, age, is_pitcher, is_two_way_player, bats, throws (L / R / S)
+//   batter:  contact power eye speed ground_ball_tendency fly_ball_tendency
+//   pitcher: stuff control movement stamina
+//   defense: range hands infield_arm outfield_arm double_play
+//   catcher: framing blocking pop_time game_call
+//   each rating also as <rating>_potential (defaults to the current value)
+//   pitch mix: <type>_velocity _movement _control _usage for fastball, slider,
+//   curveball, changeup, cutter, sinker, splitter, knuckleball; a pitch is in the
+//   mix when its usage cell is filled in.
+// Fields may be double-quoted ("Smith, Jr."), with "" for a literal quote.
+
+namespace {
+
+[[noreturn]] void fail(const std::string& path, std::size_t line, const std::string& what) {
+    throw std::runtime_error("roster csv " + path + ":" + std::to_string(line) + ": " + what);
+}
+
+// Splits one record into `fields`: views into `line`, or into `unquoted` for
+// fields that needed unescaping (reserved up front so those views stay put).
+void split_fields(std::string_view line, std::vector<std::string_view>& fields, std::vector<std::string>& unquoted) {
+    fields.clear();
+    unquoted.clear();
+    unquoted.reserve(static_cast<std::size_t>(std::count(line.begin(), line.end(), '"')) / 2 + 1);
+    std::size_t i = 0;
+    while (true) {
+        if (i < line.size() && line[i] == '"') {
+            std::string& value = unquoted.emplace_back();
+            ++i;
+            while (i < line.size()) {
+                if (line[i] == '"') {
+                    if (i + 1 < line.size() && line[i + 1] == '"') {
+                        value += '"';
+                        i += 2;
+                        continue;
+                    }
+                    ++i;
+                    break;
+                }
+                value += line[i++];
+            }
+            fields.push_back(value);
+            while (i < line.size() && line[i] != ',') ++i;
+        } else {
+            const std::size_t end = std::min(line.find(',', i), line.size());
+            fields.push_back(line.substr(i, end - i));
+            i = end;
+        }
+        if (i >= line.size()) break;
+        ++i;  // the comma
+    }
+}
+
+std::string_view trim(std::string_view s) {
+    while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) s.remove_prefix(1);
+    while (!s.empty() && (s.back() == ' ' || s.back() == '\t' || s.back() == '\r')) s.remove_suffix(1);
+    return s;
+}
+
+template <typename Rating>
+struct RatingField {
+    const char* name;
+    float Rating::*member;
+    bool required;
+};
+
+constexpr RatingField<BatterRatings> kBatterFields[] = {
+    {"contact", &BatterRatings::contact, true},
+    {"power", &BatterRatings::power, true},
+    {"eye", &BatterRatings::eye, true},
+    {"speed", &BatterRatings::speed, true},
+    {"ground_ball_tendency", &BatterRatings::ground_ball_tendency, false},
+    {"fly_ball_tendency", &BatterRatings::fly_ball_tendency, false},
+};
+
+constexpr RatingField<PitcherRatings> kPitcherFields[] = {
+    {"stuff", &PitcherRatings::stuff, true},
+    {"control", &PitcherRatings::control, true},
+    {"movement", &PitcherRatings::movement, true},
+    {"stamina", &PitcherRatings::stamina, true},
+};
+
+constexpr RatingField<DefenseRatings> kDefenseFields[] = {
+    {"range", &DefenseRatings::range, false},
+    {"hands", &DefenseRatings::hands, false},
+    {"infield_arm", &DefenseRatings::infield_arm, false},
+    {"outfield_arm", &DefenseRatings::outfield_arm, false},
+    {"double_play", &DefenseRatings::double_play, false},
+};
+
+constexpr RatingField<CatcherRatings> kCatcherFields[] = {
+    {"framing", &CatcherRatings::framing, false},
+    {"blocking", &CatcherRatings::blocking, false},
+    {"pop_time", &CatcherRatings::pop_time, false},
+    {"game_call", &CatcherRatings::game_call, false},
+};
+
+struct PitchField {
+    const char* name;
+    std::optional<Pitch> PitchTypeRatings::*member;
+};
+
+constexpr PitchField kPitchFields[] = {
+    {"fastball", &PitchTypeRatings::fastball}, {"slider", &PitchTypeRatings::slider},
+    {"curveball", &PitchTypeRatings::curveball}, {"changeup", &PitchTypeRatings::changeup},
+    {"cutter", &PitchTypeRatings::cutter}, {"sinker", &PitchTypeRatings::sinker},
+    {"splitter", &PitchTypeRatings::splitter}, {"knuckleball", &PitchTypeRatings::knuckleball},
+};
+
+constexpr int kAbsent = -1;
+
+// Column indices are resolved from the header once; rows are then parsed by index.
+class RosterCsvParser {
+public:
+    RosterCsvParser(const std::string& path, std::string_view header) : path_(path) {
+        split_fields(header, fields_, unquoted_);
+        for (std::string_view f : fields_) columns_.emplace_back(trim(f));
+        name_ = column("name", true);
+        age_ = column("age", false);
+        is_pitcher_ = column("is_pitcher", false);
+        is_two_way_ = column("is_two_way_player", false);
+        bats_ = column("bats", true);
+        throws_ = column("throws", true);
+        resolve(kBatterFields, batter_);
+        resolve(kPitcherFields, pitcher_);
+        resolve(kDefenseFields, defense_);
+        resolve(kCatcherFields, catcher_);
+        static const char* const kPitchParts[4] = {"_velocity", "_movement", "_control", "_usage"};
+        for (std::size_t t = 0; t < std::size(kPitchFields); ++t) {
+            for (std::size_t k = 0; k < 4; ++k) {
+                pitches_[t][k] = column(std::string(kPitchFields[t].name) + kPitchParts[k], false);
+            }
+        }
+    }
+
+    Player parse(std::string_view line, std::size_t line_number) {
+        line_ = line_number;
+        split_fields(line, fields_, unquoted_);
+        if (fields_.size() != columns_.size()) {
+            fail(path_, line_, "expected " + std::to_string(columns_.size()) + " fields, got " + std::to_string(fields_.size()));
+        }
+        Player p{};
+        p.name = std::string(required(name_));
+        p.age = integer(age_);
+        p.is_pitcher = integer(is_pitcher_) != 0;
+        p.is_two_way_player = integer(is_two_way_) != 0;
+        p.bats = handedness(bats_);
+        p.throws = handedness(throws_);
+        ratings(kBatterFields, batter_, p.batterRatings);
+        ratings(kPitcherFields, pitcher_, p.pitcherRatings);
+        ratings(kDefenseFields, defense_, p.defenseRatings);
+        ratings(kCatcherFields, catcher_, p.catcherRatings);
+        PitchTypeRatings mix;
+        bool any_pitch = false;
+        for (std::size_t t = 0; t < std::size(kPitchFields); ++t) {
+            const int* c = pitches_[t];
+            if (cell(c[3]).empty()) continue;
+            mix.*kPitchFields[t].member = Pitch{number(c[0]), number(c[1]), number(c[2]), number(c[3])};
+            any_pitch = true;
+        }
+        if (any_pitch) p.pitchTypeRatings = mix;
+        return p;
+    }
+
+private:
+    // [field][0 = current, 1 = potential]
+    template <std::size_t N>
+    using RatingColumns = int[N][2];
+
+    int column(const std::string& name, bool needed) {
+        for (std::size_t c = 0; c < columns_.size(); ++c) {
+            if (columns_[c] == name) return static_cast<int>(c);
+        }
+        if (needed) fail(path_, 1, "missing column " + name);
+        return kAbsent;
+    }
+
+    template <typename Rating, std::size_t N>
+    void resolve(const RatingField<Rating> (&fields)[N], RatingColumns<N>& out) {
+        for (std::size_t f = 0; f < N; ++f) {
+            out[f][0] = column(fields[f].name, fields[f].required);
+            out[f][1] = column(std::string(fields[f].name) + "_potential", false);
+        }
+    }
+
+    std::string_view cell(int c) const { return c == kAbsent ? std::string_view() : trim(fields_[c]); }
+
+    std::string_view required(int c) const {
+        const std::string_view v = cell(c);
+        if (v.empty()) fail(path_, line_, c == kAbsent ? std::string("a pitch needs all four columns") : "empty " + columns_[c]);
+        return v;
+    }
+
+    float number(int c) const {
+        const std::string_view v = required(c);
+        float x = 0.f;
+        const auto [end, ec] = std::from_chars(v.data(), v.data() + v.size(), x);
+        if (ec != std::errc() || end != v.data() + v.size()) fail(path_, line_, "bad number in " + columns_[c]);
+        return x;
+    }
+
+    // Empty or absent reads as 0; true/false are accepted for the flags.
+    int integer(int c) const {
+        const std::string_view v = cell(c);
+        if (v.empty() || v == "false") return 0;
+        if (v == "true") return 1;
+        int x = 0;
+        const auto [end, ec] = std::from_chars(v.data(), v.data() + v.size(), x);
+        if (ec != std::errc() || end != v.data() + v.size()) fail(path_, line_, "bad integer in " + columns_[c]);
+        return x;
+    }
+
+    Handedness handedness(int c) const {
+        const std::string_view v = required(c);
+        if (v == "L") return Handedness::LEFT;
+        if (v == "R") return Handedness::RIGHT;
+        if (v == "S") return Handedness::SWITCH;
+        fail(path_, line_, columns_[c] + " must be L, R or S");
+    }
+
+    template <typename Rating, std::size_t N>
+    void ratings(const RatingField<Rating> (&fields)[N], const RatingColumns<N>& columns, Ratings<Rating>& out) const {
+        for (std::size_t f = 0; f < N; ++f) {
+            const float current = cell(columns[f][0]).empty() && !fields[f].required ? 0.f : number(columns[f][0]);
+            out.current.*fields[f].member = current;
+            out.potential.*fields[f].member = cell(columns[f][1]).empty() ? current : number(columns[f][1]);
+        }
+    }
+
+    const std::string& path_;
+    std::vector<std::string> columns_;
+    std::vector<std::string_view> fields_;
+    std::vector<std::string> unquoted_;
+    std::size_t line_ = 1;
+
+    int name_, age_, is_pitcher_, is_two_way_, bats_, throws_;
+    RatingColumns<std::size(kBatterFields)> batter_;
+    RatingColumns<std::size(kPitcherFields)> pitcher_;
+    RatingColumns<std::size(kDefenseFields)> defense_;
+    RatingColumns<std::size(kCatcherFields)> catcher_;
+    int pitches_[std::size(kPitchFields)][4];
+};
+
+}  // namespace
+
+RosterStore load_roster_csv(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) throw std::runtime_error("roster csv " + path + ": cannot open");
+    std::ostringstream contents;
+    contents << in.rdbuf();
+    const std::string text = contents.str();
+
+    std::string_view rest(text);
+    auto next_line = [&rest](std::string_view& line) {
+        if (rest.empty()) return false;
+        const std::size_t end = std::min(rest.find('\n'), rest.size());
+        line = rest.substr(0, end);
+        rest.remove_prefix(std::min(end + 1, rest.size()));
+        return true;
+    };
+
+    std::string_view line;
+    if (!next_line(line)) throw std::runtime_error("roster csv " + path + ": empty file");
+    RosterCsvParser parser(path, line);
+
+    RosterStore roster;
+    roster.reserve(static_cast<std::size_t>(std::count(text.begin(), text.end(), '\n')));
+    std::size_t line_number = 1;
+    while (next_line(line)) {
+        ++line_number;
+        if (trim(line).empty()) continue;
+        roster.add(parser.parse(line, line_number));
+    }
+    return roster;
+}
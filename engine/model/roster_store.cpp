@@ -0,0 +1,354 @@
+#include "engine/model/roster_store.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr char kMagic[8] = {'3', 'U', '3', 'D', 'R', 'O', 'S', 'T'};
+constexpr std::uint32_t kVersion = 1;
+constexpr std::size_t kHeaderSize = 64;
+constexpr std::size_t kAlignment = 64;  // every column starts on a cache line
+constexpr std::size_t kNumFloatColumns = 8;
+constexpr std::size_t kNumPitchTypes = 8;
+
+struct SnapshotHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t num_players;
+    std::uint32_t record_size;
+    std::uint32_t names_size;
+};
+
+static_assert(sizeof(SnapshotHeader) <= kHeaderSize, "snapshot header must fit in its reserved block");
+
+// Cold data for one player, fixed width so the record array is read in place.
+// Ratings blocks are stored [current, potential]; the name lives in the string
+// blob at the end of the file.
+struct PlayerRecord {
+    std::uint32_t name_offset;
+    std::uint32_t name_length;
+    std::int32_t age;
+    std::uint8_t is_pitcher;
+    std::uint8_t is_two_way_player;
+    std::uint8_t bats;
+    std::uint8_t throws;
+    BatterRatings batter[2];
+    PitcherRatings pitcher[2];
+    DefenseRatings defense[2];
+    CatcherRatings catcher[2];
+    std::uint32_t pitch_mask;  // bit i: pitch type i present; bit 8: player has a pitch mix at all
+    Pitch pitches[kNumPitchTypes];
+};
+
+static_assert(std::is_trivially_copyable<PlayerRecord>::value, "records are written as raw bytes");
+static_assert(sizeof(PlayerRecord) == 300, "record layout is part of the snapshot format");
+
+constexpr std::uint32_t kHasPitchMix = 1u << kNumPitchTypes;
+
+// PitchTypeRatings members in PitchType order.
+std::optional<Pitch> PitchTypeRatings::* const kPitchMembers[kNumPitchTypes] = {
+    &PitchTypeRatings::fastball, &PitchTypeRatings::slider, &PitchTypeRatings::curveball,
+    &PitchTypeRatings::changeup, &PitchTypeRatings::cutter, &PitchTypeRatings::sinker,
+    &PitchTypeRatings::splitter, &PitchTypeRatings::knuckleball,
+};
+
+std::size_t align_up(std::size_t n) { return (n + kAlignment - 1) / kAlignment * kAlignment; }
+
+// Byte offsets of each section; a pure function of the counts, so the header needn't store them.
+struct SnapshotLayout {
+    std::size_t floats[kNumFloatColumns];
+    std::size_t bats;
+    std::size_t throws;
+    std::size_t records;
+    std::size_t names;
+    std::size_t total;
+
+    SnapshotLayout(std::size_t n, std::size_t names_size) {
+        std::size_t offset = kHeaderSize;
+        for (std::size_t& f : floats) {
+            f = offset;
+            offset += align_up(n * sizeof(float));
+        }
+        bats = offset;
+        offset += align_up(n);
+        throws = offset;
+        offset += align_up(n);
+        records = offset;
+        offset += align_up(n * sizeof(PlayerRecord));
+        names = offset;
+        total = offset + names_size;
+    }
+};
+
+[[noreturn]] void fail(const std::string& path, const std::string& what) {
+    throw std::runtime_error("roster snapshot " + path + ": " + what);
+}
+
+PlayerRecord make_record(const Player& p, std::uint32_t name_offset) {
+    PlayerRecord r{};
+    r.name_offset = name_offset;
+    r.name_length = static_cast<std::uint32_t>(p.name.size());
+    r.age = p.age;
+    r.is_pitcher = p.is_pitcher;
+    r.is_two_way_player = p.is_two_way_player;
+    r.bats = static_cast<std::uint8_t>(p.bats);
+    r.throws = static_cast<std::uint8_t>(p.throws);
+    r.batter[0] = p.batterRatings.current;
+    r.batter[1] = p.batterRatings.potential;
+    r.pitcher[0] = p.pitcherRatings.current;
+    r.pitcher[1] = p.pitcherRatings.potential;
+    r.defense[0] = p.defenseRatings.current;
+    r.defense[1] = p.defenseRatings.potential;
+    r.catcher[0] = p.catcherRatings.current;
+    r.catcher[1] = p.catcherRatings.potential;
+    if (p.pitchTypeRatings) {
+        r.pitch_mask = kHasPitchMix;
+        for (std::size_t t = 0; t < kNumPitchTypes; ++t) {
+            if (const auto& pitch = (*p.pitchTypeRatings).*kPitchMembers[t]) {
+                r.pitch_mask |= 1u << t;
+                r.pitches[t] = *pitch;
+            }
+        }
+    }
+    return r;
+}
+
+Player decode_record(const PlayerRecord& r, const char* names, std::size_t names_size) {
+    if (static_cast<std::size_t>(r.name_offset) + r.name_length > names_size) {
+        throw std::runtime_error("roster snapshot: player name out of range");
+    }
+    Player p{
+        std::string(names + r.name_offset, r.name_length), r.age, r.is_pitcher != 0, r.is_two_way_player != 0,
+        static_cast<Handedness>(r.bats), static_cast<Handedness>(r.throws),
+        {r.batter[0], r.batter[1]},
+        {r.pitcher[0], r.pitcher[1]},
+        {r.defense[0], r.defense[1]},
+        {r.catcher[0], r.catcher[1]},
+        std::nullopt
+    };
+    if (r.pitch_mask & kHasPitchMix) {
+        PitchTypeRatings mix;
+        for (std::size_t t = 0; t < kNumPitchTypes; ++t) {
+            if (r.pitch_mask & (1u << t)) mix.*kPitchMembers[t] = r.pitches[t];
+        }
+        p.pitchTypeRatings = mix;
+    }
+    return p;
+}
+
+}  // namespace
+
+// A mapped snapshot file. Columns and records are read where they lie; Players
+// are only built if someone asks for cold data.
+struct RosterStore::Snapshot {
+    void* mapping = nullptr;
+    std::size_t mapping_size = 0;
+    std::size_t num_players = 0;
+    const PlayerRecord* records = nullptr;
+    const char* names = nullptr;
+    std::size_t names_size = 0;
+
+    mutable std::once_flag decode_once;
+    mutable std::vector<Player> players;
+
+    Snapshot() = default;
+    Snapshot(const Snapshot&) = delete;
+    Snapshot& operator=(const Snapshot&) = delete;
+    ~Snapshot() {
+        if (mapping) ::munmap(mapping, mapping_size);
+    }
+
+    const std::vector<Player>& decoded() const {
+        std::call_once(decode_once, [this] {
+            players.reserve(num_players);
+            for (std::size_t i = 0; i < num_players; ++i) players.push_back(decode_record(records[i], names, names_size));
+        });
+        return players;
+    }
+};
+
+RosterStore::RosterStore(const RosterStore& other)
+    : size_(other.size_),
+      columns_(other.columns_),
+      contact_(other.contact_),
+      power_(other.power_),
+      eye_(other.eye_),
+      speed_(other.speed_),
+      stuff_(other.stuff_),
+      control_(other.control_),
+      movement_(other.movement_),
+      stamina_(other.stamina_),
+      bats_(other.bats_),
+      throws_(other.throws_),
+      players_(other.players_),
+      snapshot_(other.snapshot_) {
+    if (!snapshot_) point_at_owned();
+}
+
+RosterStore& RosterStore::operator=(const RosterStore& other) {
+    if (this != &other) *this = RosterStore(other);
+    return *this;
+}
+
+PlayerId RosterStore::add(const Player& player) {
+    if (snapshot_) copy_into_owned();
+    const auto id = static_cast<PlayerId>(players_.size());
+    const auto& bat = player.batterRatings.current;
+    const auto& pit = player.pitcherRatings.current;
+    contact_.push_back(bat.contact);
+    power_.push_back(bat.power);
+    eye_.push_back(bat.eye);
+    speed_.push_back(bat.speed);
+    stuff_.push_back(pit.stuff);
+    control_.push_back(pit.control);
+    movement_.push_back(pit.movement);
+    stamina_.push_back(pit.stamina);
+    bats_.push_back(static_cast<std::uint8_t>(player.bats));
+    throws_.push_back(static_cast<std::uint8_t>(player.throws));
+    players_.push_back(player);
+    ++size_;
+    point_at_owned();
+    return id;
+}
+
+void RosterStore::reserve(std::size_t n) {
+    if (snapshot_) copy_into_owned();
+    contact_.reserve(n);
+    power_.reserve(n);
+    eye_.reserve(n);
+    speed_.reserve(n);
+    stuff_.reserve(n);
+    control_.reserve(n);
+    movement_.reserve(n);
+    stamina_.reserve(n);
+    bats_.reserve(n);
+    throws_.reserve(n);
+    players_.reserve(n);
+    point_at_owned();
+}
+
+const Player& RosterStore::player(PlayerId id) const {
+    return snapshot_ ? snapshot_->decoded()[id] : players_[id];
+}
+
+void RosterStore::point_at_owned() {
+    columns_ = Columns{contact_.data(), power_.data(), eye_.data(), speed_.data(),
+                       stuff_.data(), control_.data(), movement_.data(), stamina_.data(),
+                       bats_.data(), throws_.data()};
+}
+
+void RosterStore::copy_into_owned() {
+    const Columns& c = columns_;
+    contact_.assign(c.contact, c.contact + size_);
+    power_.assign(c.power, c.power + size_);
+    eye_.assign(c.eye, c.eye + size_);
+    speed_.assign(c.speed, c.speed + size_);
+    stuff_.assign(c.stuff, c.stuff + size_);
+    control_.assign(c.control, c.control + size_);
+    movement_.assign(c.movement, c.movement + size_);
+    stamina_.assign(c.stamina, c.stamina + size_);
+    bats_.assign(c.bats, c.bats + size_);
+    throws_.assign(c.throws, c.throws + size_);
+    players_ = snapshot_->decoded();
+    snapshot_.reset();
+    point_at_owned();
+}
+
+void RosterStore::save_snapshot(const std::string& path) const {
+    std::string names;
+    std::vector<PlayerRecord> records;
+    records.reserve(size_);
+    for (PlayerId id = 0; id < size_; ++id) {
+        const Player& p = player(id);
+        records.push_back(make_record(p, static_cast<std::uint32_t>(names.size())));
+        names += p.name;
+    }
+
+    const SnapshotLayout layout(size_, names.size());
+    std::vector<char> buffer(layout.total, 0);
+    SnapshotHeader h{};
+    std::memcpy(h.magic, kMagic, sizeof(kMagic));
+    h.version = kVersion;
+    h.num_players = static_cast<std::uint32_t>(size_);
+    h.record_size = sizeof(PlayerRecord);
+    h.names_size = static_cast<std::uint32_t>(names.size());
+    std::memcpy(buffer.data(), &h, sizeof(h));
+    const float* floats[kNumFloatColumns] = {columns_.contact, columns_.power, columns_.eye, columns_.speed,
+                                             columns_.stuff, columns_.control, columns_.movement, columns_.stamina};
+    for (std::size_t c = 0; c < kNumFloatColumns; ++c) {
+        if (size_) std::memcpy(buffer.data() + layout.floats[c], floats[c], size_ * sizeof(float));
+    }
+    if (size_) {
+        std::memcpy(buffer.data() + layout.bats, columns_.bats, size_);
+        std::memcpy(buffer.data() + layout.throws, columns_.throws, size_);
+        std::memcpy(buffer.data() + layout.records, records.data(), size_ * sizeof(PlayerRecord));
+    }
+    std::memcpy(buffer.data() + layout.names, names.data(), names.size());
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) fail(path, "cannot open for writing");
+    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    if (!out) fail(path, "write failed");
+}
+
+RosterStore RosterStore::open_snapshot(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) fail(path, "cannot open");
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        fail(path, "cannot stat");
+    }
+    const auto size = static_cast<std::size_t>(st.st_size);
+    if (size < kHeaderSize) {
+        ::close(fd);
+        fail(path, "truncated header");
+    }
+    void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) fail(path, "mmap failed");
+
+    auto snapshot = std::make_shared<Snapshot>();
+    snapshot->mapping = mapping;
+    snapshot->mapping_size = size;
+
+    SnapshotHeader h;
+    std::memcpy(&h, mapping, sizeof(h));
+    if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0) fail(path, "not a roster snapshot");
+    if (h.version != kVersion) fail(path, "unsupported version");
+    if (h.record_size != sizeof(PlayerRecord)) fail(path, "unexpected record size");
+    const SnapshotLayout layout(h.num_players, h.names_size);
+    if (size != layout.total) fail(path, "size does not match header");
+
+    const char* base = static_cast<const char*>(mapping);
+    snapshot->num_players = h.num_players;
+    snapshot->records = reinterpret_cast<const PlayerRecord*>(base + layout.records);
+    snapshot->names = base + layout.names;
+    snapshot->names_size = h.names_size;
+
+    RosterStore store;
+    store.size_ = h.num_players;
+    const auto column = [&](std::size_t c) { return reinterpret_cast<const float*>(base + layout.floats[c]); };
+    store.columns_ = Columns{column(0), column(1), column(2), column(3), column(4), column(5), column(6), column(7),
+                             reinterpret_cast<const std::uint8_t*>(base + layout.bats),
+                             reinterpret_cast<const std::uint8_t*>(base + layout.throws)};
+    // Handedness feeds table indices in the sim, so refuse anything out of range up
+    // front. Records are only checked when decoded, so opening never pages them in.
+    for (std::size_t i = 0; i < store.size_; ++i) {
+        if (store.columns_.bats[i] > static_cast<std::uint8_t>(Handedness::SWITCH) ||
+            store.columns_.throws[i] > static_cast<std::uint8_t>(Handedness::SWITCH)) {
+            fail(path, "bad handedness for player " + std::to_string(i));
+        }
+    }
+    store.snapshot_ = std::move(snapshot);
+    return store;
+}
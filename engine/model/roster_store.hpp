@@ -0,0 +1,104 @@
+#pragma once
+
+#include "engine/model/player.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+using PlayerId = std::uint32_t;
+
+// Structure-of-arrays copy of the ratings the simulator reads, indexed by PlayerId.
+// The hot loop only ever touches these columns; the full Player (name, potential
+// ratings, pitch mix, ...) is kept on the side for reporting.
+//
+// A store either owns its columns (built with add()) or reads them in place from
+// a mapped snapshot (open_snapshot()). Adding to a mapped store copies it into
+// owned columns first.
+class RosterStore {
+public:
+    RosterStore() = default;
+    RosterStore(const RosterStore& other);
+    RosterStore& operator=(const RosterStore& other);
+    RosterStore(RosterStore&& other) noexcept = default;
+    RosterStore& operator=(RosterStore&& other) noexcept = default;
+
+    PlayerId add(const Player& player);
+
+    void reserve(std::size_t n);
+    std::size_t size() const { return size_; }
+
+    // Current batter ratings
+    const float* contact() const { return columns_.contact; }
+    const float* power() const { return columns_.power; }
+    const float* eye() const { return columns_.eye; }
+    const float* speed() const { return columns_.speed; }
+
+    // Current pitcher ratings
+    const float* stuff() const { return columns_.stuff; }
+    const float* control() const { return columns_.control; }
+    const float* movement() const { return columns_.movement; }
+    const float* stamina() const { return columns_.stamina; }
+
+    Handedness bats(PlayerId id) const { return static_cast<Handedness>(columns_.bats[id]); }
+    Handedness throws(PlayerId id) const { return static_cast<Handedness>(columns_.throws[id]); }
+
+    // Cold data: reporting only, never from the sim loop. For a mapped store the
+    // Players are decoded from the snapshot on first use (once, thread-safe).
+    const Player& player(PlayerId id) const;
+
+    // Binary snapshot: every column laid out as one aligned array, plus fixed-width
+    // records for the cold data, so opening one is an mmap and a header check.
+    // Throws std::runtime_error if the file can't be written / is missing or malformed.
+    void save_snapshot(const std::string& path) const;
+    static RosterStore open_snapshot(const std::string& path);
+
+    bool mapped() const { return snapshot_ != nullptr; }
+
+private:
+    struct Snapshot;
+
+    struct Columns {
+        const float* contact = nullptr;
+        const float* power = nullptr;
+        const float* eye = nullptr;
+        const float* speed = nullptr;
+        const float* stuff = nullptr;
+        const float* control = nullptr;
+        const float* movement = nullptr;
+        const float* stamina = nullptr;
+        const std::uint8_t* bats = nullptr;
+        const std::uint8_t* throws = nullptr;
+    };
+
+    void point_at_owned();
+    void copy_into_owned();
+
+    std::size_t size_ = 0;
+    Columns columns_;
+
+    std::vector<float> contact_;
+    std::vector<float> power_;
+    std::vector<float> eye_;
+    std::vector<float> speed_;
+    std::vector<float> stuff_;
+    std::vector<float> control_;
+    std::vector<float> movement_;
+    std::vector<float> stamina_;
+    std::vector<std::uint8_t> bats_;
+    std::vector<std::uint8_t> throws_;
+
+    std::vector<Player> players_;
+
+    std::shared_ptr<const Snapshot> snapshot_;  // shared by copies; immutable once mapped
+};
+
+// Loads players from a CSV file with a header row. Columns are matched by name
+// and may come in any order; see roster_csv.cpp for the full list. Required:
+// name, bats, throws and the current batter/pitcher ratings (contact, power, eye,
+// speed, stuff, control, movement, stamina). `<rating>_potential` defaults to
+// the current value, everything else to 0 / absent. Throws std::runtime_error
+// with the line number on malformed input.
+RosterStore load_roster_csv(const std::string& path);
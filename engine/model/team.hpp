@@ -0,0 +1,16 @@
+#pragma once
+
+#include "engine/model/roster_store.hpp"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+constexpr std::size_t kLineupSize = 9;
+
+struct Team {
+    std::string name;
+    std::vector<PlayerId> lineup;  // batting order, kLineupSize entries
+    PlayerId starting_pitcher;
+    std::vector<PlayerId> bullpen;  // relievers in the order they are called on; may be empty
+};
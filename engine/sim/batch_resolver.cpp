@@ -0,0 +1,221 @@
+#include "engine/sim/batch_resolver.hpp"
+
+#include "engine/core/instrument.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define THREEUP3DOWN_HAVE_AVX2_KERNEL 1
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define THREEUP3DOWN_HAVE_NEON_KERNEL 1
+#endif
+
+static_assert(sizeof(PlateAppearanceResult) == sizeof(std::int32_t), "SIMD kernels store results as int32 lanes");
+
+// The vector kernels below repeat outcome_distribution() op for op (same coefficients,
+// same evaluation order, true division) so every lane rounds exactly like the scalar path.
+
+namespace {
+
+void resolve_scalar(
+    const PlateAppearanceBatch& b, PlateAppearanceResult* out, std::size_t begin, const ResolveCoefficients& c) {
+    for (std::size_t i = begin; i < b.size; ++i) {
+        const OutcomeDistribution dist = outcome_distribution(
+            b.contact[i], b.power[i], b.eye[i], b.stuff[i], b.control[i], b.movement[i], b.same_hand[i], c);
+        out[i] = sample_outcome(dist, b.uniforms[i]);
+    }
+}
+
+#ifdef THREEUP3DOWN_HAVE_AVX2_KERNEL
+
+__attribute__((target("avx2")))
+__m256 clamp8(__m256 v, float lo, float hi) {
+    return _mm256_max_ps(_mm256_set1_ps(lo), _mm256_min_ps(_mm256_set1_ps(hi), v));
+}
+
+// Broadcast coefficient.
+__attribute__((target("avx2")))
+__m256 coef8(const ResolveCoefficients& c, ResolveCoefficientIndex i) {
+    return _mm256_set1_ps(c[i]);
+}
+
+// Picks table[same_hand] per lane; the permute copies the exact constant, no arithmetic.
+__attribute__((target("avx2")))
+__m256 platoon8(const float (&table)[2], __m256i same_hand) {
+    return _mm256_permutevar8x32_ps(_mm256_castps128_ps256(_mm_setr_ps(table[0], table[1], 0.f, 0.f)), same_hand);
+}
+
+__attribute__((target("avx2")))
+void resolve_avx2(const PlateAppearanceBatch& b, PlateAppearanceResult* out, const ResolveCoefficients& c) {
+    const __m256 one = _mm256_set1_ps(1.0f);
+    std::size_t i = 0;
+    for (; i + 8 <= b.size; i += 8) {
+        const __m256 contact = _mm256_loadu_ps(b.contact + i);
+        const __m256 power = _mm256_loadu_ps(b.power + i);
+        const __m256 eye = _mm256_loadu_ps(b.eye + i);
+        const __m256 stuff = _mm256_loadu_ps(b.stuff + i);
+        const __m256 control = _mm256_loadu_ps(b.control + i);
+        const __m256 movement = _mm256_loadu_ps(b.movement + i);
+        const __m256 u = _mm256_loadu_ps(b.uniforms + i);
+        const __m256i same_hand = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(b.same_hand + i)));
+
+        __m256 walk = _mm256_mul_ps(_mm256_mul_ps(coef8(c, COEF_WALK_SCALE), eye),
+                                    _mm256_sub_ps(one, _mm256_mul_ps(control, coef8(c, COEF_WALK_CONTROL))));
+        __m256 k = _mm256_mul_ps(
+            _mm256_mul_ps(coef8(c, COEF_STRIKEOUT_SCALE),
+                          _mm256_sub_ps(one, _mm256_mul_ps(contact, coef8(c, COEF_STRIKEOUT_CONTACT)))),
+            _mm256_add_ps(coef8(c, COEF_STRIKEOUT_STUFF_BASE), _mm256_mul_ps(stuff, coef8(c, COEF_STRIKEOUT_STUFF))));
+        __m256 hr = _mm256_mul_ps(_mm256_mul_ps(coef8(c, COEF_HOMERUN_SCALE), power),
+                                  _mm256_sub_ps(one, _mm256_mul_ps(movement, coef8(c, COEF_HOMERUN_MOVEMENT))));
+
+        walk = _mm256_mul_ps(walk, platoon8(kPlatoonWalkAdjust, same_hand));
+        k = _mm256_mul_ps(k, platoon8(kPlatoonStrikeoutAdjust, same_hand));
+        hr = _mm256_mul_ps(hr, platoon8(kPlatoonHomerunAdjust, same_hand));
+
+        walk = clamp8(walk, c[COEF_WALK_MIN], c[COEF_WALK_MAX]);
+        k = clamp8(k, c[COEF_STRIKEOUT_MIN], c[COEF_STRIKEOUT_MAX]);
+        hr = clamp8(hr, c[COEF_HOMERUN_MIN], c[COEF_HOMERUN_MAX]);
+
+        __m256 in_play = _mm256_sub_ps(_mm256_sub_ps(_mm256_sub_ps(one, walk), k), hr);
+        in_play = clamp8(in_play, c[COEF_IN_PLAY_MIN], c[COEF_IN_PLAY_MAX]);
+
+        const __m256 total = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(walk, k), hr), in_play);
+        walk = _mm256_div_ps(walk, total);
+        k = _mm256_div_ps(k, total);
+        hr = _mm256_div_ps(hr, total);
+        in_play = _mm256_div_ps(in_play, total);
+
+        __m256 thresholds[kNumPlateAppearanceResults - 1];
+        thresholds[0] = walk;
+        thresholds[1] = _mm256_add_ps(thresholds[0], _mm256_mul_ps(in_play, platoon8(kPlatoonHbpShare, same_hand)));
+        thresholds[2] = _mm256_add_ps(thresholds[1], _mm256_mul_ps(in_play, platoon8(kPlatoonSingleShare, same_hand)));
+        thresholds[3] = _mm256_add_ps(thresholds[2], _mm256_mul_ps(in_play, platoon8(kPlatoonDoubleShare, same_hand)));
+        thresholds[4] = _mm256_add_ps(thresholds[3], _mm256_mul_ps(in_play, platoon8(kPlatoonTripleShare, same_hand)));
+        thresholds[5] = _mm256_add_ps(thresholds[4], hr);
+        thresholds[6] = _mm256_add_ps(thresholds[5], k);
+
+        // Comparison masks are all-ones (-1) per true lane, so subtracting them counts.
+        __m256i idx = _mm256_setzero_si256();
+        for (const __m256& threshold : thresholds) {
+            idx = _mm256_sub_epi32(idx, _mm256_castps_si256(_mm256_cmp_ps(u, threshold, _CMP_GE_OQ)));
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), idx);
+    }
+    resolve_scalar(b, out, i, c);
+}
+
+#endif  // THREEUP3DOWN_HAVE_AVX2_KERNEL
+
+#ifdef THREEUP3DOWN_HAVE_NEON_KERNEL
+
+float32x4_t clamp4(float32x4_t v, float lo, float hi) {
+    return vmaxq_f32(vdupq_n_f32(lo), vminq_f32(vdupq_n_f32(hi), v));
+}
+
+float32x4_t platoon4(const float (&table)[2], uint32x4_t same_mask) {
+    return vbslq_f32(same_mask, vdupq_n_f32(table[1]), vdupq_n_f32(table[0]));
+}
+
+float32x4_t coef4(const ResolveCoefficients& c, ResolveCoefficientIndex i) {
+    return vdupq_n_f32(c[i]);
+}
+
+void resolve_neon(const PlateAppearanceBatch& b, PlateAppearanceResult* out, const ResolveCoefficients& c) {
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    std::size_t i = 0;
+    for (; i + 4 <= b.size; i += 4) {
+        const float32x4_t contact = vld1q_f32(b.contact + i);
+        const float32x4_t power = vld1q_f32(b.power + i);
+        const float32x4_t eye = vld1q_f32(b.eye + i);
+        const float32x4_t stuff = vld1q_f32(b.stuff + i);
+        const float32x4_t control = vld1q_f32(b.control + i);
+        const float32x4_t movement = vld1q_f32(b.movement + i);
+        const float32x4_t u = vld1q_f32(b.uniforms + i);
+        std::uint32_t packed_hands;
+        std::memcpy(&packed_hands, b.same_hand + i, sizeof(packed_hands));
+        const uint32x4_t same_mask = vcgtq_u32(
+            vmovl_u16(vget_low_u16(vmovl_u8(vcreate_u8(packed_hands)))), vdupq_n_u32(0));
+
+        float32x4_t walk = vmulq_f32(vmulq_f32(coef4(c, COEF_WALK_SCALE), eye),
+                                     vsubq_f32(one, vmulq_f32(control, coef4(c, COEF_WALK_CONTROL))));
+        float32x4_t k = vmulq_f32(
+            vmulq_f32(coef4(c, COEF_STRIKEOUT_SCALE), vsubq_f32(one, vmulq_f32(contact, coef4(c, COEF_STRIKEOUT_CONTACT)))),
+            vaddq_f32(coef4(c, COEF_STRIKEOUT_STUFF_BASE), vmulq_f32(stuff, coef4(c, COEF_STRIKEOUT_STUFF))));
+        float32x4_t hr = vmulq_f32(vmulq_f32(coef4(c, COEF_HOMERUN_SCALE), power),
+                                   vsubq_f32(one, vmulq_f32(movement, coef4(c, COEF_HOMERUN_MOVEMENT))));
+
+        walk = vmulq_f32(walk, platoon4(kPlatoonWalkAdjust, same_mask));
+        k = vmulq_f32(k, platoon4(kPlatoonStrikeoutAdjust, same_mask));
+        hr = vmulq_f32(hr, platoon4(kPlatoonHomerunAdjust, same_mask));
+
+        walk = clamp4(walk, c[COEF_WALK_MIN], c[COEF_WALK_MAX]);
+        k = clamp4(k, c[COEF_STRIKEOUT_MIN], c[COEF_STRIKEOUT_MAX]);
+        hr = clamp4(hr, c[COEF_HOMERUN_MIN], c[COEF_HOMERUN_MAX]);
+
+        float32x4_t in_play = vsubq_f32(vsubq_f32(vsubq_f32(one, walk), k), hr);
+        in_play = clamp4(in_play, c[COEF_IN_PLAY_MIN], c[COEF_IN_PLAY_MAX]);
+
+        const float32x4_t total = vaddq_f32(vaddq_f32(vaddq_f32(walk, k), hr), in_play);
+        walk = vdivq_f32(walk, total);
+        k = vdivq_f32(k, total);
+        hr = vdivq_f32(hr, total);
+        in_play = vdivq_f32(in_play, total);
+
+        float32x4_t thresholds[kNumPlateAppearanceResults - 1];
+        thresholds[0] = walk;
+        thresholds[1] = vaddq_f32(thresholds[0], vmulq_f32(in_play, platoon4(kPlatoonHbpShare, same_mask)));
+        thresholds[2] = vaddq_f32(thresholds[1], vmulq_f32(in_play, platoon4(kPlatoonSingleShare, same_mask)));
+        thresholds[3] = vaddq_f32(thresholds[2], vmulq_f32(in_play, platoon4(kPlatoonDoubleShare, same_mask)));
+        thresholds[4] = vaddq_f32(thresholds[3], vmulq_f32(in_play, platoon4(kPlatoonTripleShare, same_mask)));
+        thresholds[5] = vaddq_f32(thresholds[4], hr);
+        thresholds[6] = vaddq_f32(thresholds[5], k);
+
+        int32x4_t idx = vdupq_n_s32(0);
+        for (const float32x4_t& threshold : thresholds) {
+            idx = vsubq_s32(idx, vreinterpretq_s32_u32(vcgeq_f32(u, threshold)));
+        }
+        vst1q_s32(reinterpret_cast<std::int32_t*>(out + i), idx);
+    }
+    resolve_scalar(b, out, i, c);
+}
+
+#endif  // THREEUP3DOWN_HAVE_NEON_KERNEL
+
+}  // namespace
+
+BatchKernel best_batch_kernel() {
+#ifdef THREEUP3DOWN_HAVE_AVX2_KERNEL
+    static const bool has_avx2 = __builtin_cpu_supports("avx2");
+    if (has_avx2) return BatchKernel::AVX2;
+#endif
+#ifdef THREEUP3DOWN_HAVE_NEON_KERNEL
+    return BatchKernel::NEON;
+#endif
+    return BatchKernel::SCALAR;
+}
+
+void resolve_batch(
+    const PlateAppearanceBatch& batch, PlateAppearanceResult* out, BatchKernel kernel,
+    const ResolveCoefficients& coefficients) {
+    THREEUP3DOWN_COUNT_N(PLATE_APPEARANCES, batch.size);
+    switch (kernel) {
+#ifdef THREEUP3DOWN_HAVE_AVX2_KERNEL
+        case BatchKernel::AVX2:
+            resolve_avx2(batch, out, coefficients);
+            return;
+#endif
+#ifdef THREEUP3DOWN_HAVE_NEON_KERNEL
+        case BatchKernel::NEON:
+            resolve_neon(batch, out, coefficients);
+            return;
+#endif
+        default:
+            resolve_scalar(batch, out, 0, coefficients);
+            return;
+    }
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "engine/sim/plate_appearence.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+// Structure-of-arrays input for resolving many independent PAs in lockstep, e.g.
+// one PA from each of thousands of concurrently simulated games. Lane i uses
+// element i of every array; same_hand[i] is platoon_same() (0 or 1) and
+// uniforms[i] is the draw for that PA.
+struct PlateAppearanceBatch {
+    const float* contact;
+    const float* power;
+    const float* eye;
+    const float* stuff;
+    const float* control;
+    const float* movement;
+    const std::uint8_t* same_hand;
+    const float* uniforms;
+    std::size_t size;
+};
+
+enum class BatchKernel {
+    SCALAR,
+    AVX2,
+    NEON
+};
+
+// Fastest kernel compiled in and supported by the running CPU.
+BatchKernel best_batch_kernel();
+
+// Writes batch.size results to out. Every kernel is bit-identical to
+// sample_outcome(outcome_distribution(..., coefficients), u) for each lane.
+void resolve_batch(
+    const PlateAppearanceBatch& batch, PlateAppearanceResult* out, BatchKernel kernel,
+    const ResolveCoefficients& coefficients);
+
+inline void resolve_batch(const PlateAppearanceBatch& batch, PlateAppearanceResult* out, BatchKernel kernel) {
+    resolve_batch(batch, out, kernel, kResolveCoefficients);
+}
+
+inline void resolve_batch(const PlateAppearanceBatch& batch, PlateAppearanceResult* out) {
+    resolve_batch(batch, out, best_batch_kernel(), kResolveCoefficients);
+}
@@ -0,0 +1,48 @@
+#include "engine/sim/cube_outcome_table.hpp"
+
+#include "engine/core/instrument.hpp"
+#include "engine/model/outcome_rates.hpp"
+
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+CubeOutcomeTable::CubeOutcomeTable(
+    const ProbabilityCube& cube,
+    const RosterStore& roster,
+    const std::vector<PlayerId>& batters,
+    const std::vector<PlayerId>& pitchers)
+    : num_batters_(batters.size()),
+      num_pitchers_(pitchers.size()),
+      count_stride_(cube.cell(1, 0, 0, 0)),
+      fresh_(::fatigue_schedule(fatigue_, 0.f)) {
+    if (cube.num_cells() > 0xffff) throw std::invalid_argument("CubeOutcomeTable: too many cube cells");
+    THREEUP3DOWN_COUNT(CACHE_REBUILDS);
+    pair_cell_.reserve(num_batters_ * num_pitchers_);
+    for (PlayerId p : pitchers) {
+        for (PlayerId b : batters) {
+            const int same = platoon_same(roster.bats(b), roster.throws(p));
+            pair_cell_.push_back(static_cast<std::uint16_t>(cube.cell(0, same, cube.first_inning(), 0)));
+        }
+    }
+    for (std::size_t i = 0; i < std::size(inning_cell_); ++i) {
+        inning_cell_[i] = static_cast<std::uint16_t>(cube.cell(0, 0, static_cast<int>(i), 0));
+    }
+    // Probabilities as sample_cumulative reads the row: the gaps between its
+    // first kNumOutcomeRates - 1 thresholds, the rest to the last outcome.
+    aliases_.reserve(cube.num_cells());
+    for (std::size_t c = 0; c < cube.num_cells(); ++c) {
+        const float* cumulative = cube.cell_row(c);
+        float probs[kNumPlateAppearanceResults];
+        float below = 0.f;
+        for (std::size_t i = 0; i + 1 < kNumPlateAppearanceResults; ++i) {
+            if (!(cumulative[i] >= below && cumulative[i] <= 1.f)) {
+                throw std::invalid_argument("CubeOutcomeTable: cube cell " + std::to_string(c) + " is not a cumulative row");
+            }
+            probs[i] = cumulative[i] - below;
+            below = cumulative[i];
+        }
+        probs[kNumPlateAppearanceResults - 1] = 1.f - below;
+        aliases_.emplace_back(probs);
+    }
+}
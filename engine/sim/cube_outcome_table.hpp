@@ -0,0 +1,59 @@
+#pragma once
+
+#include "engine/model/probability_cube.hpp"
+#include "engine/model/roster_store.hpp"
+#include "engine/sim/fatigue.hpp"
+#include "engine/sim/game_state.hpp"
+#include "engine/sim/plate_appearence.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// The game loop's outcome source for the ML model's context-dependent rates:
+// each PA draws from the ProbabilityCube row for its count, platoon side,
+// inning and outs. Every cell's row is kept as an alias table (built once; a
+// cube has a few hundred cells) and a cell's index is a sum of per-pair,
+// per-count, per-inning and per-outs offsets, so a PA is one lookup plus one
+// alias draw, about the cost of a MatchupTable PA. Ratings are never read; what a pair
+// contributes is the platoon side, kept per pair in the same rows, columns and
+// pitcher-major layout as a MatchupTable built from the same lists. Pitchers
+// stay fresh (one fatigue bucket); bullpens are still used as each
+// BullpenPolicy says.
+//
+// Copies what it needs; the cube can be unmapped once the table is built.
+class CubeOutcomeTable {
+public:
+    // Throws std::invalid_argument if a cube row is not a cumulative
+    // distribution or the cube has more than 65535 cells.
+    CubeOutcomeTable(
+        const ProbabilityCube& cube,
+        const RosterStore& roster,
+        const std::vector<PlayerId>& batters,
+        const std::vector<PlayerId>& pitchers);
+
+    // The distribution of ProbabilityCube::row for this pair at `state`.
+    const OutcomeAliasTable& alias_at(std::size_t batter, std::size_t pitcher, const GameState& state) const {
+        return aliases_[pair_cell_[pitcher * num_batters_ + batter] + state.count_id() * count_stride_ +
+                        inning_cell_[static_cast<std::size_t>(state.inning())] + state.outs()];
+    }
+
+    std::size_t num_batters() const { return num_batters_; }
+    std::size_t num_pitchers() const { return num_pitchers_; }
+
+    const FatigueModel& fatigue() const { return fatigue_; }
+    std::size_t fatigue_buckets() const { return 1; }
+    const FatigueSchedule& fatigue_schedule(std::size_t) const { return fresh_; }
+
+private:
+    std::size_t num_batters_;
+    std::size_t num_pitchers_;
+    // ProbabilityCube::cell(count, same_hand, inning, outs) ==
+    // pair_cell_[pair] + count * count_stride_ + inning_cell_[inning] + outs.
+    std::vector<std::uint16_t> pair_cell_;  // by platoon_same(), [pitcher * num_batters + batter]
+    std::size_t count_stride_;
+    std::uint16_t inning_cell_[64];         // every inning GameState can hold
+    std::vector<OutcomeAliasTable> aliases_;  // [ProbabilityCube::cell]
+    FatigueModel fatigue_;
+    FatigueSchedule fresh_;
+};
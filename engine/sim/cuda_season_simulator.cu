@@ -0,0 +1,429 @@
+#include "engine/sim/cuda_season_simulator.hpp"
+
+#include <cuda_runtime.h>
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+void check(cudaError_t err, const char* what) {
+    if (err != cudaSuccess) throw std::runtime_error(std::string("CUDA ") + what + ": " + cudaGetErrorString(err));
+}
+
+constexpr unsigned kBlock = 256;
+// Games per launch, and per-player line counters per launch; bound how many
+// replications' seasons are live on the device (and read back) at once.
+constexpr std::size_t kGamesPerLaunch = std::size_t{1} << 22;
+constexpr std::size_t kLineCountersPerLaunch = std::size_t{1} << 24;
+// Each block sums its games in shared memory before touching the global totals.
+constexpr std::size_t kMaxSharedCounters = (48 * 1024) / sizeof(unsigned);
+
+// Per team: these, then one game_runs bin per run plus the overflow.
+enum TeamCounter : unsigned { WINS, LOSSES, RUNS_SCORED, RUNS_ALLOWED, kNumTeamCounters };
+// Per player and replication: a BattingLine, results then runs batted in.
+constexpr unsigned kRunsBattedIn = static_cast<unsigned>(kNumPlateAppearanceResults);
+constexpr unsigned kLineWidth = kRunsBattedIn + 1;
+
+__constant__ std::uint8_t c_next[kNumBaseOutStates * kNumPlateAppearanceResults];
+__constant__ std::uint8_t c_runs[kNumBaseOutStates * kNumPlateAppearanceResults];
+
+// Pcg32 and BasicRNG::uniform, draw for draw.
+struct DeviceRng {
+    std::uint64_t state;
+    std::uint64_t inc;
+
+    __device__ std::uint32_t next() {
+        const std::uint64_t old = state;
+        state = old * 6364136223846793005ULL + inc;
+        const auto xorshifted = static_cast<std::uint32_t>(((old >> 18) ^ old) >> 27);
+        const auto rot = static_cast<std::uint32_t>(old >> 59);
+        return (xorshifted >> rot) | (xorshifted << ((0u - rot) & 31u));
+    }
+
+    __device__ float uniform() { return static_cast<float>(next() >> 8) * 0x1.0p-24f; }
+};
+
+// game_rng(seed, replication, game): the stream is a function of the game's
+// coordinates alone.
+__device__ DeviceRng game_stream(std::uint64_t seed, std::uint64_t replication, std::uint32_t game) {
+    std::uint64_t z = (seed ^ (replication * 0xd1b54a32d192ed03ULL)) + 0x9e3779b97f4a7c15ULL;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    z ^= z >> 31;
+    DeviceRng rng{0, (static_cast<std::uint64_t>(game) << 1) | 1u};
+    rng.next();
+    rng.state += z;
+    rng.next();
+    return rng;
+}
+
+// Device copy of the league: one alias table per (pitcher, batter), as
+// MatchupTable::alias_at with a single bucket, split into keep / alias arrays.
+struct League {
+    const float* keep;              // [(pitcher * num_batters + batter) * N + column]
+    const std::uint8_t* alias;
+    const std::uint32_t* batters;   // [team * kLineupSize + slot], table rows
+    const std::uint32_t* starters;  // [team], table columns
+    const std::uint32_t* home;      // [game]
+    const std::uint32_t* away;
+    std::uint32_t num_batters;
+    std::uint32_t num_pitchers;
+    std::uint32_t num_teams;
+    std::uint32_t num_games;
+    std::uint32_t run_bins;         // game_runs bins; runs >= run_bins overflow
+};
+
+struct Accumulators {
+    unsigned long long* teams;  // [team * team_width + counter or kNumTeamCounters + bin]
+    unsigned* season_wins;      // [replication in launch * num_teams + team]
+    unsigned* season_runs;
+    // [(replication in launch * num_batters + row) * kLineWidth + field]; both
+    // null without player lines.
+    unsigned* batting;
+    unsigned* pitching;         // [(replication in launch * num_pitchers + column) * kLineWidth + field]
+};
+
+__device__ unsigned team_width(const League& league) { return kNumTeamCounters + league.run_bins + 1; }
+
+__device__ unsigned sample(const float* keep, const std::uint8_t* alias, float u) {
+    constexpr unsigned n = static_cast<unsigned>(kNumPlateAppearanceResults);
+    const float scaled = u * static_cast<float>(n);
+    const unsigned column = min(static_cast<unsigned>(scaled), n - 1);
+    const float coin = scaled - static_cast<float>(column);
+    return coin >= keep[column] ? alias[column] : column;
+}
+
+// The PA-level game loop with starters only, GameState::apply's rules on
+// unpacked fields. Each PA goes into the replication's `batting` / `pitching`
+// lines when they are given.
+__device__ void play_game(const League& league, std::uint32_t home, std::uint32_t away, DeviceRng& rng,
+                          unsigned* batting, unsigned* pitching, int (&score)[2]) {
+    const std::uint32_t* lineups[2] = {league.batters + away * kLineupSize, league.batters + home * kLineupSize};
+    const std::uint32_t pitchers[2] = {league.starters[home], league.starters[away]};  // [batting side]
+    unsigned slots[2] = {0, 0};
+    unsigned base_out = 0;
+    int inning = 1;
+    int bottom = 0;
+    score[0] = score[1] = 0;
+    for (;;) {
+        const std::size_t entry =
+            (static_cast<std::size_t>(pitchers[bottom]) * league.num_batters + lineups[bottom][slots[bottom]]) *
+            kNumPlateAppearanceResults;
+        const unsigned result = sample(league.keep + entry, league.alias + entry, rng.uniform());
+        const unsigned t = base_out * kNumPlateAppearanceResults + result;
+        if (batting) {
+            unsigned* batter = batting + lineups[bottom][slots[bottom]] * kLineWidth;
+            unsigned* against = pitching + pitchers[bottom] * kLineWidth;
+            atomicAdd(batter + result, 1u);
+            atomicAdd(against + result, 1u);
+            if (c_runs[t]) {
+                atomicAdd(batter + kRunsBattedIn, static_cast<unsigned>(c_runs[t]));
+                atomicAdd(against + kRunsBattedIn, static_cast<unsigned>(c_runs[t]));
+            }
+        }
+        slots[bottom] = slots[bottom] + 1 == kLineupSize ? 0u : slots[bottom] + 1;
+        score[bottom] += c_runs[t];
+        if ((c_next[t] >> 3) < 3) {  // outs, as base_out_outs()
+            base_out = c_next[t];
+            if (bottom && inning >= 9 && score[1] > score[0]) return;  // walk-off
+            continue;
+        }
+        base_out = 0;
+        if (!bottom) {
+            if (inning >= 9 && score[1] > score[0]) return;
+            bottom = 1;
+        } else {
+            if ((inning >= 9 && score[1] != score[0]) || inning >= kMaxInnings) return;
+            bottom = 0;
+            ++inning;
+        }
+    }
+}
+
+// One thread per (replication, game), replications [first, first + games / num_games).
+__global__ void play_games(League league, Accumulators acc, std::uint64_t seed, std::uint64_t first,
+                           std::uint64_t games) {
+    extern __shared__ unsigned block_counts[];
+    const unsigned width = team_width(league);
+    for (unsigned i = threadIdx.x; i < league.num_teams * width; i += blockDim.x) block_counts[i] = 0;
+    __syncthreads();
+
+    const std::uint64_t i = static_cast<std::uint64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+    if (i < games) {
+        const std::uint64_t local = i / league.num_games;
+        const auto g = static_cast<std::uint32_t>(i % league.num_games);
+        const std::uint32_t home = league.home[g];
+        const std::uint32_t away = league.away[g];
+        DeviceRng rng = game_stream(seed, first + local, g);
+        unsigned* batting = acc.batting ? acc.batting + local * league.num_batters * kLineWidth : nullptr;
+        unsigned* pitching = acc.pitching ? acc.pitching + local * league.num_pitchers * kLineWidth : nullptr;
+        int score[2];  // [0] away, [1] home
+        play_game(league, home, away, rng, batting, pitching, score);
+
+        unsigned* h = block_counts + home * width;
+        unsigned* a = block_counts + away * width;
+        atomicAdd(h + RUNS_SCORED, static_cast<unsigned>(score[1]));
+        atomicAdd(h + RUNS_ALLOWED, static_cast<unsigned>(score[0]));
+        atomicAdd(a + RUNS_SCORED, static_cast<unsigned>(score[0]));
+        atomicAdd(a + RUNS_ALLOWED, static_cast<unsigned>(score[1]));
+        atomicAdd(h + kNumTeamCounters + min(static_cast<unsigned>(score[1]), league.run_bins), 1u);
+        atomicAdd(a + kNumTeamCounters + min(static_cast<unsigned>(score[0]), league.run_bins), 1u);
+        unsigned* season_wins = acc.season_wins + local * league.num_teams;
+        unsigned* season_runs = acc.season_runs + local * league.num_teams;
+        atomicAdd(season_runs + home, static_cast<unsigned>(score[1]));
+        atomicAdd(season_runs + away, static_cast<unsigned>(score[0]));
+        // Ties only happen at the inning cap; they count for neither side.
+        if (score[1] > score[0]) {
+            atomicAdd(h + WINS, 1u);
+            atomicAdd(a + LOSSES, 1u);
+            atomicAdd(season_wins + home, 1u);
+        } else if (score[0] > score[1]) {
+            atomicAdd(a + WINS, 1u);
+            atomicAdd(h + LOSSES, 1u);
+            atomicAdd(season_wins + away, 1u);
+        }
+    }
+    __syncthreads();
+    for (unsigned k = threadIdx.x; k < league.num_teams * width; k += blockDim.x) {
+        if (block_counts[k]) atomicAdd(acc.teams + k, static_cast<unsigned long long>(block_counts[k]));
+    }
+}
+
+template <typename T>
+class DeviceBuffer {
+public:
+    DeviceBuffer() = default;
+    explicit DeviceBuffer(std::size_t n) : size_(n) {
+        if (n) check(cudaMalloc(reinterpret_cast<void**>(&data_), n * sizeof(T)), "allocation");
+    }
+    explicit DeviceBuffer(const std::vector<T>& host) : DeviceBuffer(host.size()) {
+        if (size_) check(cudaMemcpy(data_, host.data(), size_ * sizeof(T), cudaMemcpyHostToDevice), "upload");
+    }
+    ~DeviceBuffer() {
+        if (data_) cudaFree(data_);
+    }
+    DeviceBuffer(DeviceBuffer&& o) noexcept : data_(std::exchange(o.data_, nullptr)), size_(std::exchange(o.size_, 0)) {}
+    DeviceBuffer& operator=(DeviceBuffer&& o) noexcept {
+        std::swap(data_, o.data_);
+        std::swap(size_, o.size_);
+        return *this;
+    }
+
+    void fill_bytes(int byte) { check(cudaMemset(data_, byte, size_ * sizeof(T)), "memset"); }
+
+    std::vector<T> download() const {
+        std::vector<T> host(size_);
+        if (size_) check(cudaMemcpy(host.data(), data_, size_ * sizeof(T), cudaMemcpyDeviceToHost), "download");
+        return host;
+    }
+
+    T* data() const { return data_; }
+
+private:
+    T* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+}  // namespace
+
+struct CudaSeasonSimulator::Device {
+    DeviceBuffer<float> keep;
+    DeviceBuffer<std::uint8_t> alias;
+    DeviceBuffer<std::uint32_t> batters;
+    DeviceBuffer<std::uint32_t> starters;
+    DeviceBuffer<std::uint32_t> home;
+    DeviceBuffer<std::uint32_t> away;
+    League league{};
+};
+
+bool CudaSeasonSimulator::available() {
+    int count = 0;
+    return cudaGetDeviceCount(&count) == cudaSuccess && count > 0;
+}
+
+CudaSeasonSimulator::CudaSeasonSimulator(
+    const RosterStore& roster, const std::vector<Team>& teams, std::vector<ScheduledGame> schedule,
+    SimulationMode mode, const FatigueModel& fatigue)
+    : host_(roster, teams, std::move(schedule), mode, fatigue) {
+    if (mode != SimulationMode::PLATE_APPEARANCE) {
+        throw std::invalid_argument("CUDA season backend plays PLATE_APPEARANCE mode only");
+    }
+    const MatchupTable& table = host_.matchup_table();
+    if (table.fatigue_buckets() > 1) throw std::invalid_argument("CUDA season backend has no fatigue model");
+    const std::vector<GameLineup>& lineups = host_.lineups();
+    for (std::size_t t = 0; t < lineups.size(); ++t) {
+        if (lineups[t].bullpen_size > 0) {
+            throw std::invalid_argument("team " + teams[t].name + " has a bullpen; the CUDA season backend plays starters only");
+        }
+    }
+    const std::size_t run_bins = host_.empty_results().teams.at(0).game_runs.bins();
+    if (lineups.size() * (kNumTeamCounters + run_bins + 1) > kMaxSharedCounters) {
+        throw std::invalid_argument("too many teams for the CUDA season backend");
+    }
+    if (!available()) throw std::runtime_error("CUDA season backend: no device");
+
+    const std::size_t entries = table.num_pitchers() * table.num_batters();
+    std::vector<float> keep(entries * kNumPlateAppearanceResults);
+    std::vector<std::uint8_t> alias(entries * kNumPlateAppearanceResults);
+    for (std::size_t p = 0; p < table.num_pitchers(); ++p) {
+        for (std::size_t b = 0; b < table.num_batters(); ++b) {
+            const OutcomeAliasTable& pair = table.alias_at(b, p);
+            const std::size_t base = (p * table.num_batters() + b) * kNumPlateAppearanceResults;
+            for (std::size_t c = 0; c < kNumPlateAppearanceResults; ++c) {
+                keep[base + c] = pair.keep(c);
+                alias[base + c] = pair.alias(c);
+            }
+        }
+    }
+    std::vector<std::uint32_t> batters;
+    std::vector<std::uint32_t> starters;
+    for (const GameLineup& l : lineups) {
+        batters.insert(batters.end(), l.batters.begin(), l.batters.end());
+        starters.push_back(l.pitcher);
+    }
+    std::vector<std::uint32_t> home;
+    std::vector<std::uint32_t> away;
+    for (const ScheduledGame& g : host_.schedule()) {
+        home.push_back(g.home);
+        away.push_back(g.away);
+    }
+
+    std::uint8_t next[kNumBaseOutStates * kNumPlateAppearanceResults];
+    std::uint8_t runs[kNumBaseOutStates * kNumPlateAppearanceResults];
+    for (std::size_t s = 0; s < kNumBaseOutStates; ++s) {
+        for (std::size_t r = 0; r < kNumPlateAppearanceResults; ++r) {
+            next[s * kNumPlateAppearanceResults + r] = kBaseOutTransitions[s][r].next;
+            runs[s * kNumPlateAppearanceResults + r] = kBaseOutTransitions[s][r].runs;
+        }
+    }
+    check(cudaMemcpyToSymbol(c_next, next, sizeof(next)), "transition upload");
+    check(cudaMemcpyToSymbol(c_runs, runs, sizeof(runs)), "transition upload");
+
+    device_ = std::make_unique<Device>();
+    device_->keep = DeviceBuffer<float>(keep);
+    device_->alias = DeviceBuffer<std::uint8_t>(alias);
+    device_->batters = DeviceBuffer<std::uint32_t>(batters);
+    device_->starters = DeviceBuffer<std::uint32_t>(starters);
+    device_->home = DeviceBuffer<std::uint32_t>(home);
+    device_->away = DeviceBuffer<std::uint32_t>(away);
+    device_->league = League{
+        device_->keep.data(), device_->alias.data(), device_->batters.data(), device_->starters.data(),
+        device_->home.data(), device_->away.data(),
+        static_cast<std::uint32_t>(table.num_batters()), static_cast<std::uint32_t>(table.num_pitchers()),
+        static_cast<std::uint32_t>(lineups.size()),
+        static_cast<std::uint32_t>(home.size()), static_cast<std::uint32_t>(run_bins),
+    };
+}
+
+CudaSeasonSimulator::~CudaSeasonSimulator() = default;
+
+SeasonResults CudaSeasonSimulator::run(const SeasonConfig& config) const {
+    const SeasonResults shape = host_.empty_results();
+    const League& league = device_->league;
+    if (config.replications == 0 || league.num_games == 0) {
+        SeasonResults results = shape;
+        results.replications = config.replications;
+        return results;
+    }
+
+    const std::size_t teams = league.num_teams;
+    const std::size_t width = kNumTeamCounters + league.run_bins + 1;
+    const bool lines = config.player_lines;
+    const std::size_t line_counters = (std::size_t{league.num_batters} + league.num_pitchers) * kLineWidth;
+    std::size_t per_launch = std::max<std::size_t>(1, kGamesPerLaunch / league.num_games);
+    if (lines) per_launch = std::max<std::size_t>(1, std::min(per_launch, kLineCountersPerLaunch / line_counters));
+    DeviceBuffer<unsigned long long> team_counts(teams * width);
+    DeviceBuffer<unsigned> season_wins(per_launch * teams);
+    DeviceBuffer<unsigned> season_runs(per_launch * teams);
+    DeviceBuffer<unsigned> batting(lines ? per_launch * league.num_batters * kLineWidth : 0);
+    DeviceBuffer<unsigned> pitching(lines ? per_launch * league.num_pitchers * kLineWidth : 0);
+    team_counts.fill_bytes(0);
+
+    const Accumulators acc{team_counts.data(), season_wins.data(), season_runs.data(), batting.data(),
+                           pitching.data()};
+    const std::size_t shared = teams * width * sizeof(unsigned);
+    // One leaf per replication, folded in replication order exactly as on the CPU.
+    ReplicationFold fold;
+    std::vector<std::uint32_t> wins(teams);
+    std::vector<std::uint64_t> runs(teams);
+    std::vector<BattingLine> batter_lines(lines ? league.num_batters : 0);
+    std::vector<BattingLine> pitcher_lines(lines ? league.num_pitchers : 0);
+    const auto unpack = [](const unsigned* counters, std::vector<BattingLine>& out) {
+        for (BattingLine& line : out) {
+            for (std::size_t r = 0; r < kNumPlateAppearanceResults; ++r) line.results[r] = counters[r];
+            line.runs_batted_in = counters[kRunsBattedIn];
+            counters += kLineWidth;
+        }
+    };
+    for (std::size_t first = 0; first < config.replications; first += per_launch) {
+        const std::size_t reps = std::min(per_launch, config.replications - first);
+        season_wins.fill_bytes(0);
+        season_runs.fill_bytes(0);
+        if (lines) {
+            batting.fill_bytes(0);
+            pitching.fill_bytes(0);
+        }
+        const std::uint64_t games = static_cast<std::uint64_t>(reps) * league.num_games;
+        const auto game_blocks = static_cast<unsigned>((games + kBlock - 1) / kBlock);
+        play_games<<<game_blocks, kBlock, shared>>>(league, acc, config.seed, first, games);
+        check(cudaGetLastError(), "game launch");
+
+        const std::vector<unsigned> launch_wins = season_wins.download();
+        const std::vector<unsigned> launch_runs = season_runs.download();
+        const std::vector<unsigned> launch_batting = batting.download();
+        const std::vector<unsigned> launch_pitching = pitching.download();
+        for (std::size_t local = 0; local < reps; ++local) {
+            for (std::size_t t = 0; t < teams; ++t) {
+                wins[t] = launch_wins[local * teams + t];
+                runs[t] = launch_runs[local * teams + t];
+            }
+            if (lines) {
+                unpack(&launch_batting[local * league.num_batters * kLineWidth], batter_lines);
+                unpack(&launch_pitching[local * league.num_pitchers * kLineWidth], pitcher_lines);
+            }
+            SeasonResults leaf = fold.fresh(shape);
+            add_replication_lines(leaf, wins.data(), runs.data(), lines ? batter_lines.data() : nullptr,
+                                  lines ? pitcher_lines.data() : nullptr);
+            fold.push({first + local, 0, std::move(leaf)});
+        }
+    }
+
+    // The per-game fields: integer sums, so order never mattered.
+    SeasonResults results = fold.result(shape);
+    const std::vector<unsigned long long> counts = team_counts.download();
+    for (std::size_t t = 0; t < teams; ++t) {
+        TeamSeasonTotals& team = results.teams[t];
+        const unsigned long long* c = &counts[t * width];
+        team.wins = c[WINS];
+        team.losses = c[LOSSES];
+        team.runs_scored = c[RUNS_SCORED];
+        team.runs_allowed = c[RUNS_ALLOWED];
+        for (std::size_t b = 0; b < league.run_bins; ++b) team.game_runs.add_to_bin(b, c[kNumTeamCounters + b]);
+        team.game_runs.add_overflow(c[kNumTeamCounters + league.run_bins]);
+    }
+    // Starters pitch every game, so starts are the schedule's, once per replication.
+    const std::vector<GameLineup>& lineups = host_.lineups();
+    for (const ScheduledGame& g : host_.schedule()) {
+        results.pitchers[lineups[g.home].pitcher].games_started += config.replications;
+        results.pitchers[lineups[g.away].pitcher].games_started += config.replications;
+    }
+    return results;
+}
+
+std::unique_ptr<SeasonRunner> make_season_runner(
+    const RosterStore& roster, const std::vector<Team>& teams, std::vector<ScheduledGame> schedule,
+    SimulationMode mode, const FatigueModel& fatigue) {
+    if (CudaSeasonSimulator::available()) {
+        try {
+            return std::make_unique<CudaSeasonSimulator>(roster, teams, schedule, mode, fatigue);
+        } catch (const std::invalid_argument&) {
+            // A league the device loop doesn't model; the CPU plays it.
+        }
+    }
+    return std::make_unique<SeasonSimulator>(roster, teams, std::move(schedule), mode, fatigue);
+}
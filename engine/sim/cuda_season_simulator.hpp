@@ -0,0 +1,72 @@
+#pragma once
+
+#include "engine/sim/season_simulator.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// SeasonSimulator on a CUDA device, for replication counts in the millions
+// (built with -DTHREEUP3DOWN_CUDA=ON into threeup3down_cuda; the CPU engine
+// is the same either way).
+//
+// The host builds the league exactly as SeasonSimulator does and uploads it
+// once: the alias tables as SoA keep / alias arrays, team lineups and
+// starters, the schedule and the base-out transitions. Each device thread then
+// plays one scheduled game of one replication on that game's own stream
+// (game_rng: keyed by seed, replication and game, so no state is carried
+// between threads), with the same draws, alias sampling and GameState rules as
+// the CPU loop. A game plays out exactly as SeasonSimulator::play_scheduled_game
+// would.
+//
+// The device keeps per-team totals and the game_runs histogram for the whole
+// run, and each replication's season wins, runs and (with
+// SeasonConfig::player_lines) per-player lines for one launch at a time; all
+// are integer sums, so they don't depend on launch shape. After each launch
+// the host reads the replications back and folds them through
+// add_replication_lines and a ReplicationFold, as SeasonSimulator::run does.
+// So the results, spreads included, are bit-identical to run()'s for the same
+// config.
+//
+// Covered: PLATE_APPEARANCE mode with starters who pitch the whole game.
+class CudaSeasonSimulator : public SeasonRunner {
+public:
+    // Throws std::invalid_argument for what the device loop doesn't model:
+    // pitch mode, fatigue buckets or a team with a bullpen. Throws
+    // std::runtime_error if no CUDA device can be used.
+    CudaSeasonSimulator(
+        const RosterStore& roster,
+        const std::vector<Team>& teams,
+        std::vector<ScheduledGame> schedule,
+        SimulationMode mode = SimulationMode::PLATE_APPEARANCE,
+        const FatigueModel& fatigue = FatigueModel());
+    ~CudaSeasonSimulator();
+
+    CudaSeasonSimulator(const CudaSeasonSimulator&) = delete;
+    CudaSeasonSimulator& operator=(const CudaSeasonSimulator&) = delete;
+
+    // config.threads is ignored; the device sizes its own launches.
+    SeasonResults run(const SeasonConfig& config) const override;
+
+    // Whether a CUDA device is present, for callers choosing a backend.
+    static bool available();
+
+    std::size_t num_teams() const override { return host_.num_teams(); }
+    const std::vector<ScheduledGame>& schedule() const override { return host_.schedule(); }
+    std::uint64_t fingerprint() const override { return host_.fingerprint(); }
+
+private:
+    struct Device;
+
+    SeasonSimulator host_;  // builds the tables and the empty results
+    std::unique_ptr<Device> device_;
+};
+
+// CudaSeasonSimulator when a device is present and can play this league,
+// otherwise SeasonSimulator; the results are the same either way.
+std::unique_ptr<SeasonRunner> make_season_runner(
+    const RosterStore& roster,
+    const std::vector<Team>& teams,
+    std::vector<ScheduledGame> schedule,
+    SimulationMode mode = SimulationMode::PLATE_APPEARANCE,
+    const FatigueModel& fatigue = FatigueModel());
@@ -0,0 +1,530 @@
+#include "engine/sim/distributed.hpp"
+
+#include "engine/core/socket.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <fcntl.h>
+#include <mutex>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+
+constexpr std::uint32_t kRequestMagic = 0x51524853;   // "SHRQ"
+constexpr std::uint32_t kResponseMagic = 0x53524853;  // "SHRS"
+constexpr std::uint8_t kStatusOk = 0;
+constexpr std::uint8_t kStatusError = 1;
+// Longest error message a worker may send back.
+constexpr std::size_t kMaxErrorBytes = 64 * 1024;
+
+// ---- SeasonResults codec ----
+
+class Writer {
+public:
+    template <typename T>
+    void put(const T& v) {
+        out_.append(reinterpret_cast<const char*>(&v), sizeof(v));
+    }
+
+    void put(const RunningStats& s) {
+        put(s.count());
+        put(s.mean());
+        put(s.m2());
+        put(s.min());
+        put(s.max());
+    }
+
+    void put(const Histogram& h) {
+        put(static_cast<std::uint64_t>(h.bins()));
+        put(h.underflow());
+        put(h.overflow());
+        for (std::size_t b = 0; b < h.bins(); ++b) put(h[b]);
+    }
+
+    void put(const BattingLine& line) {
+        for (std::uint64_t c : line.results) put(c);
+        put(line.runs_batted_in);
+    }
+
+    std::string take() { return std::move(out_); }
+
+private:
+    std::string out_;
+};
+
+class Reader {
+public:
+    explicit Reader(std::string_view in) : in_(in) {}
+
+    template <typename T>
+    T get() {
+        if (in_.size() < sizeof(T)) fail("truncated");
+        T v;
+        std::memcpy(&v, in_.data(), sizeof(T));
+        in_.remove_prefix(sizeof(T));
+        return v;
+    }
+
+    void get(std::uint64_t& v) { v = get<std::uint64_t>(); }
+
+    void get(RunningStats& s) {
+        const auto count = get<std::uint64_t>();
+        const auto mean = get<double>();
+        const auto m2 = get<double>();
+        const auto min = get<double>();
+        const auto max = get<double>();
+        s = RunningStats::from_state(count, mean, m2, min, max);
+    }
+
+    // Into a histogram of the shape's binning, which must match.
+    void get(Histogram& h) {
+        if (get<std::uint64_t>() != h.bins()) fail("histogram bins do not match");
+        h.add_underflow(get<std::uint64_t>());
+        h.add_overflow(get<std::uint64_t>());
+        for (std::size_t b = 0; b < h.bins(); ++b) h.add_to_bin(b, get<std::uint64_t>());
+    }
+
+    void get(BattingLine& line) {
+        for (std::uint64_t& c : line.results) get(c);
+        get(line.runs_batted_in);
+    }
+
+    void expect_size(std::size_t n, const char* what) {
+        if (get<std::uint64_t>() != n) fail(std::string(what) + " count does not match");
+    }
+
+    void finish() const {
+        if (!in_.empty()) fail("trailing bytes");
+    }
+
+private:
+    [[noreturn]] static void fail(const std::string& what) {
+        throw std::runtime_error("season results: " + what);
+    }
+
+    std::string_view in_;
+};
+
+void put_results(Writer& w, const SeasonResults& results) {
+    w.put(static_cast<std::uint64_t>(results.replications));
+    w.put(static_cast<std::uint64_t>(results.teams.size()));
+    for (const TeamSeasonTotals& t : results.teams) {
+        w.put(t.wins);
+        w.put(t.losses);
+        w.put(t.runs_scored);
+        w.put(t.runs_allowed);
+        w.put(t.pitches_thrown);
+        w.put(static_cast<std::uint64_t>(t.win_histogram.size()));
+        for (std::uint64_t c : t.win_histogram) w.put(c);
+        w.put(t.game_runs);
+        w.put(t.season_wins);
+        w.put(t.season_runs_scored);
+    }
+    w.put(static_cast<std::uint64_t>(results.batters.size()));
+    for (const BatterSeasonTotals& b : results.batters) {
+        w.put(b.line);
+        w.put(b.batting_average);
+        w.put(b.on_base_pct);
+        w.put(b.slugging);
+        w.put(b.strikeout_rate);
+        w.put(b.walk_rate);
+    }
+    w.put(static_cast<std::uint64_t>(results.pitchers.size()));
+    for (const PitcherSeasonTotals& p : results.pitchers) {
+        w.put(p.against);
+        w.put(p.games_started);
+        w.put(p.relief_appearances);
+        w.put(p.runs_allowed);
+        w.put(p.strikeout_rate);
+        w.put(p.walk_rate);
+        w.put(p.season_runs_allowed);
+    }
+}
+
+// Into `out`, a copy of the shape.
+void get_results(Reader& r, SeasonResults& out) {
+    out.replications = r.get<std::uint64_t>();
+    r.expect_size(out.teams.size(), "team");
+    for (TeamSeasonTotals& t : out.teams) {
+        r.get(t.wins);
+        r.get(t.losses);
+        r.get(t.runs_scored);
+        r.get(t.runs_allowed);
+        r.get(t.pitches_thrown);
+        r.expect_size(t.win_histogram.size(), "win histogram");
+        for (std::uint64_t& c : t.win_histogram) r.get(c);
+        r.get(t.game_runs);
+        r.get(t.season_wins);
+        r.get(t.season_runs_scored);
+    }
+    r.expect_size(out.batters.size(), "batter");
+    for (BatterSeasonTotals& b : out.batters) {
+        r.get(b.line);
+        r.get(b.batting_average);
+        r.get(b.on_base_pct);
+        r.get(b.slugging);
+        r.get(b.strikeout_rate);
+        r.get(b.walk_rate);
+    }
+    r.expect_size(out.pitchers.size(), "pitcher");
+    for (PitcherSeasonTotals& p : out.pitchers) {
+        r.get(p.against);
+        r.get(p.games_started);
+        r.get(p.relief_appearances);
+        r.get(p.runs_allowed);
+        r.get(p.strikeout_rate);
+        r.get(p.walk_rate);
+        r.get(p.season_runs_allowed);
+    }
+}
+
+// ---- sockets ----
+
+// False on EOF, error or timeout.
+bool recv_all(int fd, void* data, std::size_t n) {
+    char* p = static_cast<char*>(data);
+    while (n > 0) {
+        const ssize_t got = ::recv(fd, p, n, 0);
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) return false;
+        p += got;
+        n -= static_cast<std::size_t>(got);
+    }
+    return true;
+}
+
+template <typename T>
+bool recv_value(int fd, T& v) {
+    return recv_all(fd, &v, sizeof(v));
+}
+
+void set_timeouts(int fd, int timeout_ms) {
+    set_socket_timeouts(fd, timeout_ms);
+    const int one = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+}
+
+// Non-blocking connect bounded by timeout_ms; -1 if no address answered.
+int connect_to(const WorkerAddress& worker, int timeout_ms) {
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* found = nullptr;
+    if (::getaddrinfo(worker.host.c_str(), std::to_string(worker.port).c_str(), &hints, &found) != 0) return -1;
+    int fd = -1;
+    for (addrinfo* a = found; a && fd < 0; a = a->ai_next) {
+        fd = ::socket(a->ai_family, a->ai_socktype, a->ai_protocol);
+        if (fd < 0) continue;
+        const int flags = ::fcntl(fd, F_GETFL, 0);
+        ::fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+        bool ok = ::connect(fd, a->ai_addr, a->ai_addrlen) == 0;
+        if (!ok && errno == EINPROGRESS) {
+            pollfd p{fd, POLLOUT, 0};
+            int error = 0;
+            socklen_t len = sizeof(error);
+            ok = ::poll(&p, 1, timeout_ms) == 1 && ::getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &len) == 0 && error == 0;
+        }
+        if (!ok) {
+            ::close(fd);
+            fd = -1;
+            continue;
+        }
+        ::fcntl(fd, F_SETFL, flags);
+        set_timeouts(fd, timeout_ms);
+    }
+    ::freeaddrinfo(found);
+    return fd;
+}
+
+bool send_unit(int fd, const WorkUnit& unit) {
+    Writer w;
+    w.put(kRequestMagic);
+    w.put(unit.id);
+    w.put(unit.league);
+    w.put(unit.seed);
+    w.put(unit.first_replication);
+    w.put(unit.replications);
+    w.put(static_cast<std::uint8_t>(unit.player_lines));
+    const std::string bytes = w.take();
+    return send_all(fd, bytes.data(), bytes.size());
+}
+
+bool recv_unit(int fd, WorkUnit& unit) {
+    std::uint32_t magic = 0;
+    std::uint8_t player_lines = 0;
+    if (!recv_value(fd, magic) || magic != kRequestMagic || !recv_value(fd, unit.id) || !recv_value(fd, unit.league) ||
+        !recv_value(fd, unit.seed) || !recv_value(fd, unit.first_replication) || !recv_value(fd, unit.replications) ||
+        !recv_value(fd, player_lines)) {
+        return false;
+    }
+    unit.player_lines = player_lines != 0;
+    return true;
+}
+
+bool send_reply(int fd, std::uint8_t status, std::uint64_t id, const std::string& payload) {
+    Writer w;
+    w.put(kResponseMagic);
+    w.put(status);
+    w.put(id);
+    w.put(static_cast<std::uint64_t>(payload.size()));
+    const std::string header = w.take();
+    return send_all(fd, header.data(), header.size()) && send_all(fd, payload.data(), payload.size());
+}
+
+// False as for recv_all, or if the header is not the reply expected or
+// announces more than `max_size` bytes (nothing is allocated for those).
+bool recv_reply(int fd, std::uint64_t expected_id, std::size_t max_size, std::uint8_t& status, std::string& payload) {
+    std::uint32_t magic = 0;
+    std::uint64_t id = 0;
+    std::uint64_t size = 0;
+    if (!recv_value(fd, magic) || magic != kResponseMagic || !recv_value(fd, status) || !recv_value(fd, id) ||
+        id != expected_id || !recv_value(fd, size) || size > max_size) {
+        return false;
+    }
+    payload.resize(size);
+    return recv_all(fd, payload.data(), size);
+}
+
+// Nodes in the canonical tiling of [first, first + count): the largest aligned
+// block at each step, as ReplicationFold leaves a unit. At most 2 per bit.
+std::size_t unit_nodes(std::uint64_t first, std::uint64_t count) {
+    std::size_t nodes = 0;
+    for (const std::uint64_t end = first + count; first < end; ++nodes) {
+        std::uint64_t size = first ? first & (~first + 1) : std::uint64_t{1} << 63;
+        while (size > end - first) size >>= 1;
+        first += size;
+    }
+    return nodes;
+}
+
+// The most an OK reply for `unit` can hold (encode_unit_nodes of its tiling,
+// each node `result_bytes` of results), or an error message's cap if larger.
+std::size_t max_reply_bytes(const WorkUnit& unit, std::size_t result_bytes) {
+    const std::size_t node = sizeof(std::uint64_t) + sizeof(std::uint32_t) + result_bytes;
+    return std::max(kMaxErrorBytes,
+                    sizeof(std::uint64_t) + unit_nodes(unit.first_replication, unit.replications) * node);
+}
+
+}  // namespace
+
+std::string encode_season_results(const SeasonResults& results) {
+    Writer w;
+    put_results(w, results);
+    return w.take();
+}
+
+SeasonResults decode_season_results(std::string_view bytes, const SeasonResults& shape) {
+    SeasonResults out = shape;
+    Reader r(bytes);
+    get_results(r, out);
+    r.finish();
+    return out;
+}
+
+std::string encode_unit_nodes(const std::vector<ReplicationFold::Node>& nodes) {
+    Writer w;
+    w.put(static_cast<std::uint64_t>(nodes.size()));
+    for (const ReplicationFold::Node& node : nodes) {
+        w.put(static_cast<std::uint64_t>(node.first));
+        w.put(static_cast<std::uint32_t>(node.level));
+        put_results(w, node.results);
+    }
+    return w.take();
+}
+
+std::vector<ReplicationFold::Node> decode_unit_nodes(
+    std::string_view bytes, const SeasonResults& shape, const WorkUnit& unit) {
+    Reader r(bytes);
+    const auto count = r.get<std::uint64_t>();
+    if (count > unit_nodes(unit.first_replication, unit.replications)) {
+        throw std::runtime_error("season results: more nodes than the unit can hold");
+    }
+    std::vector<ReplicationFold::Node> nodes(count);
+    std::uint64_t end = unit.first_replication;
+    for (ReplicationFold::Node& node : nodes) {
+        node.first = r.get<std::uint64_t>();
+        node.level = r.get<std::uint32_t>();
+        node.results = shape;
+        get_results(r, node.results);
+        const std::uint64_t size = node.level < 64 ? std::uint64_t{1} << node.level : 0;
+        if (node.first != end || size == 0 || node.first % size != 0 || node.results.replications != size) {
+            throw std::runtime_error("season results: nodes do not tile the unit");
+        }
+        end += node.results.replications;
+    }
+    r.finish();
+    if (end != unit.first_replication + unit.replications) {
+        throw std::runtime_error("season results: nodes do not cover the unit");
+    }
+    return nodes;
+}
+
+ShardWorker::ShardWorker(const SeasonSimulator& sim, std::size_t threads)
+    : sim_(sim),
+      league_(sim.fingerprint()),
+      pool_(threads),
+      scratch_(new Arena[pool_.size()]),
+      listener_("shard worker") {}
+
+ShardWorker::~ShardWorker() = default;
+
+std::uint16_t ShardWorker::listen(std::uint16_t port, const std::string& address) {
+    return listener_.listen(port, address, 16);
+}
+
+void ShardWorker::serve() {
+    listener_.serve([this](int fd) { serve_connection(fd); });
+}
+
+void ShardWorker::stop() {
+    listener_.stop();
+}
+
+void ShardWorker::serve_connection(int fd) {
+    WorkUnit unit;
+    while (!listener_.stopping() && recv_unit(fd, unit)) {
+        std::string payload;
+        std::uint8_t status = kStatusOk;
+        try {
+            payload = encode_unit_nodes(run_unit(unit));
+        } catch (const std::exception& e) {
+            status = kStatusError;
+            payload = e.what();
+        }
+        if (!send_reply(fd, status, unit.id, payload)) return;
+    }
+}
+
+std::vector<ReplicationFold::Node> ShardWorker::run_unit(const WorkUnit& unit) {
+    if (unit.league != league_) {
+        throw std::invalid_argument("work unit is for a different league (fingerprint mismatch)");
+    }
+    const SeasonResults shape = sim_.empty_results();
+    ReplicationFold fold(unit.first_replication);
+    fold_replications(pool_, unit.replications, &fold, 1, [&](std::size_t worker, std::size_t rep, ReplicationFold* chunk) {
+        SeasonResults results = chunk->fresh(shape);
+        sim_.simulate_replication(unit.seed, rep, results, nullptr, &scratch_[worker], unit.player_lines);
+        chunk->push({rep, 0, std::move(results)});
+    });
+    return fold.release();
+}
+
+ShardCoordinator::ShardCoordinator(std::vector<WorkerAddress> workers, ShardOptions options)
+    : workers_(std::move(workers)), options_(options) {
+    if (options_.replications_per_unit == 0 || options_.max_attempts == 0) {
+        throw std::invalid_argument("ShardCoordinator: units and attempts must be positive");
+    }
+}
+
+SeasonResults ShardCoordinator::run(const SeasonSimulator& sim, const SeasonConfig& config) {
+    const std::size_t per_unit = options_.replications_per_unit;
+    const std::uint64_t league = sim.fingerprint();
+    const SeasonResults shape = sim.empty_results();
+    const std::size_t result_bytes = encode_season_results(shape).size();
+    const std::size_t num_units = (config.replications + per_unit - 1) / per_unit;
+    stats_ = ShardRunStats();
+    stats_.units = num_units;
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::deque<std::size_t> queue;
+    for (std::size_t u = 0; u < num_units; ++u) queue.push_back(u);
+    std::vector<std::size_t> failures(num_units, 0);
+    std::vector<std::vector<ReplicationFold::Node>> done(num_units);
+    std::size_t remaining = num_units;
+    std::size_t alive = workers_.size();
+    std::string failure;
+
+    // Called with the lock held when a worker drops, holding `unit` (or none).
+    auto lose = [&](const WorkerAddress& worker, std::size_t unit, bool holding) {
+        ++stats_.workers_lost;
+        --alive;
+        if (holding) {
+            if (++failures[unit] >= options_.max_attempts) {
+                failure = "shard run: unit " + std::to_string(unit) + " failed " + std::to_string(failures[unit]) +
+                          " times (last on " + worker.host + ":" + std::to_string(worker.port) + ")";
+            } else {
+                queue.push_front(unit);
+                ++stats_.reissued;
+            }
+        }
+        if (alive == 0 && remaining > 0 && failure.empty()) {
+            failure = "shard run: every worker lost with " + std::to_string(remaining) + " units left";
+        }
+        changed.notify_all();
+    };
+
+    auto drive = [&](const WorkerAddress& worker) {
+        const int fd = connect_to(worker, options_.timeout_ms);
+        if (fd < 0) {
+            std::lock_guard<std::mutex> lock(mutex);
+            lose(worker, 0, false);
+            return;
+        }
+        std::string payload;
+        while (true) {
+            std::size_t u;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                changed.wait(lock, [&] { return !queue.empty() || remaining == 0 || !failure.empty(); });
+                if (remaining == 0 || !failure.empty()) break;
+                u = queue.front();
+                queue.pop_front();
+            }
+            WorkUnit unit;
+            unit.id = u;
+            unit.league = league;
+            unit.seed = config.seed;
+            unit.first_replication = u * per_unit;
+            unit.replications = std::min(per_unit, config.replications - u * per_unit);
+            unit.player_lines = config.player_lines;
+            std::uint8_t status = kStatusError;
+            if (!send_unit(fd, unit) || !recv_reply(fd, unit.id, max_reply_bytes(unit, result_bytes), status, payload)) {
+                std::lock_guard<std::mutex> lock(mutex);
+                lose(worker, u, true);
+                break;
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            if (status != kStatusOk) {
+                failure = "shard run: " + worker.host + ":" + std::to_string(worker.port) + " refused unit " +
+                          std::to_string(u) + ": " + payload;
+                changed.notify_all();
+                break;
+            }
+            // A reply that doesn't decode is a broken or version-skewed worker: drop it.
+            try {
+                done[u] = decode_unit_nodes(payload, shape, unit);
+            } catch (const std::exception&) {
+                lose(worker, u, true);
+                break;
+            }
+            --remaining;
+            changed.notify_all();
+        }
+        ::close(fd);
+    };
+
+    if (num_units > 0 && workers_.empty()) throw std::runtime_error("shard run: no workers");
+    std::vector<std::thread> threads;
+    threads.reserve(workers_.size());
+    for (const WorkerAddress& w : workers_) threads.emplace_back(drive, std::cref(w));
+    for (std::thread& t : threads) t.join();
+    if (!failure.empty()) throw std::runtime_error(failure);
+
+    // Unit order, whichever worker finished first, into the tree run() builds.
+    ReplicationFold fold;
+    for (std::vector<ReplicationFold::Node>& nodes : done) {
+        for (ReplicationFold::Node& node : nodes) fold.push(std::move(node));
+    }
+    return fold.result(shape);
+}
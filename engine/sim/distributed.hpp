@@ -0,0 +1,123 @@
+#pragma once
+
+#include "engine/core/socket.hpp"
+#include "engine/core/thread_pool.hpp"
+#include "engine/sim/season_simulator.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Season runs sharded across processes and hosts.
+//
+// A ShardCoordinator cuts [0, replications) into fixed-size work units and
+// hands them to ShardWorkers over TCP. A worker plays its unit with
+// SeasonSimulator::simulate_replication and sends back only the unit's
+// ReplicationFold nodes, never event logs. Workers keep nothing between units,
+// so a unit whose worker drops or times out is just issued again to another
+// one. Each replication's streams depend only on (seed, replication), and the
+// coordinator pushes every unit's nodes, in unit order, into the same fold
+// SeasonSimulator::run builds. So the results, spreads included, are
+// bit-identical to run()'s however the units are sized and wherever they ran.
+//
+// Every host builds the same SeasonSimulator from the same inputs. Its
+// fingerprint() travels with each unit, and a worker refuses units built for
+// another league. The wire format is native byte order, so every host must
+// share an architecture.
+
+struct WorkUnit {
+    std::uint64_t id = 0;
+    std::uint64_t league = 0;  // SeasonSimulator::fingerprint()
+    std::uint64_t seed = 0;
+    std::uint64_t first_replication = 0;
+    std::uint64_t replications = 0;
+    bool player_lines = true;  // SeasonConfig::player_lines
+};
+
+// SeasonResults on the wire. Decoding needs a `shape` (empty_results() of the
+// same simulator) for the sizes and histogram bins; throws std::runtime_error
+// if the bytes do not fit it.
+std::string encode_season_results(const SeasonResults& results);
+SeasonResults decode_season_results(std::string_view bytes, const SeasonResults& shape);
+
+// A unit's reply: its fold nodes, each with its SeasonResults. Decoding also
+// throws std::runtime_error unless the nodes tile exactly the unit's
+// replications, checking the node count before allocating for it.
+std::string encode_unit_nodes(const std::vector<ReplicationFold::Node>& nodes);
+std::vector<ReplicationFold::Node> decode_unit_nodes(
+    std::string_view bytes, const SeasonResults& shape, const WorkUnit& unit);
+
+// Plays work units for coordinators. serve() takes one connection at a time
+// and answers its units in order until the peer hangs up.
+class ShardWorker {
+public:
+    explicit ShardWorker(const SeasonSimulator& sim, std::size_t threads = 0);
+    ~ShardWorker();
+
+    ShardWorker(const ShardWorker&) = delete;
+    ShardWorker& operator=(const ShardWorker&) = delete;
+
+    // Binds and listens; port 0 picks a free one. Returns the bound port.
+    // Throws std::runtime_error if the socket can't be set up.
+    std::uint16_t listen(std::uint16_t port, const std::string& address = "0.0.0.0");
+
+    // Accepts coordinators until stop() (callable from any thread).
+    void serve();
+    void stop();
+
+    // What serve() computes for one unit, without the network: the unit's
+    // pending fold nodes, in replication order. Throws std::invalid_argument
+    // for a unit from another league.
+    std::vector<ReplicationFold::Node> run_unit(const WorkUnit& unit);
+
+private:
+    void serve_connection(int fd);
+
+    const SeasonSimulator& sim_;
+    std::uint64_t league_;  // sim_.fingerprint()
+    WorkStealingPool pool_;
+    std::unique_ptr<Arena[]> scratch_;
+    TcpListener listener_;
+};
+
+struct WorkerAddress {
+    std::string host;
+    std::uint16_t port;
+};
+
+struct ShardOptions {
+    std::size_t replications_per_unit = 64;
+    int timeout_ms = 60000;        // connect, and each unit's round trip
+    std::size_t max_attempts = 3;  // issues per unit before the run fails
+};
+
+struct ShardRunStats {
+    std::size_t units = 0;
+    std::size_t reissued = 0;      // units sent again after a worker was lost
+    std::size_t workers_lost = 0;
+};
+
+// Hands out units to every worker at once (one connection each) and merges the
+// results. A worker that fails to connect, errors, times out or sends a reply
+// that is oversized or doesn't decode is dropped for the rest of the run and
+// its unit goes back in the queue. Throws
+// std::runtime_error if every worker is lost, a unit fails max_attempts times,
+// or a worker refuses a unit (e.g. a league mismatch).
+class ShardCoordinator {
+public:
+    explicit ShardCoordinator(std::vector<WorkerAddress> workers, ShardOptions options = ShardOptions());
+
+    // `sim` is the coordinator's own copy of the league: it supplies the
+    // fingerprint and the result shape and plays nothing itself.
+    SeasonResults run(const SeasonSimulator& sim, const SeasonConfig& config);
+
+    const ShardRunStats& last_run() const { return stats_; }
+
+private:
+    std::vector<WorkerAddress> workers_;
+    ShardOptions options_;
+    ShardRunStats stats_;
+};
@@ -0,0 +1,181 @@
+#include "engine/sim/event_log.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr char kMagic[8] = {'3', 'U', '3', 'D', 'E', 'V', 'N', 'T'};
+constexpr std::uint32_t kVersion = 1;
+// Keeps records 32-byte aligned in the mapped file.
+constexpr std::size_t kHeaderSize = 64;
+
+struct EventLogHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t record_size;
+};
+
+static_assert(sizeof(EventLogHeader) <= kHeaderSize, "event log header must fit in its reserved block");
+
+[[noreturn]] void fail(const std::string& path, const std::string& what) {
+    throw std::runtime_error("event log " + path + ": " + what);
+}
+
+std::string check_header(const EventLogHeader& h) {
+    if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0) return "not an event log";
+    if (h.version != kVersion) return "unsupported version";
+    if (h.record_size != sizeof(PlateAppearanceEvent)) return "unexpected record size";
+    return {};
+}
+
+}  // namespace
+
+EventLog::EventLog(const std::string& path) : path_(path) {
+    fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+    if (fd_ < 0) fail(path, "cannot open");
+    struct stat st;
+    if (::fstat(fd_, &st) != 0) {
+        ::close(fd_);
+        fail(path, "cannot stat");
+    }
+    const auto size = static_cast<std::size_t>(st.st_size);
+    std::string error;
+    if (size == 0) {
+        char header[kHeaderSize] = {};
+        const EventLogHeader h{{kMagic[0], kMagic[1], kMagic[2], kMagic[3], kMagic[4], kMagic[5], kMagic[6], kMagic[7]},
+                               kVersion, static_cast<std::uint32_t>(sizeof(PlateAppearanceEvent))};
+        std::memcpy(header, &h, sizeof(h));
+        if (::write(fd_, header, sizeof(header)) != static_cast<ssize_t>(sizeof(header))) error = "cannot write header";
+    } else if (size < kHeaderSize) {
+        error = "truncated header";
+    } else {
+        EventLogHeader h;
+        if (::pread(fd_, &h, sizeof(h), 0) != static_cast<ssize_t>(sizeof(h))) {
+            error = "cannot read header";
+        } else {
+            error = check_header(h);
+        }
+        if (error.empty() && (size - kHeaderSize) % sizeof(PlateAppearanceEvent) != 0) error = "ends in a partial record";
+    }
+    if (!error.empty()) {
+        ::close(fd_);
+        fail(path, error);
+    }
+}
+
+EventLog::~EventLog() {
+    if (fd_ >= 0) ::close(fd_);
+}
+
+EventLogWriter EventLog::writer(std::size_t buffer_events) {
+    return EventLogWriter(*this, buffer_events);
+}
+
+void EventLog::write_block(const PlateAppearanceEvent* events, std::size_t count) {
+    const char* bytes = reinterpret_cast<const char*>(events);
+    std::size_t left = count * sizeof(PlateAppearanceEvent);
+    std::lock_guard<std::mutex> lock(mutex_);
+    while (left > 0) {
+        const ssize_t n = ::write(fd_, bytes, left);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            fail(path_, "write failed");
+        }
+        bytes += n;
+        left -= static_cast<std::size_t>(n);
+    }
+}
+
+EventLogWriter::EventLogWriter(EventLog& log, std::size_t buffer_events)
+    : log_(&log), buffer_(buffer_events ? buffer_events : 1) {}
+
+EventLogWriter::EventLogWriter(EventLogWriter&& other) noexcept
+    : log_(std::exchange(other.log_, nullptr)),
+      buffer_(std::move(other.buffer_)),
+      size_(std::exchange(other.size_, 0)) {}
+
+EventLogWriter& EventLogWriter::operator=(EventLogWriter&& other) noexcept {
+    if (this != &other) {
+        try {
+            flush();
+        } catch (...) {
+        }
+        log_ = std::exchange(other.log_, nullptr);
+        buffer_ = std::move(other.buffer_);
+        size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+}
+
+EventLogWriter::~EventLogWriter() {
+    try {
+        flush();
+    } catch (...) {
+    }
+}
+
+void EventLogWriter::flush() {
+    if (!log_ || size_ == 0) return;
+    const std::size_t count = std::exchange(size_, 0);
+    log_->write_block(buffer_.data(), count);
+}
+
+EventLogReader EventLogReader::open(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) fail(path, "cannot open");
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        fail(path, "cannot stat");
+    }
+    const auto size = static_cast<std::size_t>(st.st_size);
+    if (size < kHeaderSize) {
+        ::close(fd);
+        fail(path, "truncated header");
+    }
+    void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) fail(path, "mmap failed");
+
+    EventLogReader reader;
+    reader.mapping_ = mapping;
+    reader.mapping_size_ = size;
+
+    EventLogHeader h;
+    std::memcpy(&h, mapping, sizeof(h));
+    const std::string error = check_header(h);
+    if (!error.empty()) fail(path, error);
+
+    reader.events_ = reinterpret_cast<const PlateAppearanceEvent*>(static_cast<const char*>(mapping) + kHeaderSize);
+    reader.size_ = (size - kHeaderSize) / sizeof(PlateAppearanceEvent);
+    return reader;
+}
+
+EventLogReader::EventLogReader(EventLogReader&& other) noexcept
+    : mapping_(std::exchange(other.mapping_, nullptr)),
+      mapping_size_(std::exchange(other.mapping_size_, 0)),
+      events_(std::exchange(other.events_, nullptr)),
+      size_(std::exchange(other.size_, 0)) {}
+
+EventLogReader& EventLogReader::operator=(EventLogReader&& other) noexcept {
+    if (this != &other) {
+        if (mapping_) ::munmap(mapping_, mapping_size_);
+        mapping_ = std::exchange(other.mapping_, nullptr);
+        mapping_size_ = std::exchange(other.mapping_size_, 0);
+        events_ = std::exchange(other.events_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+}
+
+EventLogReader::~EventLogReader() {
+    if (mapping_) ::munmap(mapping_, mapping_size_);
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// One plate appearance as it lands on disk: fixed width, little-endian, no
+// framing, so a mapped file is just an array of these after the header. Read by
+// EventLogReader and baseball_stats/event_log.py.
+struct PlateAppearanceEvent {
+    std::uint64_t game_id;
+    std::uint64_t state;     // GameState::raw() before the PA
+    std::uint32_t batter;    // PlayerId
+    std::uint32_t pitcher;   // PlayerId
+    std::uint16_t pa_index;  // 0-based within the game
+    std::uint8_t result;     // PlateAppearanceResult
+    std::uint8_t runs;       // scored on the play
+    std::uint32_t reserved;
+};
+
+static_assert(sizeof(PlateAppearanceEvent) == 32, "event records are 32 bytes on disk");
+static_assert(std::is_trivially_copyable<PlateAppearanceEvent>::value, "events are written as raw bytes");
+
+class EventLogWriter;
+
+// Append-only event file. Any number of EventLogWriters (one per thread) buffer
+// events and hand them over in large blocks, each written with one locked write(),
+// so blocks from different threads interleave but records never tear.
+class EventLog {
+public:
+    // Opens `path` for appending, writing the header if the file is new. Throws
+    // std::runtime_error if it can't be opened or holds something else.
+    explicit EventLog(const std::string& path);
+    ~EventLog();
+
+    EventLog(const EventLog&) = delete;
+    EventLog& operator=(const EventLog&) = delete;
+
+    static constexpr std::size_t kDefaultBufferEvents = 1 << 15;  // 1 MiB blocks
+
+    EventLogWriter writer(std::size_t buffer_events = kDefaultBufferEvents);
+
+    const std::string& path() const { return path_; }
+
+private:
+    friend class EventLogWriter;
+
+    void write_block(const PlateAppearanceEvent* events, std::size_t count);
+
+    std::string path_;
+    int fd_ = -1;
+    std::mutex mutex_;
+};
+
+// One thread's buffer. Not thread-safe; flushes when full, on flush() and on
+// destruction (errors there are swallowed, so call flush() to see them).
+class EventLogWriter {
+public:
+    EventLogWriter(EventLogWriter&& other) noexcept;
+    EventLogWriter& operator=(EventLogWriter&& other) noexcept;
+    EventLogWriter(const EventLogWriter&) = delete;
+    EventLogWriter& operator=(const EventLogWriter&) = delete;
+    ~EventLogWriter();
+
+    void append(const PlateAppearanceEvent& event) {
+        buffer_[size_++] = event;
+        if (size_ == buffer_.size()) flush();
+    }
+
+    void flush();
+
+private:
+    friend class EventLog;
+    EventLogWriter(EventLog& log, std::size_t buffer_events);
+
+    EventLog* log_;
+    std::vector<PlateAppearanceEvent> buffer_;
+    std::size_t size_ = 0;
+};
+
+// Read-only view of an event file with one mmap; iterating is pointer walking.
+// A trailing partial record (a writer mid-block) is ignored.
+class EventLogReader {
+public:
+    // Throws std::runtime_error if the file is missing or not an event log.
+    static EventLogReader open(const std::string& path);
+
+    EventLogReader(EventLogReader&& other) noexcept;
+    EventLogReader& operator=(EventLogReader&& other) noexcept;
+    EventLogReader(const EventLogReader&) = delete;
+    EventLogReader& operator=(const EventLogReader&) = delete;
+    ~EventLogReader();
+
+    std::size_t size() const { return size_; }
+    const PlateAppearanceEvent& operator[](std::size_t i) const { return events_[i]; }
+    const PlateAppearanceEvent* begin() const { return events_; }
+    const PlateAppearanceEvent* end() const { return events_ + size_; }
+
+private:
+    EventLogReader() = default;
+
+    void* mapping_ = nullptr;
+    std::size_t mapping_size_ = 0;
+    const PlateAppearanceEvent* events_ = nullptr;
+    std::size_t size_ = 0;
+};
@@ -0,0 +1,329 @@
+#include "engine/sim/game.hpp"
+
+#include "engine/core/instrument.hpp"
+
+#include <type_traits>
+
+namespace {
+
+// Per-PA hooks for the game loops; the default records nothing and inlines away.
+// `pitcher` is the table row of whoever was on the mound.
+struct NoEvents {
+    void operator()(const GameState&, const GameState&, PlateAppearanceResult, std::uint32_t) {}
+};
+
+struct ObserveEvents {
+    const GameLineup& home;
+    const GameLineup& away;
+    const GameEventTarget& target;
+    std::uint16_t pa_index = 0;
+
+    void operator()(const GameState& before, const GameState& after, PlateAppearanceResult result, std::uint32_t pitcher) {
+        const bool bottom = before.bottom();
+        const std::size_t slot = before.batting_slot();
+        const int runs = after.home_score() + after.away_score() - before.home_score() - before.away_score();
+        if (target.lines) {
+            BattingLine& batter = *target.lines->batters[bottom][slot];
+            BattingLine& against = target.lines->pitchers[pitcher];
+            ++batter.results[static_cast<std::size_t>(result)];
+            ++against.results[static_cast<std::size_t>(result)];
+            batter.runs_batted_in += runs;
+            against.runs_batted_in += runs;
+        }
+        if (!target.writer) return;
+        const std::uint32_t batter = (bottom ? home : away).batters[slot];
+        PlateAppearanceEvent event{};
+        event.game_id = target.game_id;
+        event.state = before.raw();
+        event.batter = target.batter_ids[batter];
+        event.pitcher = target.pitcher_ids[pitcher];
+        event.pa_index = pa_index++;
+        event.result = static_cast<std::uint8_t>(result);
+        event.runs = static_cast<std::uint8_t>(runs);
+        target.writer->append(event);
+    }
+};
+
+// Who is pitching for each side and how tired they are. Indexed like the half
+// being pitched to: [0] is the home staff (top halves). Only games with fatigue
+// buckets or a bullpen use this; the rest play with Starters.
+template <typename Table>
+class Staffs {
+public:
+    Staffs(const Table& table, const GameLineup& home, const GameLineup& away, bool pitch_mode)
+        : table_(table), lineups_{&home, &away} {
+        const bool by_pitch = table.fatigue().unit == FatigueUnit::PITCHES;
+        per_pa_ = by_pitch ? (pitch_mode ? 0 : kPitchesPerPlateAppearance) : 1;
+        per_pitch_ = by_pitch && pitch_mode ? 1 : 0;
+        for (int side = 0; side < 2; ++side) take_mound(mounds_[side], lineups_[side]->pitcher);
+    }
+
+    std::uint32_t pitcher(bool bottom) const { return mounds_[bottom].pitcher; }
+    unsigned bucket(bool bottom) const { return mounds_[bottom].bucket; }
+    int relievers(int side) const { return mounds_[side].relievers_used; }
+
+    // Between batters: the manager's one decision.
+    void before_batter(bool bottom, int inning) {
+        Mound& m = mounds_[bottom];
+        const GameLineup& staff = *lineups_[bottom];
+        if (m.relievers_used < staff.bullpen_size && staff.policy.should_pull(m.bucket, inning)) {
+            const std::uint8_t used = m.relievers_used + 1;
+            take_mound(m, staff.bullpen[m.relievers_used]);
+            m.relievers_used = used;
+        }
+    }
+
+    void after_pitch(bool bottom) { add_work(bottom, per_pitch_); }
+    void after_batter(bool bottom) { add_work(bottom, per_pa_); }
+
+private:
+    struct Mound {
+        std::uint32_t pitcher;
+        std::uint16_t workload;
+        std::uint16_t next_bucket_at;
+        std::uint8_t bucket;
+        std::uint8_t relievers_used = 0;
+    };
+
+    void take_mound(Mound& m, std::uint32_t pitcher) {
+        m.pitcher = pitcher;
+        m.workload = 0;
+        m.bucket = 0;
+        m.next_bucket_at = table_.fatigue_schedule(pitcher).starts[1];
+    }
+
+    void add_work(bool bottom, unsigned n) {
+        if (n == 0) return;
+        Mound& m = mounds_[bottom];
+        m.workload = static_cast<std::uint16_t>(m.workload + n);
+        // Unused buckets start at kNeverTired, so this stops at the last real one.
+        while (m.workload >= m.next_bucket_at) {
+            ++m.bucket;
+            m.next_bucket_at = table_.fatigue_schedule(m.pitcher).starts[m.bucket + 1];
+        }
+    }
+
+    const Table& table_;
+    const GameLineup* lineups_[2];
+    unsigned per_pa_;
+    unsigned per_pitch_;
+    Mound mounds_[2];
+};
+
+// Staffs' interface for games where starters go the distance, fresh: every
+// call is a constant or a no-op, so the loop keeps none of the bookkeeping.
+template <typename Table>
+class Starters {
+public:
+    Starters(const Table&, const GameLineup& home, const GameLineup& away, bool) : pitchers_{home.pitcher, away.pitcher} {}
+
+    std::uint32_t pitcher(bool bottom) const { return pitchers_[bottom]; }
+    static constexpr unsigned bucket(bool) { return 0; }
+    static constexpr int relievers(int) { return 0; }
+
+    void before_batter(bool, int) {}
+    void after_pitch(bool) {}
+    void after_batter(bool) {}
+
+private:
+    std::uint32_t pitchers_[2];
+};
+
+// Compile-time feature set of one game loop. The outcome source is the table
+// type (MatchupTable: one alias draw per PA; CubeOutcomeTable: one alias draw
+// from the PA's context row; PitchMatchupTable: pitch by pitch) and kFatigue
+// brings in fatigue buckets and the bullpen. Logging is the OnPlay hook
+// (NoEvents compiles away). Every combination is its own straight-line loop;
+// simulate_game picks one per game, outside the loop.
+template <typename Table, bool Fatigue>
+struct GameFeatures {
+    using OutcomeTable = Table;
+    static constexpr bool kPitchLevel = std::is_same_v<Table, PitchMatchupTable>;
+    static constexpr bool kFatigue = Fatigue;
+    using Mounds = std::conditional_t<Fatigue, Staffs<Table>, Starters<Table>>;
+};
+
+// The PA-level draws: by pair (and fatigue bucket), or by pair and game state.
+PlateAppearanceResult draw_outcome(
+    const MatchupTable& table, std::uint32_t batter, std::uint32_t pitcher, unsigned bucket, const GameState&, float u) {
+    return sample_outcome(table.alias_at(batter, pitcher, bucket), u);
+}
+
+PlateAppearanceResult draw_outcome(
+    const CubeOutcomeTable& table, std::uint32_t batter, std::uint32_t pitcher, unsigned, const GameState& state,
+    float u) {
+    return sample_outcome(table.alias_at(batter, pitcher, state), u);
+}
+
+// One pitch from `pitcher` (in fatigue bucket `bucket`); returns the
+// PlateAppearanceResult it ended the PA with, or -1.
+int throw_pitch(
+    const PitchMatchupTable& table, const GameLineup& home, const GameLineup& away, std::uint32_t pitcher,
+    unsigned bucket, GameState& state, RNG& rng) {
+    const GameLineup& batting = state.bottom() ? home : away;
+    const unsigned count = state.count_id();
+    THREEUP3DOWN_COUNT(TABLE_LOOKUPS);
+    const PitchResult pitch = static_cast<PitchResult>(
+        table.alias_at(batting.batters[state.batting_slot()], pitcher, count, bucket).sample(rng.uniform()));
+    const CountTransition t = kCountTransitions[count][static_cast<std::size_t>(pitch)];
+    if (t.result < 0) {
+        state.set_count_id(t.next_count);
+    } else {
+        state.apply(static_cast<PlateAppearanceResult>(t.result));
+    }
+    return t.result;
+}
+
+template <typename Features, typename OnPlay>
+GameResult play_game(
+    const typename Features::OutcomeTable& table, const GameLineup& home, const GameLineup& away, RNG& rng,
+    OnPlay&& on_play) {
+    THREEUP3DOWN_SCOPE("game");
+    GameState state;
+    typename Features::Mounds staffs(table, home, away, Features::kPitchLevel);
+    if constexpr (Features::kPitchLevel) staffs.before_batter(false, state.inning());
+    GameState pa_start = state;
+    int pas = 0;
+    int pitches[2] = {0, 0};  // [0] = thrown by the home staff (top halves); pitch level only
+    while (!state.final()) {
+        THREEUP3DOWN_SCOPE("half_inning");
+        const bool bottom = state.bottom();
+        const GameLineup& batting = bottom ? home : away;
+        do {
+            if constexpr (Features::kPitchLevel) {
+                const std::uint32_t pitcher = staffs.pitcher(bottom);
+                ++pitches[bottom];
+                const int result = throw_pitch(table, home, away, pitcher, staffs.bucket(bottom), state, rng);
+                staffs.after_pitch(bottom);
+                if (result >= 0) {
+                    THREEUP3DOWN_COUNT(PLATE_APPEARANCES);
+                    ++pas;
+                    staffs.after_batter(bottom);
+                    on_play(pa_start, state, static_cast<PlateAppearanceResult>(result), pitcher);
+                    pa_start = state;
+                    // Not after the last PA: a change then would be a reliever who never pitches.
+                    if (!state.final()) staffs.before_batter(state.bottom(), state.inning());
+                }
+            } else {
+                THREEUP3DOWN_SCOPE("plate_appearance");
+                THREEUP3DOWN_COUNT(PLATE_APPEARANCES);
+                THREEUP3DOWN_COUNT(TABLE_LOOKUPS);
+                staffs.before_batter(bottom, state.inning());
+                const std::uint32_t pitcher = staffs.pitcher(bottom);
+                const GameState before = state;
+                const PlateAppearanceResult result = draw_outcome(
+                    table, batting.batters[state.batting_slot()], pitcher, staffs.bucket(bottom), state, rng.uniform());
+                state.apply(result);
+                staffs.after_batter(bottom);
+                on_play(before, state, result, pitcher);
+                ++pas;
+            }
+        } while (!state.final() && state.bottom() == bottom);
+    }
+    return {state.home_score(), state.away_score(), state.inning(), pas, pitches[0], pitches[1],
+            staffs.relievers(0), staffs.relievers(1)};
+}
+
+// Fatigue buckets or a bullpen to call on need the full staff loop; otherwise
+// the starters pitch it all and the game runs the lean one. Same draws either way.
+template <typename Table, typename OnPlay>
+GameResult play_game(const Table& table, const GameLineup& home, const GameLineup& away, RNG& rng, OnPlay&& on_play) {
+    if (table.fatigue_buckets() > 1 || home.bullpen_size > 0 || away.bullpen_size > 0) {
+        return play_game<GameFeatures<Table, true>>(table, home, away, rng, on_play);
+    }
+    return play_game<GameFeatures<Table, false>>(table, home, away, rng, on_play);
+}
+
+}  // namespace
+
+std::uint64_t BattingLine::plate_appearances() const {
+    std::uint64_t n = 0;
+    for (std::uint64_t c : results) n += c;
+    return n;
+}
+
+std::uint64_t BattingLine::hits() const {
+    return count(PlateAppearanceResult::SINGLE) + count(PlateAppearanceResult::DOUBLE) +
+           count(PlateAppearanceResult::TRIPLE) + count(PlateAppearanceResult::HOMERUN);
+}
+
+std::uint64_t BattingLine::total_bases() const {
+    return count(PlateAppearanceResult::SINGLE) + 2 * count(PlateAppearanceResult::DOUBLE) +
+           3 * count(PlateAppearanceResult::TRIPLE) + 4 * count(PlateAppearanceResult::HOMERUN);
+}
+
+void BattingLine::merge(const BattingLine& other) {
+    for (std::size_t r = 0; r < kNumPlateAppearanceResults; ++r) results[r] += other.results[r];
+    runs_batted_in += other.runs_batted_in;
+}
+
+HalfInningResult simulate_half_inning(
+    const MatchupTable& table,
+    const GameLineup& batting,
+    std::uint32_t pitcher,
+    std::size_t& slot,
+    int max_runs,
+    RNG& rng) {
+    unsigned base_out = 0;
+    int runs = 0;
+    int pas = 0;
+    while (base_out_outs(base_out) < 3 && (max_runs < 0 || runs <= max_runs)) {
+        ++pas;
+        THREEUP3DOWN_COUNT(PLATE_APPEARANCES);
+        THREEUP3DOWN_COUNT(TABLE_LOOKUPS);
+        const PlateAppearanceResult result = sample_outcome(table.alias_at(batting.batters[slot], pitcher), rng.uniform());
+        slot = slot + 1 == kLineupSize ? 0 : slot + 1;
+        const BaseOutTransition t = kBaseOutTransitions[base_out][static_cast<std::size_t>(result)];
+        base_out = t.next;
+        runs += t.runs;
+    }
+    return {runs, pas};
+}
+
+PlateAppearanceResult play_plate_appearance(
+    const MatchupTable& table, const GameLineup& home, const GameLineup& away, GameState& state, RNG& rng) {
+    const bool bottom = state.bottom();
+    const GameLineup& batting = bottom ? home : away;
+    const std::uint32_t pitcher = bottom ? away.pitcher : home.pitcher;
+    THREEUP3DOWN_COUNT(PLATE_APPEARANCES);
+    THREEUP3DOWN_COUNT(TABLE_LOOKUPS);
+    const PlateAppearanceResult result =
+        sample_outcome(table.alias_at(batting.batters[state.batting_slot()], pitcher), rng.uniform());
+    state.apply(result);
+    return result;
+}
+
+GameResult simulate_game(const MatchupTable& table, const GameLineup& home, const GameLineup& away, RNG& rng) {
+    return play_game(table, home, away, rng, NoEvents{});
+}
+
+GameResult simulate_game(
+    const MatchupTable& table, const GameLineup& home, const GameLineup& away, RNG& rng, const GameEventTarget& events) {
+    return play_game(table, home, away, rng, ObserveEvents{home, away, events});
+}
+
+GameResult simulate_game(const CubeOutcomeTable& table, const GameLineup& home, const GameLineup& away, RNG& rng) {
+    return play_game(table, home, away, rng, NoEvents{});
+}
+
+GameResult simulate_game(
+    const CubeOutcomeTable& table, const GameLineup& home, const GameLineup& away, RNG& rng,
+    const GameEventTarget& events) {
+    return play_game(table, home, away, rng, ObserveEvents{home, away, events});
+}
+
+bool play_pitch(
+    const PitchMatchupTable& table, const GameLineup& home, const GameLineup& away, GameState& state, RNG& rng) {
+    const std::uint32_t pitcher = state.bottom() ? away.pitcher : home.pitcher;
+    return throw_pitch(table, home, away, pitcher, 0, state, rng) >= 0;
+}
+
+GameResult simulate_game(const PitchMatchupTable& table, const GameLineup& home, const GameLineup& away, RNG& rng) {
+    return play_game(table, home, away, rng, NoEvents{});
+}
+
+GameResult simulate_game(
+    const PitchMatchupTable& table, const GameLineup& home, const GameLineup& away, RNG& rng,
+    const GameEventTarget& events) {
+    return play_game(table, home, away, rng, ObserveEvents{home, away, events});
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "engine/core/rng.hpp"
+#include "engine/model/team.hpp"
+#include "engine/sim/cube_outcome_table.hpp"
+#include "engine/sim/event_log.hpp"
+#include "engine/sim/game_state.hpp"
+#include "engine/sim/matchup_table.hpp"
+#include "engine/sim/pitch_matchup_table.hpp"
+
+#include <array>
+#include <cstdint>
+
+constexpr std::size_t kMaxBullpen = 8;
+
+// One side of a game, as rows of a shared MatchupTable (resolved from PlayerIds at setup).
+// `pitcher` starts; relievers come in from `bullpen` as `policy` calls for them.
+struct GameLineup {
+    std::array<std::uint32_t, kLineupSize> batters;
+    std::uint32_t pitcher;
+    std::array<std::uint32_t, kMaxBullpen> bullpen{};
+    std::uint8_t bullpen_size = 0;
+    BullpenPolicy policy;
+};
+
+struct HalfInningResult {
+    int runs;
+    int plate_appearances;
+};
+
+struct GameResult {
+    int home_runs;
+    int away_runs;
+    int innings;
+    int plate_appearances;
+    int home_pitches;  // thrown by the home staff; pitch mode only, 0 otherwise
+    int away_pitches;
+    int home_relievers = 0;  // bullpen[0, n) pitched
+    int away_relievers = 0;
+};
+
+// Simulates a half-inning for `batting` against `pitcher`, starting at lineup slot
+// `slot` (updated to the next batter due up). Stops early once more than `max_runs`
+// have scored (walk-off); pass a negative max_runs to play all three outs.
+HalfInningResult simulate_half_inning(
+    const MatchupTable& table,
+    const GameLineup& batting,
+    std::uint32_t pitcher,
+    std::size_t& slot,
+    int max_runs,
+    RNG& rng);
+
+// Counting stats over some set of PAs, by PlateAppearanceResult. No sacrifices or
+// errors in the model, so every non-walk, non-HBP PA is an at-bat.
+struct BattingLine {
+    std::uint64_t results[kNumPlateAppearanceResults] = {};
+    std::uint64_t runs_batted_in = 0;  // everything that scored on the PA
+
+    std::uint64_t count(PlateAppearanceResult r) const { return results[static_cast<std::size_t>(r)]; }
+    std::uint64_t plate_appearances() const;
+    std::uint64_t at_bats() const { return plate_appearances() - count(PlateAppearanceResult::WALK) - count(PlateAppearanceResult::HBP); }
+    std::uint64_t hits() const;
+    std::uint64_t total_bases() const;
+    std::uint64_t times_on_base() const { return hits() + count(PlateAppearanceResult::WALK) + count(PlateAppearanceResult::HBP); }
+
+    void merge(const BattingLine& other);
+};
+
+// Lines a game adds each PA into: the batter's, indexed by which half is batting
+// (0 = top) and lineup slot, and the pitcher's (what was hit against them),
+// indexed by table row so relievers are credited too.
+struct GameStatLines {
+    BattingLine* batters[2][kLineupSize];
+    BattingLine* pitchers;
+};
+
+// Where an observed game reports its PAs: appended to `writer` and/or added into
+// `lines`, either of which may be null. Lineups hold table rows; the id arrays
+// map them back to PlayerIds (row -> PlayerId) for the log.
+struct GameEventTarget {
+    EventLogWriter* writer;
+    const PlayerId* batter_ids;
+    const PlayerId* pitcher_ids;
+    std::uint64_t game_id;
+    const GameStatLines* lines = nullptr;
+};
+
+// Advances `state` by one PA: the batter due up for the side at bat faces the
+// opposing starter, fresh. Lets callers drive many games in lockstep or roll a
+// copied state forward; fatigue and the bullpen only apply in simulate_game.
+PlateAppearanceResult play_plate_appearance(
+    const MatchupTable& table, const GameLineup& home, const GameLineup& away, GameState& state, RNG& rng);
+
+// Nine innings (more if tied); the home half of the 9th+ ends on a walk-off.
+// Pitchers tire along the table's FatigueSchedule (one bucket crossing switches
+// them to the next column) and are relieved as each side's BullpenPolicy says.
+GameResult simulate_game(const MatchupTable& table, const GameLineup& home, const GameLineup& away, RNG& rng);
+
+// Same game (same draws, same result) with every PA reported to `events`.
+GameResult simulate_game(
+    const MatchupTable& table, const GameLineup& home, const GameLineup& away, RNG& rng, const GameEventTarget& events);
+
+// Outcomes from the probability cube: each PA draws from the row for its count,
+// platoon side, inning and outs. Bullpens as above; pitchers stay fresh.
+GameResult simulate_game(const CubeOutcomeTable& table, const GameLineup& home, const GameLineup& away, RNG& rng);
+
+GameResult simulate_game(
+    const CubeOutcomeTable& table, const GameLineup& home, const GameLineup& away, RNG& rng,
+    const GameEventTarget& events);
+
+// Pitch mode: throws one pitch at the current count and applies it to `state`
+// (starters only, as play_plate_appearance). Returns true if the pitch ended the PA.
+bool play_pitch(
+    const PitchMatchupTable& table, const GameLineup& home, const GameLineup& away, GameState& state, RNG& rng);
+
+// Same game, walked pitch by pitch; fills in the pitch counts.
+GameResult simulate_game(const PitchMatchupTable& table, const GameLineup& home, const GameLineup& away, RNG& rng);
+
+// Pitch mode with every PA reported; the state recorded is the one before its first pitch.
+GameResult simulate_game(
+    const PitchMatchupTable& table, const GameLineup& home, const GameLineup& away, RNG& rng,
+    const GameEventTarget& events);
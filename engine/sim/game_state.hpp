@@ -0,0 +1,186 @@
+#pragma once
+
+#include "engine/model/team.hpp"
+#include "engine/sim/plate_appearence.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// Base-out state as one index: bases bitmask (bit 0 = first, 1 = second, 2 = third)
+// in the low three bits, outs above. 0..23 are live states; 24..31 mean the third
+// out was made.
+constexpr std::size_t kNumBaseOutStates = 24;
+
+constexpr unsigned base_out_index(unsigned bases, unsigned outs) { return (outs << 3) | bases; }
+constexpr unsigned base_out_bases(unsigned index) { return index & 7u; }
+constexpr unsigned base_out_outs(unsigned index) { return index >> 3; }
+
+struct BaseOutTransition {
+    std::uint8_t next;  // base_out_index after the PA (outs may be 3)
+    std::uint8_t runs;  // runs scored on the play
+};
+
+namespace game_state_detail {
+
+constexpr unsigned runners(unsigned bases) { return (bases & 1u) + ((bases >> 1) & 1u) + ((bases >> 2) & 1u); }
+
+constexpr BaseOutTransition transition(unsigned bases, unsigned outs, PlateAppearanceResult r) {
+    switch (r) {
+        case PlateAppearanceResult::WALK:
+        case PlateAppearanceResult::HBP: {
+            // Force runners along only as far as needed.
+            unsigned forced = 1u;
+            while (bases & forced) forced <<= 1;
+            const unsigned runs = forced == 8u ? 1u : 0u;
+            return {static_cast<std::uint8_t>(base_out_index(bases | (forced & 7u) | 1u, outs)), static_cast<std::uint8_t>(runs)};
+        }
+        case PlateAppearanceResult::SINGLE:
+            // Runners on second and third score, runner on first to second.
+            return {static_cast<std::uint8_t>(base_out_index(((bases & 1u) << 1) | 1u, outs)),
+                    static_cast<std::uint8_t>(runners(bases & 6u))};
+        case PlateAppearanceResult::DOUBLE:
+            // Runners on second and third score, runner on first to third.
+            return {static_cast<std::uint8_t>(base_out_index(((bases & 1u) << 2) | 2u, outs)),
+                    static_cast<std::uint8_t>(runners(bases & 6u))};
+        case PlateAppearanceResult::TRIPLE:
+            return {static_cast<std::uint8_t>(base_out_index(4u, outs)), static_cast<std::uint8_t>(runners(bases))};
+        case PlateAppearanceResult::HOMERUN:
+            return {static_cast<std::uint8_t>(base_out_index(0u, outs)), static_cast<std::uint8_t>(runners(bases) + 1)};
+        case PlateAppearanceResult::STRIKEOUT:
+        case PlateAppearanceResult::OUT:
+            break;
+    }
+    return {static_cast<std::uint8_t>(base_out_index(bases, outs + 1)), 0};
+}
+
+constexpr std::array<std::array<BaseOutTransition, kNumPlateAppearanceResults>, kNumBaseOutStates> build_transitions() {
+    std::array<std::array<BaseOutTransition, kNumPlateAppearanceResults>, kNumBaseOutStates> table{};
+    for (unsigned s = 0; s < kNumBaseOutStates; ++s) {
+        for (std::size_t r = 0; r < kNumPlateAppearanceResults; ++r) {
+            table[s][r] = transition(base_out_bases(s), base_out_outs(s), static_cast<PlateAppearanceResult>(r));
+        }
+    }
+    return table;
+}
+
+}  // namespace game_state_detail
+
+// Base running, as a table on (base-out state, outcome). Shared by the game loop
+// and the analytic solvers so they can never disagree.
+inline constexpr auto kBaseOutTransitions = game_state_detail::build_transitions();
+
+// Last inning a game may reach before it is called a tie; real games end long before.
+constexpr int kMaxInnings = 50;
+
+// Whole game situation in one 64-bit word, so states copy for free and millions of
+// concurrent games fit in cache.
+//
+//   bits  0-2   bases          bits 17-20  away lineup slot
+//   bits  3-4   outs           bits 21-24  home lineup slot
+//   bits  5-8   count_id       bits 32-47  away score
+//   bit   9     bottom half    bits 48-63  home score
+//   bit  10     final
+//   bits 11-16  inning
+//
+// count_id is balls*4 + strikes, as in baseball_stats/pa_model.py; it stays 0 in
+// PA-level simulation.
+class GameState {
+public:
+    constexpr GameState() : bits_(std::uint64_t{1} << kInningShift) {}
+
+    unsigned bases() const { return field(0, 3); }
+    unsigned outs() const { return field(3, 2); }
+    unsigned base_out() const { return field(0, 5); }
+    unsigned count_id() const { return field(5, 4); }
+    unsigned balls() const { return count_id() >> 2; }
+    unsigned strikes() const { return count_id() & 3u; }
+    bool bottom() const { return field(9, 1) != 0; }
+    bool final() const { return field(10, 1) != 0; }
+    int inning() const { return static_cast<int>(field(kInningShift, 6)); }
+    unsigned lineup_slot(bool home) const { return field(home ? 21 : 17, 4); }
+    unsigned batting_slot() const { return lineup_slot(bottom()); }
+    int away_score() const { return static_cast<int>(field(32, 16)); }
+    int home_score() const { return static_cast<int>(field(48, 16)); }
+
+    void set_base_out(unsigned index) { set_field(0, 5, index); }
+    void set_count_id(unsigned count_id) { set_field(5, 4, count_id); }
+    void set_inning(int inning, bool bottom) {
+        set_field(kInningShift, 6, static_cast<unsigned>(inning));
+        set_field(9, 1, bottom ? 1u : 0u);
+    }
+    void set_lineup_slot(bool home, unsigned slot) { set_field(home ? 21 : 17, 4, slot); }
+    void set_score(int away, int home) {
+        set_field(32, 16, static_cast<unsigned>(away));
+        set_field(48, 16, static_cast<unsigned>(home));
+    }
+    void set_final(bool final) { set_field(10, 1, final ? 1u : 0u); }
+
+    // Plays one PA result for the batting side: table-driven base running, the
+    // batter's slot advances, the count resets, and half-inning / game-over rules
+    // (including walk-offs and extra innings) are applied.
+    void apply(PlateAppearanceResult result) {
+        const BaseOutTransition t = kBaseOutTransitions[base_out()][static_cast<std::size_t>(result)];
+        const bool home = bottom();
+        const unsigned slot = lineup_slot(home);
+        set_lineup_slot(home, slot + 1 == kLineupSize ? 0u : slot + 1);
+        set_count_id(0);
+        if (t.runs) {
+            bits_ += static_cast<std::uint64_t>(t.runs) << (home ? 48 : 32);
+        }
+        if (base_out_outs(t.next) < 3) {
+            set_base_out(t.next);
+            // Walk-off: the home side takes the lead in the 9th or later.
+            if (home && inning() >= 9 && home_score() > away_score()) set_final(true);
+            return;
+        }
+        end_half_inning();
+    }
+
+    std::uint64_t raw() const { return bits_; }
+    static GameState from_raw(std::uint64_t bits) {
+        GameState s;
+        s.bits_ = bits;
+        return s;
+    }
+
+    bool operator==(const GameState& o) const { return bits_ == o.bits_; }
+    bool operator!=(const GameState& o) const { return bits_ != o.bits_; }
+
+private:
+    static constexpr unsigned kInningShift = 11;
+
+    unsigned field(unsigned shift, unsigned width) const {
+        return static_cast<unsigned>((bits_ >> shift) & ((std::uint64_t{1} << width) - 1));
+    }
+
+    void set_field(unsigned shift, unsigned width, unsigned value) {
+        const std::uint64_t mask = ((std::uint64_t{1} << width) - 1) << shift;
+        bits_ = (bits_ & ~mask) | ((static_cast<std::uint64_t>(value) << shift) & mask);
+    }
+
+    void end_half_inning() {
+        set_base_out(0);
+        const int inn = inning();
+        if (!bottom()) {
+            // Home side doesn't bat in the 9th+ if it is already ahead.
+            if (inn >= 9 && home_score() > away_score()) {
+                set_final(true);
+            } else {
+                set_inning(inn, true);
+            }
+            return;
+        }
+        if ((inn >= 9 && home_score() != away_score()) || inn >= kMaxInnings) {
+            set_final(true);
+        } else {
+            set_inning(inn + 1, false);
+        }
+    }
+
+    std::uint64_t bits_;
+};
+
+static_assert(sizeof(GameState) == sizeof(std::uint64_t), "GameState is one word");
+static_assert(std::is_trivially_copyable<GameState>::value, "GameState must copy as plain bits");
@@ -0,0 +1,322 @@
+#include "engine/sim/lineup_optimizer.hpp"
+
+#include "engine/core/thread_pool.hpp"
+#include "engine/sim/game_state.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace {
+
+// Live mass below which a half-inning DP stops; the truncated tail is worth
+// well under 1e-8 runs, far below any difference between distinct orderings.
+constexpr double kLiveEpsilon = 1e-9;
+constexpr int kMaxLevels = 96;
+
+// One batter's PA as dense linear maps on the base state, shared by all three
+// out counts: hits/walks move mass between base states without adding an out,
+// outs carry the base state into the next out count unchanged.
+struct BatterKernel {
+    alignas(32) double hit[8][8];  // [from bases][to bases]
+    alignas(32) double runs[8];    // expected runs scored on this PA from each base state
+    double out;                    // P(out or strikeout)
+
+    explicit BatterKernel(const double* p = nullptr) : hit(), runs(), out(0.0) {
+        if (!p) return;
+        out = p[static_cast<std::size_t>(PlateAppearanceResult::OUT)]
+            + p[static_cast<std::size_t>(PlateAppearanceResult::STRIKEOUT)];
+        for (unsigned from = 0; from < 8; ++from) {
+            for (std::size_t k = 0; k < kNumPlateAppearanceResults; ++k) {
+                const auto r = static_cast<PlateAppearanceResult>(k);
+                if (r == PlateAppearanceResult::OUT || r == PlateAppearanceResult::STRIKEOUT) continue;
+                const BaseOutTransition t = kBaseOutTransitions[base_out_index(from, 0)][k];
+                hit[from][base_out_bases(t.next)] += p[k];
+                runs[from] += p[k] * t.runs;
+            }
+        }
+    }
+};
+
+// A half-inning DP from an empty 0-out inning, `level` PAs in. Runs are banked as
+// they score, so expected_runs is exact for everything already played.
+struct Frontier {
+    alignas(32) double mass[3][8];     // [outs][bases]
+    double runs;
+    double next_leadoff[kLineupSize];  // where finished paths hand over
+    double live;
+    int level;
+
+    void reset() {
+        std::memset(this, 0, sizeof(*this));
+        mass[0][0] = 1.0;
+        live = 1.0;
+    }
+
+    // One PA by batter `b`; paths that make the third out hand over to `leadoff`.
+    void step(const BatterKernel& b, std::size_t leadoff) {
+        alignas(32) double next[3][8];
+        for (int o = 0; o < 3; ++o) {
+            double acc[8] = {};
+            for (int from = 0; from < 8; ++from) {
+                const double m = mass[o][from];
+                for (int to = 0; to < 8; ++to) acc[to] += m * b.hit[from][to];
+            }
+            std::memcpy(next[o], acc, sizeof(acc));
+        }
+        for (int o = 1; o < 3; ++o) {
+            for (int bases = 0; bases < 8; ++bases) next[o][bases] += b.out * mass[o - 1][bases];
+        }
+        double scored = 0.0;
+        double finished = 0.0;
+        for (int bases = 0; bases < 8; ++bases) {
+            scored += (mass[0][bases] + mass[1][bases] + mass[2][bases]) * b.runs[bases];
+            finished += mass[2][bases];
+        }
+        finished *= b.out;
+
+        runs += scored;
+        next_leadoff[leadoff] += finished;
+        live -= finished;
+        std::memcpy(mass, next, sizeof(mass));
+        ++level;
+    }
+};
+
+using SlotKernels = std::array<const BatterKernel*, kLineupSize>;
+
+// Finishes the half-inning that `f` started at `start`, with slot_kernels[slot] batting.
+void finish(Frontier& f, std::size_t start, const SlotKernels& slot_kernels) {
+    while (f.live > kLiveEpsilon && f.level < kMaxLevels) {
+        const std::size_t slot = (start + f.level) % kLineupSize;
+        f.step(*slot_kernels[slot], (slot + 1) % kLineupSize);
+    }
+}
+
+// Expected runs over `innings` innings from per-leadoff-slot half-inning results.
+double chain_innings(const Frontier (&innings_from)[kLineupSize], int innings) {
+    double lead[kLineupSize] = {1.0};
+    double total = 0.0;
+    for (int i = 0; i < innings; ++i) {
+        double next[kLineupSize] = {};
+        for (std::size_t s = 0; s < kLineupSize; ++s) {
+            if (lead[s] == 0.0) continue;
+            total += lead[s] * innings_from[s].runs;
+            for (std::size_t n = 0; n < kLineupSize; ++n) next[n] += lead[s] * innings_from[s].next_leadoff[n];
+        }
+        std::memcpy(lead, next, sizeof(lead));
+    }
+    return total;
+}
+
+// Value of a lineup whose first `depth` slots are fixed (with the half-innings
+// starting there already advanced through the prefix in `started`) and whose
+// other slots bat as slot_kernels says.
+double evaluate_prefix(const Frontier* started, std::size_t depth, const SlotKernels& slot_kernels, int innings) {
+    Frontier innings_from[kLineupSize];
+    for (std::size_t s = 0; s < kLineupSize; ++s) {
+        if (s < depth) {
+            innings_from[s] = started[s];
+        } else {
+            innings_from[s].reset();
+        }
+        finish(innings_from[s], s, slot_kernels);
+    }
+    return chain_innings(innings_from, innings);
+}
+
+struct Candidate {
+    double value = -std::numeric_limits<double>::infinity();
+    std::array<std::size_t, kLineupSize> types{};
+
+    // Higher value wins; ties go to the lexicographically smaller type sequence.
+    bool better_than(const Candidate& o) const {
+        if (value != o.value) return value > o.value;
+        return types < o.types;
+    }
+};
+
+class Search {
+public:
+    Search(const BatterKernel* kernels, std::size_t num_types, int innings)
+        : kernels_(kernels), num_types_(num_types), innings_(innings) {}
+
+    // Evaluates every completion of `prefix` given the remaining type counts.
+    void run(const std::vector<std::size_t>& prefix, std::array<int, kLineupSize> remaining) {
+        remaining_ = remaining;
+        for (std::size_t d = 0; d < prefix.size(); ++d) push(d, prefix[d]);
+        descend(prefix.size());
+    }
+
+    const Candidate& best() const { return best_; }
+    std::uint64_t orderings() const { return orderings_; }
+
+private:
+    // Fixes slot `depth` to a batter of type `t`: every half-inning that starts in
+    // the prefix is advanced by that batter's PA, and a new one starts here.
+    void push(std::size_t depth, std::size_t t) {
+        types_[depth] = t;
+        --remaining_[t];
+        Frontier* cur = frontiers_[depth + 1];
+        const Frontier* prev = frontiers_[depth];
+        const BatterKernel& b = kernels_[t];
+        const std::size_t leadoff = (depth + 1) % kLineupSize;
+        for (std::size_t s = 0; s < depth; ++s) {
+            cur[s] = prev[s];
+            // Inning s is depth - s PAs in, so slot depth is exactly the next batter.
+            if (cur[s].live > kLiveEpsilon) cur[s].step(b, leadoff);
+        }
+        cur[depth].reset();
+        cur[depth].step(b, leadoff);
+    }
+
+    void pop(std::size_t t) { ++remaining_[t]; }
+
+    // The only batter type left to place, or num_types_ if there are several (or none).
+    std::size_t single_remaining_type() const {
+        std::size_t found = num_types_;
+        for (std::size_t t = 0; t < num_types_; ++t) {
+            if (remaining_[t] == 0) continue;
+            if (found != num_types_) return num_types_;
+            found = t;
+        }
+        return found;
+    }
+
+    // The ordering with the first `depth` slots fixed and the rest all `last`.
+    void evaluate_leaf(std::size_t depth, std::size_t last) {
+        ++orderings_;
+        SlotKernels slots;
+        for (std::size_t s = 0; s < depth; ++s) slots[s] = &kernels_[types_[s]];
+        for (std::size_t s = depth; s < kLineupSize; ++s) slots[s] = &kernels_[last];
+        Candidate c;
+        c.value = evaluate_prefix(frontiers_[depth], depth, slots, innings_);
+        c.types = types_;
+        std::fill(c.types.begin() + depth, c.types.end(), last);
+        if (c.better_than(best_)) best_ = c;
+    }
+
+    void descend(std::size_t depth) {
+        for (std::size_t t = 0; t < num_types_; ++t) {
+            if (remaining_[t] == 0) continue;
+            push(depth, t);
+            const std::size_t last = single_remaining_type();
+            if (depth + 1 == kLineupSize || last < num_types_) {
+                // Only one way to finish.
+                evaluate_leaf(depth + 1, depth + 1 == kLineupSize ? t : last);
+            } else {
+                descend(depth + 1);
+            }
+            pop(t);
+        }
+    }
+
+    const BatterKernel* kernels_;
+    std::size_t num_types_;
+    int innings_;
+
+    std::array<int, kLineupSize> remaining_{};
+    std::array<std::size_t, kLineupSize> types_{};
+    // frontiers_[d][s]: half-inning from slot s < d after the first d slots are fixed.
+    Frontier frontiers_[kLineupSize + 1][kLineupSize];
+    Candidate best_;
+    std::uint64_t orderings_ = 0;
+};
+
+std::array<OutcomeDistribution, kLineupSize> lineup_distributions(
+    const MatchupTable& table, const GameLineup& lineup, std::uint32_t pitcher) {
+    std::array<OutcomeDistribution, kLineupSize> slots;
+    for (std::size_t s = 0; s < kLineupSize; ++s) slots[s] = table.at(lineup.batters[s], pitcher);
+    return slots;
+}
+
+}  // namespace
+
+LineupOptimizer::LineupOptimizer(const std::array<OutcomeDistribution, kLineupSize>& batters) : num_types_(0) {
+    for (std::size_t b = 0; b < kLineupSize; ++b) {
+        float p[kNumPlateAppearanceResults];
+        outcome_probabilities(batters[b], p);
+        double total = 0.0;
+        for (float v : p) total += v;
+        for (std::size_t k = 0; k < kNumPlateAppearanceResults; ++k) probs_[b][k] = p[k] / total;
+
+        type_of_[b] = num_types_;
+        for (std::size_t o = 0; o < b; ++o) {
+            if (std::memcmp(probs_[o], probs_[b], sizeof(probs_[b])) == 0) {
+                type_of_[b] = type_of_[o];
+                break;
+            }
+        }
+        if (type_of_[b] == num_types_) ++num_types_;
+    }
+}
+
+LineupOptimizer::LineupOptimizer(const MatchupTable& table, const GameLineup& lineup, std::uint32_t pitcher)
+    : LineupOptimizer(lineup_distributions(table, lineup, pitcher)) {}
+
+double LineupOptimizer::evaluate(const std::array<std::size_t, kLineupSize>& order, int innings) const {
+    BatterKernel kernels[kLineupSize];
+    SlotKernels slots;
+    for (std::size_t s = 0; s < kLineupSize; ++s) {
+        kernels[s] = BatterKernel(probs_[order[s]]);
+        slots[s] = &kernels[s];
+    }
+    return evaluate_prefix(nullptr, 0, slots, innings);
+}
+
+LineupOptimizerResult LineupOptimizer::optimize(const LineupOptimizerConfig& config) const {
+    BatterKernel kernels[kLineupSize];
+    std::array<int, kLineupSize> counts{};
+    for (std::size_t b = 0; b < kLineupSize; ++b) {
+        kernels[type_of_[b]] = BatterKernel(probs_[b]);
+        ++counts[type_of_[b]];
+    }
+
+    // Work items: every distinct choice for the first two slots.
+    std::vector<std::vector<std::size_t>> prefixes;
+    for (std::size_t a = 0; a < num_types_; ++a) {
+        for (std::size_t b = 0; b < num_types_; ++b) {
+            if (b == a && counts[a] < 2) continue;
+            prefixes.push_back({a, b});
+        }
+    }
+
+    WorkStealingPool pool(config.threads);
+    struct WorkerResult {
+        Candidate best;
+        std::uint64_t orderings = 0;
+    };
+    std::vector<WorkerResult> partials(pool.size());
+    pool.parallel_for(prefixes.size(), [&](std::size_t worker, std::size_t i) {
+        // Search holds ~80 KB of frontiers; keep it off the worker stacks.
+        auto search = std::make_unique<Search>(kernels, num_types_, config.innings);
+        search->run(prefixes[i], counts);
+        WorkerResult& mine = partials[worker];
+        if (search->best().better_than(mine.best)) mine.best = search->best();
+        mine.orderings += search->orderings();
+    });
+
+    WorkerResult total;
+    for (const WorkerResult& p : partials) {
+        if (p.best.better_than(total.best)) total.best = p.best;
+        total.orderings += p.orderings;
+    }
+
+    // Types back to batter indices, taking same-type batters in input order.
+    LineupOptimizerResult result;
+    std::array<bool, kLineupSize> used{};
+    for (std::size_t s = 0; s < kLineupSize; ++s) {
+        for (std::size_t b = 0; b < kLineupSize; ++b) {
+            if (!used[b] && type_of_[b] == total.best.types[s]) {
+                used[b] = true;
+                result.order[s] = b;
+                break;
+            }
+        }
+    }
+    result.expected_runs = total.best.value;
+    result.orderings = total.orderings;
+    return result;
+}
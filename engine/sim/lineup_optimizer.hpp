@@ -0,0 +1,56 @@
+#pragma once
+
+#include "engine/model/team.hpp"
+#include "engine/sim/game.hpp"
+#include "engine/sim/matchup_table.hpp"
+#include "engine/sim/plate_appearence.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+struct LineupOptimizerConfig {
+    int innings = 9;          // expected runs are over this many innings from the leadoff slot
+    std::size_t threads = 0;  // 0 = all hardware threads
+};
+
+struct LineupOptimizerResult {
+    std::array<std::size_t, kLineupSize> order;  // order[slot] = index into the optimizer's batters
+    double expected_runs;
+    std::uint64_t orderings;  // distinct orderings evaluated
+};
+
+// Exact search over batting orders for expected runs (as RunExpectancySolver
+// computes them) against one pitcher.
+//
+// - Symmetry: batters with identical outcome distributions are interchangeable,
+//   so only distinct multiset orderings are visited.
+// - Prefix reuse: the search is a depth-first walk that fixes one slot per level.
+//   Each half-inning DP that starts inside the fixed prefix is carried down the
+//   tree and advanced one PA per level instead of being recomputed per ordering.
+// - No bounding: a composite batter that dominates the open slots bounds a
+//   prefix, but on distinct batters it cut only ~3% of the leaves for more
+//   evaluations than it saved, and per-slot assignments of the remaining
+//   batters are not upper bounds once the order wraps around. Every distinct
+//   ordering is evaluated; nine distinct batters (9! orderings) take a few
+//   seconds per thread.
+// - Threads: top-level prefixes fan out over a WorkStealingPool. Ties go to the
+//   lexicographically first ordering, so the answer does not depend on scheduling.
+class LineupOptimizer {
+public:
+    explicit LineupOptimizer(const std::array<OutcomeDistribution, kLineupSize>& batters);
+
+    // The nine batters of `lineup` (in its current order) against `pitcher`.
+    LineupOptimizer(const MatchupTable& table, const GameLineup& lineup, std::uint32_t pitcher);
+
+    LineupOptimizerResult optimize(const LineupOptimizerConfig& config = {}) const;
+
+    // Expected runs for one ordering (order[slot] = batter index).
+    double evaluate(const std::array<std::size_t, kLineupSize>& order, int innings = 9) const;
+
+private:
+    double probs_[kLineupSize][kNumPlateAppearanceResults];
+    // Batters grouped by identical distributions.
+    std::array<std::size_t, kLineupSize> type_of_;
+    std::size_t num_types_;
+};
@@ -0,0 +1,46 @@
+#include "engine/sim/matchup_table.hpp"
+
+#include "engine/core/instrument.hpp"
+
+#include <stdexcept>
+#include <string>
+
+MatchupTable::MatchupTable(
+    const RosterStore& roster,
+    const std::vector<PlayerId>& batters,
+    const std::vector<PlayerId>& pitchers,
+    const FatigueModel& fatigue,
+    MatchupDistribution distribution)
+    : num_batters_(batters.size()), num_pitchers_(pitchers.size()), buckets_(fatigue.buckets), fatigue_(fatigue) {
+    if (buckets_ < 1 || buckets_ > kMaxFatigueBuckets) {
+        throw std::invalid_argument("MatchupTable: fatigue buckets must be 1.." + std::to_string(kMaxFatigueBuckets));
+    }
+    THREEUP3DOWN_COUNT(CACHE_REBUILDS);
+    const float* contact = roster.contact();
+    const float* power = roster.power();
+    const float* eye = roster.eye();
+    const float* stuff = roster.stuff();
+    const float* control = roster.control();
+    const float* movement = roster.movement();
+    const float* stamina = roster.stamina();
+
+    table_.reserve(num_batters_ * num_pitchers_ * buckets_);
+    aliases_.reserve(num_batters_ * num_pitchers_ * buckets_);
+    schedules_.reserve(num_pitchers_);
+    for (PlayerId p : pitchers) {
+        schedules_.push_back(::fatigue_schedule(fatigue_, stamina[p]));
+        for (std::size_t k = 0; k < buckets_; ++k) {
+            // Bucket 0 is left unscaled so a fresh pitcher matches the no-fatigue table bit for bit.
+            const float scale = fatigue_.degradation[k];
+            const float pit_stuff = k ? stuff[p] * scale : stuff[p];
+            const float pit_control = k ? control[p] * scale : control[p];
+            const float pit_movement = k ? movement[p] * scale : movement[p];
+            for (PlayerId b : batters) {
+                table_.push_back(distribution(
+                    contact[b], power[b], eye[b], pit_stuff, pit_control, pit_movement,
+                    platoon_same(roster.bats(b), roster.throws(p))));
+                aliases_.push_back(make_alias_table(table_.back()));
+            }
+        }
+    }
+}
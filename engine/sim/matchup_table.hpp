@@ -0,0 +1,70 @@
+#pragma once
+
+#include "engine/model/roster_store.hpp"
+#include "engine/sim/fatigue.hpp"
+#include "engine/sim/plate_appearence.hpp"
+
+#include <cstddef>
+#include <vector>
+
+// Precomputed outcome distributions for every batter x pitcher pair on the active
+// rosters. Build it once at game/series setup; each PA is then a lookup plus one draw.
+// Rows are pitcher-major, so all matchups against the pitcher on the mound are contiguous.
+// Row/column indices are positions in the `batters` / `pitchers` lists it was built from.
+// Each pair is kept both as cumulative thresholds (exact probabilities, what the
+// batch kernels and analytic solvers read) and as an alias table (what the game
+// loop samples from: one load and one select per PA).
+//
+// With a FatigueModel, every pitcher also gets one column per fatigue bucket
+// (ratings scaled by that bucket's degradation) plus a schedule of when each
+// bucket starts. Bucket 0 is the fresh pitcher, so callers that ignore fatigue
+// see the same table either way.
+//
+// The Outcomes and Platoon policies (see BasicPlateAppearance) decide how each
+// pair's distribution is built; the defaults are the full ratings model with
+// the platoon split, e.g. MatchupTable(roster, batters, pitchers, fatigue,
+// LeagueOutcomes{}, NoPlatoon{}) for a league-average baseline.
+class MatchupTable {
+public:
+    template <typename Outcomes = RatingsOutcomes, typename Platoon = PlatoonSplit>
+    MatchupTable(
+        const RosterStore& roster,
+        const std::vector<PlayerId>& batters,
+        const std::vector<PlayerId>& pitchers,
+        const FatigueModel& fatigue = FatigueModel(),
+        Outcomes = Outcomes(),
+        Platoon = Platoon())
+        : MatchupTable(roster, batters, pitchers, fatigue, &matchup_distribution<Outcomes, Platoon>) {}
+
+    // What the policy form forwards to: each pair from distribution(ratings...).
+    MatchupTable(
+        const RosterStore& roster,
+        const std::vector<PlayerId>& batters,
+        const std::vector<PlayerId>& pitchers,
+        const FatigueModel& fatigue,
+        MatchupDistribution distribution);
+
+    const OutcomeDistribution& at(std::size_t batter, std::size_t pitcher, unsigned bucket = 0) const {
+        return table_[(pitcher * buckets_ + bucket) * num_batters_ + batter];
+    }
+
+    const OutcomeAliasTable& alias_at(std::size_t batter, std::size_t pitcher, unsigned bucket = 0) const {
+        return aliases_[(pitcher * buckets_ + bucket) * num_batters_ + batter];
+    }
+
+    std::size_t num_batters() const { return num_batters_; }
+    std::size_t num_pitchers() const { return num_pitchers_; }
+
+    const FatigueModel& fatigue() const { return fatigue_; }
+    std::size_t fatigue_buckets() const { return buckets_; }
+    const FatigueSchedule& fatigue_schedule(std::size_t pitcher) const { return schedules_[pitcher]; }
+
+private:
+    std::size_t num_batters_;
+    std::size_t num_pitchers_;
+    std::size_t buckets_;
+    FatigueModel fatigue_;
+    std::vector<OutcomeDistribution> table_;
+    std::vector<OutcomeAliasTable> aliases_;
+    std::vector<FatigueSchedule> schedules_;
+};
@@ -0,0 +1,37 @@
+#include "engine/sim/pitch_matchup_table.hpp"
+
+#include "engine/core/instrument.hpp"
+
+#include <stdexcept>
+
+PitchMatchupTable::PitchMatchupTable(
+    const RosterStore& roster,
+    const MatchupTable& matchups,
+    const std::vector<PlayerId>& batters,
+    const std::vector<PlayerId>& pitchers)
+    : num_batters_(batters.size()), num_pitchers_(pitchers.size()), buckets_(matchups.fatigue_buckets()),
+      fatigue_(matchups.fatigue()) {
+    if (matchups.num_batters() != num_batters_ || matchups.num_pitchers() != num_pitchers_) {
+        throw std::invalid_argument("PitchMatchupTable: rosters do not match the MatchupTable");
+    }
+    THREEUP3DOWN_COUNT(CACHE_REBUILDS);
+    const float* contact = roster.contact();
+    const float* eye = roster.eye();
+
+    aliases_.reserve(num_batters_ * num_pitchers_ * buckets_ * kNumCountIds);
+    schedules_.reserve(num_pitchers_);
+    for (std::size_t p = 0; p < num_pitchers_; ++p) {
+        const PitchArsenal arsenal = pitch_arsenal(roster.player(pitchers[p]));
+        schedules_.push_back(matchups.fatigue_schedule(p));
+        for (unsigned k = 0; k < buckets_; ++k) {
+            for (std::size_t b = 0; b < num_batters_; ++b) {
+                const PlayerId id = batters[b];
+                const PitchCountDistribution dist =
+                    pitch_count_distribution(matchups.at(b, p, k), arsenal, contact[id], eye[id]);
+                for (unsigned c = 0; c < kNumCountIds; ++c) {
+                    aliases_.emplace_back(dist.probs[c]);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "engine/model/roster_store.hpp"
+#include "engine/sim/matchup_table.hpp"
+#include "engine/sim/pitch_model.hpp"
+
+#include <cstddef>
+#include <vector>
+
+// Alias tables for every batter x pitcher x count_id, for pitch-by-pitch games.
+// Same rows, columns and pitcher-major layout as the MatchupTable it is built
+// from, and calibrated against it pair by pair, so a pitch is one lookup plus one
+// draw (a PA averages about four of them). Fatigue buckets are carried over too,
+// each calibrated against its own MatchupTable column.
+class PitchMatchupTable {
+public:
+    PitchMatchupTable(
+        const RosterStore& roster,
+        const MatchupTable& matchups,
+        const std::vector<PlayerId>& batters,
+        const std::vector<PlayerId>& pitchers);
+
+    const PitchAliasTable& alias_at(std::size_t batter, std::size_t pitcher, unsigned count_id, unsigned bucket = 0) const {
+        return aliases_[((pitcher * buckets_ + bucket) * num_batters_ + batter) * kNumCountIds + count_id];
+    }
+
+    std::size_t num_batters() const { return num_batters_; }
+    std::size_t num_pitchers() const { return num_pitchers_; }
+
+    const FatigueModel& fatigue() const { return fatigue_; }
+    std::size_t fatigue_buckets() const { return buckets_; }
+    const FatigueSchedule& fatigue_schedule(std::size_t pitcher) const { return schedules_[pitcher]; }
+
+private:
+    std::size_t num_batters_;
+    std::size_t num_pitchers_;
+    std::size_t buckets_;
+    FatigueModel fatigue_;
+    std::vector<PitchAliasTable> aliases_;
+    std::vector<FatigueSchedule> schedules_;
+};
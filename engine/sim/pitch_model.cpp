@@ -0,0 +1,189 @@
+#include "engine/sim/pitch_model.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Unscaled per-count weights for ball, strike, foul and ball-in-play (incl. HBP).
+struct CountWeights {
+    double ball[kNumCountIds];
+    double strike[kNumCountIds];
+    double foul[kNumCountIds];
+    double in_play[kNumCountIds];
+};
+
+CountWeights count_weights(const PitchArsenal& arsenal, float contact, float eye) {
+    const double stuff = 0.5 * (arsenal.velocity + arsenal.movement);
+    CountWeights w{};
+    for (unsigned c = 0; c < kNumCountIds; ++c) {
+        const double balls = c >> 2;
+        const double strikes = std::min(c & 3u, 2u);
+        // Behind in the count pitchers come into the zone; ahead they expand it.
+        w.ball[c] = 0.36 * (1.3 - 0.6 * arsenal.control) * (0.85 + 0.3 * eye) * (1.0 - 0.07 * balls + 0.12 * strikes);
+        w.strike[c] = 0.27 * (0.7 + 0.6 * stuff) * (1.3 - 0.6 * contact) * (1.0 - 0.12 * balls);
+        // Two-strike protection: more fouls.
+        w.foul[c] = 0.18 * (0.8 + 0.4 * contact) * (1.0 + 0.2 * strikes);
+        w.in_play[c] = 0.19 * (0.8 + 0.4 * contact) * (1.0 + 0.06 * balls);
+    }
+    return w;
+}
+
+struct ChainOutcome {
+    double walk;
+    double strikeout;
+    double pitches;
+};
+
+// Walks the count from 0-0 with ball weights scaled by `ball_scale` and strike
+// weights by `strike_scale`. Counts are visited in (balls, strikes) order, so every
+// state's entry mass is final before it is expanded.
+ChainOutcome walk_count(const CountWeights& w, double ball_scale, double strike_scale) {
+    double reach[kNumCountIds] = {1.0};
+    ChainOutcome out{0.0, 0.0, 0.0};
+    for (unsigned balls = 0; balls < 4; ++balls) {
+        for (unsigned strikes = 0; strikes < 3; ++strikes) {
+            const unsigned c = balls * 4 + strikes;
+            const double r = reach[c];
+            if (r == 0.0) continue;
+            const double b = ball_scale * w.ball[c];
+            const double s = strike_scale * w.strike[c];
+            const double total = b + s + w.foul[c] + w.in_play[c];
+            // Two-strike fouls loop back to the same count; fold the loop in.
+            const double stay = strikes == 2 ? w.foul[c] / total : 0.0;
+            const double leave = 1.0 - stay;
+            const double p_ball = b / total / leave;
+            const double p_strike = (strikes == 2 ? s : s + w.foul[c]) / total / leave;
+            out.pitches += r / leave;
+            if (balls == 3) {
+                out.walk += r * p_ball;
+            } else {
+                reach[c + 4] += r * p_ball;
+            }
+            if (strikes == 2) {
+                out.strikeout += r * p_strike;
+            } else {
+                reach[c + 1] += r * p_strike;
+            }
+        }
+    }
+    return out;
+}
+
+}  // namespace
+
+PitchArsenal pitch_arsenal(const Player& pitcher) {
+    const PitcherRatings& pit = pitcher.pitcherRatings.current;
+    PitchArsenal fallback{pit.stuff, pit.movement, pit.control};
+    if (!pitcher.pitchTypeRatings) return fallback;
+
+    const PitchTypeRatings& mix = *pitcher.pitchTypeRatings;
+    const std::optional<Pitch>* pitches[] = {
+        &mix.fastball, &mix.slider, &mix.curveball, &mix.changeup,
+        &mix.cutter, &mix.sinker, &mix.splitter, &mix.knuckleball};
+    double usage = 0.0;
+    double velocity = 0.0;
+    double movement = 0.0;
+    double control = 0.0;
+    for (const std::optional<Pitch>* p : pitches) {
+        if (!*p || (*p)->usage <= 0.f) continue;
+        const Pitch& pitch = **p;
+        usage += pitch.usage;
+        velocity += pitch.usage * pitch.velocity;
+        movement += pitch.usage * pitch.movement;
+        control += pitch.usage * pitch.control;
+    }
+    if (usage <= 0.0) return fallback;
+    // Usages should sum to 1 but aren't trusted to.
+    return {static_cast<float>(velocity / usage), static_cast<float>(movement / usage), static_cast<float>(control / usage)};
+}
+
+PitchCountDistribution pitch_count_distribution(
+    const OutcomeDistribution& pa, const PitchArsenal& arsenal, float contact, float eye) {
+    float pa_probs[kNumPlateAppearanceResults];
+    outcome_probabilities(pa, pa_probs);
+    const double target_walk = pa_probs[static_cast<std::size_t>(PlateAppearanceResult::WALK)];
+    const double target_k = pa_probs[static_cast<std::size_t>(PlateAppearanceResult::STRIKEOUT)];
+
+    const CountWeights w = count_weights(arsenal, contact, eye);
+
+    // Newton on (log ball scale, log strike scale). Both rates are smooth and
+    // monotone in the scales, so this converges in a handful of steps.
+    double x = 0.0;
+    double y = 0.0;
+    for (int iter = 0; iter < 30; ++iter) {
+        const ChainOutcome f = walk_count(w, std::exp(x), std::exp(y));
+        const double fw = f.walk - target_walk;
+        const double fk = f.strikeout - target_k;
+        if (std::fabs(fw) < 1e-9 && std::fabs(fk) < 1e-9) break;
+        const double h = 1e-5;
+        const ChainOutcome fx = walk_count(w, std::exp(x + h), std::exp(y));
+        const ChainOutcome fy = walk_count(w, std::exp(x), std::exp(y + h));
+        const double a = (fx.walk - f.walk) / h;
+        const double b = (fy.walk - f.walk) / h;
+        const double c = (fx.strikeout - f.strikeout) / h;
+        const double d = (fy.strikeout - f.strikeout) / h;
+        const double det = a * d - b * c;
+        if (det == 0.0) break;
+        const double dx = (d * fw - b * fk) / det;
+        const double dy = (a * fk - c * fw) / det;
+        x -= std::max(-1.0, std::min(1.0, dx));
+        y -= std::max(-1.0, std::min(1.0, dy));
+    }
+    const double ball_scale = std::exp(x);
+    const double strike_scale = std::exp(y);
+
+    // Terminal outcomes other than walk and K split like the PA model.
+    const PlateAppearanceResult in_play[] = {
+        PlateAppearanceResult::HBP, PlateAppearanceResult::SINGLE, PlateAppearanceResult::DOUBLE,
+        PlateAppearanceResult::TRIPLE, PlateAppearanceResult::HOMERUN, PlateAppearanceResult::OUT};
+    const double in_play_total = 1.0 - target_walk - target_k;
+
+    PitchCountDistribution dist{};
+    for (unsigned c = 0; c < kNumCountIds; ++c) {
+        const double b = ball_scale * w.ball[c];
+        const double s = strike_scale * w.strike[c];
+        const double total = b + s + w.foul[c] + w.in_play[c];
+        float* p = dist.probs[c];
+        p[static_cast<std::size_t>(PitchResult::BALL)] = static_cast<float>(b / total);
+        p[static_cast<std::size_t>(PitchResult::STRIKE)] = static_cast<float>(s / total);
+        p[static_cast<std::size_t>(PitchResult::FOUL)] = static_cast<float>(w.foul[c] / total);
+        for (std::size_t i = 0; i < 6; ++i) {
+            const double share = pa_probs[static_cast<std::size_t>(in_play[i])] / in_play_total;
+            p[static_cast<std::size_t>(PitchResult::HBP) + i] = static_cast<float>(w.in_play[c] / total * share);
+        }
+    }
+    return dist;
+}
+
+void count_chain_outcomes(
+    const PitchCountDistribution& dist, double (&probs)[kNumPlateAppearanceResults], double& pitches_per_pa,
+    unsigned start_count) {
+    // Every pitch moves to a later count in this order (or stays, or ends the PA).
+    double reach[kNumCountIds] = {};
+    reach[start_count] = 1.0;
+    std::fill(std::begin(probs), std::end(probs), 0.0);
+    pitches_per_pa = 0.0;
+    for (unsigned balls = 0; balls < 4; ++balls) {
+        for (unsigned strikes = 0; strikes < 3; ++strikes) {
+            const unsigned c = balls * 4 + strikes;
+            const double r = reach[c];
+            if (r == 0.0) continue;
+            // Mass that stays on this count (two-strike fouls) is folded in geometrically.
+            double stay = 0.0;
+            for (std::size_t k = 0; k < kNumPitchResults; ++k) {
+                if (kCountTransitions[c][k].result < 0 && kCountTransitions[c][k].next_count == c) stay += dist.probs[c][k];
+            }
+            const double scale = r / (1.0 - stay);
+            pitches_per_pa += scale;
+            for (std::size_t k = 0; k < kNumPitchResults; ++k) {
+                const CountTransition t = kCountTransitions[c][k];
+                if (t.result >= 0) {
+                    probs[t.result] += scale * dist.probs[c][k];
+                } else if (t.next_count != c) {
+                    reach[t.next_count] += scale * dist.probs[c][k];
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "engine/core/alias_table.hpp"
+#include "engine/model/player.hpp"
+#include "engine/sim/plate_appearence.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Result of one pitch. BALL / STRIKE / FOUL move the count; the rest end the PA
+// with the PlateAppearanceResult of the same name (IN_PLAY_OUT -> OUT).
+enum class PitchResult {
+    BALL,
+    STRIKE,  // called or swinging
+    FOUL,
+    HBP,
+    SINGLE,
+    DOUBLE,
+    TRIPLE,
+    HOMERUN,
+    IN_PLAY_OUT
+};
+
+constexpr std::size_t kNumPitchResults = 9;
+
+// Counts are indexed by count_id = balls*4 + strikes (as in GameState and
+// baseball_stats/pa_model.py); ids with strikes == 3 are never reached.
+constexpr std::size_t kNumCountIds = 16;
+
+using PitchAliasTable = AliasTable<kNumPitchResults>;
+
+// Where a pitch leaves the count: the next count_id, or the PA result it ends with.
+struct CountTransition {
+    std::uint8_t next_count;
+    std::int8_t result;  // PlateAppearanceResult, or -1 while the PA goes on
+};
+
+namespace pitch_model_detail {
+
+constexpr CountTransition count_transition(unsigned count_id, PitchResult r) {
+    const unsigned balls = count_id >> 2;
+    const unsigned strikes = count_id & 3u;
+    switch (r) {
+        case PitchResult::BALL:
+            if (balls == 3) return {0, static_cast<std::int8_t>(PlateAppearanceResult::WALK)};
+            return {static_cast<std::uint8_t>(count_id + 4), -1};
+        case PitchResult::STRIKE:
+            if (strikes == 2) return {0, static_cast<std::int8_t>(PlateAppearanceResult::STRIKEOUT)};
+            return {static_cast<std::uint8_t>(count_id + 1), -1};
+        case PitchResult::FOUL:
+            // Two-strike fouls leave the count alone.
+            return {static_cast<std::uint8_t>(strikes == 2 ? count_id : count_id + 1), -1};
+        case PitchResult::HBP: return {0, static_cast<std::int8_t>(PlateAppearanceResult::HBP)};
+        case PitchResult::SINGLE: return {0, static_cast<std::int8_t>(PlateAppearanceResult::SINGLE)};
+        case PitchResult::DOUBLE: return {0, static_cast<std::int8_t>(PlateAppearanceResult::DOUBLE)};
+        case PitchResult::TRIPLE: return {0, static_cast<std::int8_t>(PlateAppearanceResult::TRIPLE)};
+        case PitchResult::HOMERUN: return {0, static_cast<std::int8_t>(PlateAppearanceResult::HOMERUN)};
+        case PitchResult::IN_PLAY_OUT: break;
+    }
+    return {0, static_cast<std::int8_t>(PlateAppearanceResult::OUT)};
+}
+
+constexpr std::array<std::array<CountTransition, kNumPitchResults>, kNumCountIds> build_count_transitions() {
+    std::array<std::array<CountTransition, kNumPitchResults>, kNumCountIds> table{};
+    for (unsigned c = 0; c < kNumCountIds; ++c) {
+        for (std::size_t r = 0; r < kNumPitchResults; ++r) {
+            table[c][r] = count_transition(c, static_cast<PitchResult>(r));
+        }
+    }
+    return table;
+}
+
+}  // namespace pitch_model_detail
+
+// Count walking, as a table on (count_id, pitch result).
+inline constexpr auto kCountTransitions = pitch_model_detail::build_count_transitions();
+
+// A pitcher's usage-weighted arsenal. Pitch fields are 0..1 ratings like the rest
+// of player.hpp; pitchers without a pitch mix fall back to stuff/movement/control.
+struct PitchArsenal {
+    float velocity;
+    float movement;
+    float control;
+};
+
+PitchArsenal pitch_arsenal(const Player& pitcher);
+
+// Per-pitch probabilities for one matchup, probs[count_id][PitchResult].
+struct PitchCountDistribution {
+    float probs[kNumCountIds][kNumPitchResults];
+};
+
+// Shapes per-count ball / strike / foul / in-play rates from the arsenal and the
+// batter's contact and eye, then scales the ball and strike rates so that walking
+// the count reproduces the PA model's walk and strikeout rates; balls in play (and
+// HBP) split like the PA model's. Pitch mode therefore agrees with the PA-level
+// path on outcomes and adds pitch counts on top.
+PitchCountDistribution pitch_count_distribution(
+    const OutcomeDistribution& pa, const PitchArsenal& arsenal, float contact, float eye);
+
+// Exact PA outcome probabilities and mean pitches per PA implied by walking the
+// count from `start_count` (default 0-0) under `dist`.
+void count_chain_outcomes(
+    const PitchCountDistribution& dist, double (&probs)[kNumPlateAppearanceResults], double& pitches_per_pa,
+    unsigned start_count = 0);
@@ -8,45 +8,33 @@ float clamp(float v, float lo, float hi) {
     return std::max(lo, std::min(hi, v));
 }
 
-}  // namespace
+// Walk / K / HR multipliers and in-play shares from one league table.
+struct LeagueSplit {
+    float walk, strikeout, homerun;
+    float hbp, single, double_, triple;
+};
+
+OutcomeDistribution from_ratings(
+    float contact, float power, float eye,
+    float stuff, float control, float movement,
+    const LeagueSplit& split,
+    const ResolveCoefficients& c) {
+    // Coefficients fitted to the league rates (baseball_stats/resolve_coefficients.json).
+    float walk_prob = c[COEF_WALK_SCALE] * eye * (1.0f - control * c[COEF_WALK_CONTROL]);
+    float k_prob = c[COEF_STRIKEOUT_SCALE] * (1.0f - contact * c[COEF_STRIKEOUT_CONTACT]) *
+                   (c[COEF_STRIKEOUT_STUFF_BASE] + stuff * c[COEF_STRIKEOUT_STUFF]);
+    float hr_prob = c[COEF_HOMERUN_SCALE] * power * (1.0f - movement * c[COEF_HOMERUN_MOVEMENT]);
+
+    walk_prob *= split.walk;
+    k_prob *= split.strikeout;
+    hr_prob *= split.homerun;
 
-PlateAppearance::PlateAppearance(const Player& batter, const Player& pitcher, RNG& rng) : batter_(&batter), pitcher_(&pitcher), rng_(&rng) {}
-
-PlateAppearanceResult PlateAppearance::resolve() {
-    const auto& bat = batter_->batterRatings.current;
-    const auto& pit = pitcher_->pitcherRatings.current;
-
-    // pa_outcome_rates_same.json
-    const float base_walk_prob_same = 0.07222732043455087f;
-    const float base_hbp_prob_same = 0.012946406492985531f;
-    const float base_single_prob_same = 0.14511405036789554f;
-    const float base_double_prob_same = 0.04112517240810854f;
-    const float base_triple_prob_same = 0.0032091262274633065f;
-    const float base_hr_prob_same = 0.028288667498255312f;
-    const float base_strikeout_prob_same = 0.23013941015820333f;
-    const float base_out_prob_same = 0.46694984641253756f;
-
-    // pa_outcome_rates_opposite.json
-    const float base_walk_prob_alt = 0.08774304988212227f;
-    const float base_hbp_prob_alt = 0.009042739431852664f;
-    const float base_single_prob_alt = 0.13974930557176538f;
-    const float base_double_prob_alt = 0.0437431432506244f;
-    const float base_triple_prob_alt = 0.004075535118227866f;
-    const float base_hr_prob_alt = 0.03190868560491118f;
-    const float base_strikeout_prob_alt = 0.2188651058565393f;
-    const float base_out_prob_alt = 0.46487243528395694f;
-
-    // Outcome probabilities from 2024-2025 seasons incl.
-    float walk_prob = 0.12f * bat.eye * (1.0f - pit.control * 0.8f);
-    float k_prob = 0.24f * (1.0f - bat.contact * 0.8f) * (0.3f + pit.stuff * 0.7f);
-    float hr_prob = 0.04f * bat.power * (1.0f - pit.movement * 0.7f);
-
-    walk_prob = clamp(walk_prob, 0.02f, 0.18f);
-    k_prob = clamp(k_prob, 0.08f, 0.38f);
-    hr_prob = clamp(hr_prob, 0.005f, 0.10f);
+    walk_prob = clamp(walk_prob, c[COEF_WALK_MIN], c[COEF_WALK_MAX]);
+    k_prob = clamp(k_prob, c[COEF_STRIKEOUT_MIN], c[COEF_STRIKEOUT_MAX]);
+    hr_prob = clamp(hr_prob, c[COEF_HOMERUN_MIN], c[COEF_HOMERUN_MAX]);
 
     float in_play_prob = 1.0f - walk_prob - k_prob - hr_prob;
-    in_play_prob = clamp(in_play_prob, 0.35f, 0.90f);
+    in_play_prob = clamp(in_play_prob, c[COEF_IN_PLAY_MIN], c[COEF_IN_PLAY_MAX]);
 
     // Renormalize so they sum to 1
     float total = walk_prob + k_prob + hr_prob + in_play_prob;
@@ -55,12 +43,44 @@ PlateAppearanceResult PlateAppearance::resolve() {
     hr_prob /= total;
     in_play_prob /= total;
 
-    float u = rng_->uniform();
+    // Everything that isn't a walk, K or HR splits by the league mix.
+    OutcomeDistribution dist;
+    dist.cumulative[0] = walk_prob;
+    dist.cumulative[1] = dist.cumulative[0] + in_play_prob * split.hbp;
+    dist.cumulative[2] = dist.cumulative[1] + in_play_prob * split.single;
+    dist.cumulative[3] = dist.cumulative[2] + in_play_prob * split.double_;
+    dist.cumulative[4] = dist.cumulative[3] + in_play_prob * split.triple;
+    dist.cumulative[5] = dist.cumulative[4] + hr_prob;
+    dist.cumulative[6] = dist.cumulative[5] + k_prob;
+    return dist;
+}
+
+constexpr LeagueSplit platoon_split(int same) {
+    return {kPlatoonWalkAdjust[same], kPlatoonStrikeoutAdjust[same], kPlatoonHomerunAdjust[same],
+            kPlatoonHbpShare[same], kPlatoonSingleShare[same], kPlatoonDoubleShare[same], kPlatoonTripleShare[same]};
+}
+
+// Indexed by platoon_same(), so the split is selected by index rather than by branch.
+constexpr LeagueSplit kPlatoonSplits[2] = {platoon_split(0), platoon_split(1)};
+
+constexpr LeagueSplit kNeutralSplit = {
+    1.0f, 1.0f, 1.0f,
+    in_play_share(kLeagueOutcomeRates, RATE_HBP), in_play_share(kLeagueOutcomeRates, RATE_SINGLE),
+    in_play_share(kLeagueOutcomeRates, RATE_DOUBLE), in_play_share(kLeagueOutcomeRates, RATE_TRIPLE)};
+
+}  // namespace
+
+OutcomeDistribution outcome_distribution(
+    float contact, float power, float eye,
+    float stuff, float control, float movement,
+    int same_hand,
+    const ResolveCoefficients& c) {
+    return from_ratings(contact, power, eye, stuff, control, movement, kPlatoonSplits[same_hand], c);
+}
 
-    if (u < walk_prob) return PlateAppearanceResult::WALK;
-    u -= walk_prob;
-    if (u < k_prob) return PlateAppearanceResult::STRIKEOUT;
-    u -= k_prob;
-    if (u < hr_prob) return PlateAppearanceResult::HOMERUN;
-    return PlateAppearanceResult::IN_PLAY;
+OutcomeDistribution neutral_outcome_distribution(
+    float contact, float power, float eye,
+    float stuff, float control, float movement,
+    const ResolveCoefficients& c) {
+    return from_ratings(contact, power, eye, stuff, control, movement, kNeutralSplit, c);
 }
@@ -1,26 +1,194 @@
 #pragma once
 
+#include "engine/core/alias_table.hpp"
+#include "engine/core/instrument.hpp"
 #include "engine/core/rng.hpp"
+#include "engine/model/outcome_rates.hpp"
 #include "engine/model/player.hpp"
+#include "engine/model/resolve_coefficients.hpp"
 
+#include <cstddef>
+#include <type_traits>
+
+// Same categories and order as OUTCOME_ORDER in baseball_stats/pa_data.py.
 enum class PlateAppearanceResult {
     WALK,
-    STRIKEOUT,
+    HBP,
+    SINGLE,
+    DOUBLE,
+    TRIPLE,
     HOMERUN,
-    IN_PLAY
+    STRIKEOUT,
+    OUT
+};
+
+constexpr std::size_t kNumPlateAppearanceResults = 8;
+
+static_assert(kNumPlateAppearanceResults == kNumOutcomeRates, "PA results mirror OUTCOME_ORDER");
+static_assert(static_cast<std::size_t>(PlateAppearanceResult::HOMERUN) == RATE_HR, "PA results mirror OUTCOME_ORDER");
+static_assert(static_cast<std::size_t>(PlateAppearanceResult::OUT) == RATE_OUT, "PA results mirror OUTCOME_ORDER");
+
+// Cumulative outcome thresholds in PlateAppearanceResult order. The last outcome
+// (OUT) takes whatever is left above cumulative[kNumPlateAppearanceResults - 2].
+struct OutcomeDistribution {
+    float cumulative[kNumPlateAppearanceResults - 1];
 };
 
-class PlateAppearance {
+// Probability of each outcome, recovered from the cumulative thresholds.
+inline void outcome_probabilities(const OutcomeDistribution& dist, float (&probs)[kNumPlateAppearanceResults]) {
+    float prev = 0.f;
+    for (std::size_t i = 0; i + 1 < kNumPlateAppearanceResults; ++i) {
+        probs[i] = dist.cumulative[i] - prev;
+        prev = dist.cumulative[i];
+    }
+    probs[kNumPlateAppearanceResults - 1] = 1.f - prev;
+}
+
+// Platoon multipliers on the rating-driven walk / strikeout / home-run rates,
+// indexed by platoon_same(). Baked in from the generated league-rate tables.
+inline constexpr float kPlatoonWalkAdjust[2] = {platoon_adjustment(0, RATE_WALK), platoon_adjustment(1, RATE_WALK)};
+inline constexpr float kPlatoonStrikeoutAdjust[2] = {platoon_adjustment(0, RATE_STRIKEOUT), platoon_adjustment(1, RATE_STRIKEOUT)};
+inline constexpr float kPlatoonHomerunAdjust[2] = {platoon_adjustment(0, RATE_HR), platoon_adjustment(1, RATE_HR)};
+
+// How the remaining (non walk/K/HR) mass splits into HBP, singles, doubles, triples
+// and outs: each outcome's share of that group in a league table.
+constexpr float in_play_share(const OutcomeRates& rates, OutcomeRateIndex outcome) {
+    const float* p = rates.prob;
+    return p[outcome] / (p[RATE_HBP] + p[RATE_SINGLE] + p[RATE_DOUBLE] + p[RATE_TRIPLE] + p[RATE_OUT]);
+}
+
+// Same, from the platoon league table.
+constexpr float in_play_share(int same, OutcomeRateIndex outcome) {
+    return in_play_share(kPlatoonOutcomeRates[same], outcome);
+}
+
+inline constexpr float kPlatoonHbpShare[2] = {in_play_share(0, RATE_HBP), in_play_share(1, RATE_HBP)};
+inline constexpr float kPlatoonSingleShare[2] = {in_play_share(0, RATE_SINGLE), in_play_share(1, RATE_SINGLE)};
+inline constexpr float kPlatoonDoubleShare[2] = {in_play_share(0, RATE_DOUBLE), in_play_share(1, RATE_DOUBLE)};
+inline constexpr float kPlatoonTripleShare[2] = {in_play_share(0, RATE_TRIPLE), in_play_share(1, RATE_TRIPLE)};
+
+// Ratings -> outcome probabilities. Pure function of the batter's contact/power/eye,
+// the pitcher's stuff/control/movement and the platoon matchup (0 or 1, see
+// platoon_same()), so it can be precomputed once per batter/pitcher pair (see MatchupTable).
+// `coefficients` is only ever overridden by calibration.
+OutcomeDistribution outcome_distribution(
+    float contact, float power, float eye,
+    float stuff, float control, float movement,
+    int same_hand,
+    const ResolveCoefficients& coefficients = kResolveCoefficients);
+
+inline OutcomeDistribution outcome_distribution(const Player& batter, const Player& pitcher) {
+    const auto& bat = batter.batterRatings.current;
+    const auto& pit = pitcher.pitcherRatings.current;
+    return outcome_distribution(
+        bat.contact, bat.power, bat.eye, pit.stuff, pit.control, pit.movement,
+        platoon_same(batter.bats, pitcher.throws));
+}
+
+// The same ratings model with no platoon split: league-rate walk / K / HR
+// levels and the overall league in-play mix for every matchup.
+OutcomeDistribution neutral_outcome_distribution(
+    float contact, float power, float eye,
+    float stuff, float control, float movement,
+    const ResolveCoefficients& coefficients = kResolveCoefficients);
+
+// League-average rates as thresholds: ratings ignored.
+constexpr OutcomeDistribution league_outcome_distribution(const OutcomeRates& rates) {
+    OutcomeDistribution dist{};
+    for (std::size_t i = 0; i + 1 < kNumPlateAppearanceResults; ++i) dist.cumulative[i] = rates.cumulative[i];
+    return dist;
+}
+
+// Maps a uniform draw in [0, 1) onto an outcome. Thresholds are monotone, so the
+// outcome index is just the number of thresholds at or below u.
+inline PlateAppearanceResult sample_outcome(const OutcomeDistribution& dist, float u) {
+    int idx = 0;
+    for (std::size_t i = 0; i < kNumPlateAppearanceResults - 1; ++i) {
+        idx += (u >= dist.cumulative[i]);
+    }
+    return static_cast<PlateAppearanceResult>(idx);
+}
+
+using OutcomeAliasTable = AliasTable<kNumPlateAppearanceResults>;
+
+inline OutcomeAliasTable make_alias_table(const OutcomeDistribution& dist) {
+    float probs[kNumPlateAppearanceResults];
+    outcome_probabilities(dist, probs);
+    return OutcomeAliasTable(probs);
+}
+
+// Alias-method draw: same distribution as the threshold scan, but a given u maps
+// to a different outcome, so the two are not interchangeable mid-stream.
+inline PlateAppearanceResult sample_outcome(const OutcomeAliasTable& table, float u) {
+    return static_cast<PlateAppearanceResult>(table.sample(u));
+}
+
+// Feature policies for BasicPlateAppearance and MatchupTable (and so
+// SeasonSimulator), picked at compile time so each configuration builds only
+// the path it uses.
+//
+// Outcome model source:
+struct RatingsOutcomes {};  // outcome_distribution() from the two players' ratings
+struct LeagueOutcomes {};   // league-average rates; ratings are never read
+// Platoon handling:
+struct PlatoonSplit {};     // by platoon_same(batter.bats, pitcher.throws)
+struct NoPlatoon {};        // every matchup as the overall league
+
+// One pair's distribution under the policies, from raw ratings (same_hand as
+// platoon_same()); the form MatchupTable builds its entries with.
+template <typename Outcomes, typename Platoon>
+OutcomeDistribution matchup_distribution(
+    float contact, float power, float eye, float stuff, float control, float movement, int same_hand) {
+    static_assert(std::is_same_v<Outcomes, RatingsOutcomes> || std::is_same_v<Outcomes, LeagueOutcomes>,
+                  "unknown outcome source");
+    static_assert(std::is_same_v<Platoon, PlatoonSplit> || std::is_same_v<Platoon, NoPlatoon>, "unknown platoon policy");
+    constexpr bool split = std::is_same_v<Platoon, PlatoonSplit>;
+    if constexpr (std::is_same_v<Outcomes, LeagueOutcomes>) {
+        if constexpr (split) {
+            return league_outcome_distribution(kPlatoonOutcomeRates[same_hand]);
+        } else {
+            return league_outcome_distribution(kLeagueOutcomeRates);
+        }
+    } else if constexpr (split) {
+        return outcome_distribution(contact, power, eye, stuff, control, movement, same_hand);
+    } else {
+        return neutral_outcome_distribution(contact, power, eye, stuff, control, movement);
+    }
+}
+
+using MatchupDistribution = OutcomeDistribution (*)(float, float, float, float, float, float, int);
+
+template <typename Outcomes, typename Platoon>
+OutcomeDistribution matchup_distribution(const Player& batter, const Player& pitcher) {
+    const auto& bat = batter.batterRatings.current;
+    const auto& pit = pitcher.pitcherRatings.current;
+    return matchup_distribution<Outcomes, Platoon>(
+        bat.contact, bat.power, bat.eye, pit.stuff, pit.control, pit.movement,
+        platoon_same(batter.bats, pitcher.throws));
+}
+
+// One PA between two players. The policies only decide how the distribution is
+// built; resolving is the same single draw for every configuration.
+template <typename Outcomes = RatingsOutcomes, typename Platoon = PlatoonSplit>
+class BasicPlateAppearance {
 public:
-    PlateAppearance(
-        const Player& batter,
-        const Player& pitcher,
-        RNG& rng);
+    BasicPlateAppearance(const Player& batter, const Player& pitcher, RNG& rng)
+        : dist_(matchup_distribution<Outcomes, Platoon>(batter, pitcher)), rng_(&rng) {}
 
-    PlateAppearanceResult resolve();
+    // Fast path: distribution already looked up from a MatchupTable.
+    BasicPlateAppearance(const OutcomeDistribution& dist, RNG& rng) : dist_(dist), rng_(&rng) {}
+
+    const OutcomeDistribution& distribution() const { return dist_; }
+
+    PlateAppearanceResult resolve() {
+        THREEUP3DOWN_COUNT(PLATE_APPEARANCES);
+        return sample_outcome(dist_, rng_->uniform());
+    }
 
 private:
-    const Player* batter_;
-    const Player* pitcher_;
+    OutcomeDistribution dist_;
     RNG* rng_;
 };
+
+// The full-ratings, platoon-split configuration the rest of the engine uses.
+using PlateAppearance = BasicPlateAppearance<>;
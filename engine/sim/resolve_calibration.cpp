@@ -0,0 +1,232 @@
+#include "engine/sim/resolve_calibration.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+// Differential-evolution step size and crossover rate; the usual defaults.
+constexpr double kStep = 0.5;
+constexpr double kCrossover = 0.9;
+
+std::size_t pick(RNG& rng, std::size_t n) {
+    return std::min(static_cast<std::size_t>(rng.uniform() * static_cast<float>(n)), n - 1);
+}
+
+bool valid(const ResolveCoefficients& c) {
+    for (std::size_t lo = COEF_WALK_MIN; lo <= COEF_IN_PLAY_MIN; lo += 2) {
+        if (!(c[lo] >= 0.0f && c[lo] < c[lo + 1])) return false;
+    }
+    return c[COEF_IN_PLAY_MAX] <= 1.0f;
+}
+
+double prior(const ResolveCoefficients& c, const ResolveCoefficients& start) {
+    double sum = 0.0;
+    for (std::size_t i = 0; i < kNumResolveCoefficients; ++i) {
+        const double d = (static_cast<double>(c[i]) - start[i]) / start[i];
+        sum += d * d;
+    }
+    return sum;
+}
+
+// Shortest decimal that reads back as exactly `v`.
+std::string round_trip(float v) {
+    char buf[32];
+    for (int digits = 6; digits <= 9; ++digits) {
+        std::snprintf(buf, sizeof(buf), "%.*g", digits, static_cast<double>(v));
+        if (std::strtof(buf, nullptr) == v) break;
+    }
+    return buf;
+}
+
+}  // namespace
+
+CalibrationPopulation calibration_population(const RosterStore& roster) {
+    CalibrationPopulation p;
+    for (PlayerId id = 0; id < roster.size(); ++id) {
+        const Player& player = roster.player(id);
+        if (player.is_pitcher) {
+            p.stuff.push_back(roster.stuff()[id]);
+            p.control.push_back(roster.control()[id]);
+            p.movement.push_back(roster.movement()[id]);
+        }
+        if (!player.is_pitcher || player.is_two_way_player) {
+            p.contact.push_back(roster.contact()[id]);
+            p.power.push_back(roster.power()[id]);
+            p.eye.push_back(roster.eye()[id]);
+        }
+    }
+    return p;
+}
+
+ResolveCalibration::ResolveCalibration(const CalibrationPopulation& population, CalibrationOptions options)
+    : options_(options) {
+    const std::size_t batters = population.contact.size();
+    const std::size_t pitchers = population.stuff.size();
+    if (batters == 0 || pitchers == 0 || population.power.size() != batters || population.eye.size() != batters ||
+        population.control.size() != pitchers || population.movement.size() != pitchers) {
+        throw std::invalid_argument("calibration needs at least one batter and one pitcher with all ratings");
+    }
+    if (options_.pairs == 0 || options_.draws_per_pair == 0 || options_.candidates < 4) {
+        throw std::invalid_argument("calibration needs pairs, draws and at least 4 candidates");
+    }
+
+    const std::size_t per_side = options_.pairs * options_.draws_per_pair;
+    for (auto* v : {&contact_, &power_, &eye_, &stuff_, &control_, &movement_, &uniforms_}) v->resize(2 * per_side);
+    same_hand_.resize(2 * per_side);
+    RNG rng(options_.seed, 0);
+    for (std::size_t p = 0; p < options_.pairs; ++p) {
+        const std::size_t b = pick(rng, batters);
+        const std::size_t m = pick(rng, pitchers);
+        for (std::size_t side = 0; side < 2; ++side) {
+            // Jittered strata: draw j falls in [j, j + 1) / draws.
+            const float jitter = rng.uniform();
+            for (std::size_t j = 0; j < options_.draws_per_pair; ++j) {
+                const std::size_t lane = side * per_side + p * options_.draws_per_pair + j;
+                contact_[lane] = population.contact[b];
+                power_[lane] = population.power[b];
+                eye_[lane] = population.eye[b];
+                stuff_[lane] = population.stuff[m];
+                control_[lane] = population.control[m];
+                movement_[lane] = population.movement[m];
+                same_hand_[lane] = static_cast<std::uint8_t>(side);
+                uniforms_[lane] = std::min((static_cast<float>(j) + jitter) / static_cast<float>(options_.draws_per_pair),
+                                           std::nextafter(1.0f, 0.0f));
+            }
+        }
+    }
+    pool_ = std::make_unique<WorkStealingPool>(options_.threads);
+}
+
+ResolveCalibration::~ResolveCalibration() = default;
+
+void ResolveCalibration::rates(const ResolveCoefficients& coefficients, double (&out)[2][kNumOutcomeRates]) const {
+    std::vector<PlateAppearanceResult> scratch;
+    rates(coefficients, scratch, out);
+}
+
+void ResolveCalibration::rates(const ResolveCoefficients& coefficients, std::vector<PlateAppearanceResult>& scratch,
+                               double (&out)[2][kNumOutcomeRates]) const {
+    scratch.resize(uniforms_.size());
+    const PlateAppearanceBatch batch{
+        contact_.data(), power_.data(), eye_.data(),
+        stuff_.data(), control_.data(), movement_.data(),
+        same_hand_.data(), uniforms_.data(), uniforms_.size()
+    };
+    resolve_batch(batch, scratch.data(), options_.kernel, coefficients);
+    const std::size_t per_side = uniforms_.size() / 2;
+    for (std::size_t side = 0; side < 2; ++side) {
+        std::size_t counts[kNumOutcomeRates] = {};
+        for (std::size_t i = side * per_side; i < (side + 1) * per_side; ++i) ++counts[static_cast<std::size_t>(scratch[i])];
+        for (std::size_t k = 0; k < kNumOutcomeRates; ++k) {
+            out[side][k] = static_cast<double>(counts[k]) / static_cast<double>(per_side);
+        }
+    }
+}
+
+double ResolveCalibration::divergence(const ResolveCoefficients& coefficients) const {
+    std::vector<PlateAppearanceResult> scratch;
+    return divergence(coefficients, scratch);
+}
+
+double ResolveCalibration::divergence(
+    const ResolveCoefficients& coefficients, std::vector<PlateAppearanceResult>& scratch) const {
+    if (!valid(coefficients)) return std::numeric_limits<double>::infinity();
+    double model[2][kNumOutcomeRates];
+    rates(coefficients, scratch, model);
+    // Half a PA for an outcome the sample never resolved, so the log stays finite.
+    const double floor = 0.5 / static_cast<double>(uniforms_.size() / 2);
+    double sum = 0.0;
+    for (std::size_t side = 0; side < 2; ++side) {
+        const float* target = kPlatoonOutcomeRates[side].prob;
+        double total = 0.0;
+        for (std::size_t k = 0; k < kNumOutcomeRates; ++k) total += target[k];
+        for (std::size_t k = 0; k < kNumOutcomeRates; ++k) {
+            const double t = target[k] / total;
+            if (t > 0.0) sum += t * std::log(t / std::max(model[side][k], floor));
+        }
+    }
+    return sum;
+}
+
+CalibrationResult ResolveCalibration::fit(const ResolveCoefficients& start) {
+    const std::size_t n = options_.candidates;
+    ResolveCoefficients lo;
+    ResolveCoefficients hi;
+    for (std::size_t i = 0; i < kNumResolveCoefficients; ++i) {
+        const double scale = i < COEF_WALK_MIN || options_.fit_clamp_bounds ? options_.bound_scale : 0.0;
+        lo[i] = static_cast<float>(start[i] * (1.0 - scale));
+        hi[i] = static_cast<float>(start[i] * (1.0 + scale));
+    }
+    hi[COEF_IN_PLAY_MAX] = std::min(hi[COEF_IN_PLAY_MAX], 1.0f);
+
+    std::vector<std::vector<PlateAppearanceResult>> scratch(pool_->size());
+    std::vector<ResolveCoefficients> members(n, start);
+    std::vector<ResolveCoefficients> trials(n);
+    std::vector<double> loss(n);
+    std::vector<double> trial_loss(n);
+    const auto score = [&](const std::vector<ResolveCoefficients>& candidates, std::vector<double>& out) {
+        pool_->parallel_for(n, [&](std::size_t worker, std::size_t i) {
+            out[i] = divergence(candidates[i], scratch[worker]) + options_.prior_weight * prior(candidates[i], start);
+        });
+    };
+
+    RNG rng(options_.seed, 1);
+    for (std::size_t m = 1; m < n; ++m) {
+        for (std::size_t i = 0; i < kNumResolveCoefficients; ++i) members[m][i] = lo[i] + (hi[i] - lo[i]) * rng.uniform();
+    }
+    score(members, loss);
+
+    CalibrationResult result;
+    result.start_loss = loss[0];
+    result.evaluations = n;
+    for (; result.generations < options_.max_generations; ++result.generations) {
+        const auto [best, worst] = std::minmax_element(loss.begin(), loss.end());
+        if (*worst - *best <= options_.tolerance) break;
+        for (std::size_t m = 0; m < n; ++m) {
+            std::size_t a, b, c;
+            do a = pick(rng, n); while (a == m);
+            do b = pick(rng, n); while (b == m || b == a);
+            do c = pick(rng, n); while (c == m || c == a || c == b);
+            const std::size_t forced = pick(rng, kNumResolveCoefficients);
+            for (std::size_t i = 0; i < kNumResolveCoefficients; ++i) {
+                float v = members[m][i];
+                if (i == forced || rng.uniform() < kCrossover) {
+                    v = static_cast<float>(members[a][i] + kStep * (static_cast<double>(members[b][i]) - members[c][i]));
+                }
+                trials[m][i] = std::clamp(v, lo[i], hi[i]);
+            }
+        }
+        score(trials, trial_loss);
+        result.evaluations += n;
+        for (std::size_t m = 0; m < n; ++m) {
+            if (trial_loss[m] <= loss[m]) {
+                members[m] = trials[m];
+                loss[m] = trial_loss[m];
+            }
+        }
+    }
+
+    const std::size_t best = static_cast<std::size_t>(std::min_element(loss.begin(), loss.end()) - loss.begin());
+    result.coefficients = members[best];
+    result.loss = loss[best];
+    rates(result.coefficients, scratch[0], result.rates);
+    return result;
+}
+
+void write_resolve_coefficients_json(const ResolveCoefficients& coefficients, const std::string& path) {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) throw std::runtime_error("coefficients path " + path + ": cannot open for writing");
+    out << "{\n";
+    for (std::size_t i = 0; i < kNumResolveCoefficients; ++i) {
+        out << "  \"" << kResolveCoefficientNames[i] << "\": " << round_trip(coefficients[i])
+            << (i + 1 < kNumResolveCoefficients ? ",\n" : "\n");
+    }
+    out << "}\n";
+    if (!out) throw std::runtime_error("coefficients path " + path + ": write failed");
+}
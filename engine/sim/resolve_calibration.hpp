@@ -0,0 +1,97 @@
+#pragma once
+
+#include "engine/core/thread_pool.hpp"
+#include "engine/model/roster_store.hpp"
+#include "engine/sim/batch_resolver.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Ratings the league rates are averaged over: every batter faces every pitcher
+// with equal weight.
+struct CalibrationPopulation {
+    std::vector<float> contact, power, eye;         // batters
+    std::vector<float> stuff, control, movement;    // pitchers
+};
+
+// Pitchers from is_pitcher, batters from everyone else plus two-way players.
+CalibrationPopulation calibration_population(const RosterStore& roster);
+
+struct CalibrationOptions {
+    std::size_t pairs = 4096;          // batter/pitcher pairs sampled, each at both platoon sides
+    std::size_t draws_per_pair = 16;   // stratified uniforms per pair and side
+    std::size_t candidates = 40;       // differential-evolution population
+    std::size_t max_generations = 400;
+    double tolerance = 1e-10;          // stop once best and worst candidate losses are this close
+    double prior_weight = 1e-4;        // on the squared relative distance from the start
+    double bound_scale = 0.9;          // each coefficient stays within start * [1 - s, 1 + s]
+    // League means say little about the clamp bounds (in_play_max in particular
+    // just rescales walk / K / HR together), so by default they stay put.
+    bool fit_clamp_bounds = false;
+    std::uint64_t seed = 0;
+    std::size_t threads = 0;           // 0: hardware_concurrency
+    BatchKernel kernel = best_batch_kernel();
+};
+
+struct CalibrationResult {
+    ResolveCoefficients coefficients;
+    double loss = 0.0;
+    double start_loss = 0.0;
+    // Model league rates at the fit, [platoon_same][OutcomeRateIndex].
+    double rates[2][kNumOutcomeRates] = {};
+    std::size_t generations = 0;
+    std::size_t evaluations = 0;
+};
+
+// Fits the outcome_distribution() coefficients so the population's average
+// outcome rates match the league tables baked in from pa_outcome_rates*.json
+// (kPlatoonOutcomeRates, both platoon sides).
+//
+// A candidate is scored by running the fixed sample of PAs through
+// resolve_batch with it: the same ratings and uniforms every time (common
+// random numbers, stratified per pair), so the loss is deterministic and
+// differences between candidates are not sampling noise. The loss is the KL
+// divergence of the resolved outcome frequencies from the league rates, summed
+// over the two sides, plus prior_weight times the squared relative distance
+// from the starting coefficients: the league rates pin only a few degrees of
+// freedom, and the prior picks the fit nearest the hand-set shape.
+//
+// fit() runs differential evolution (rand/1/bin). Trial vectors come from one
+// seeded stream and each generation's trials are scored in parallel, so the
+// answer does not depend on the thread count. The start is in the initial
+// population, so the fit is never worse than it.
+class ResolveCalibration {
+public:
+    // Throws std::invalid_argument on an empty population or zero pairs / draws / candidates < 4.
+    ResolveCalibration(const CalibrationPopulation& population, CalibrationOptions options = CalibrationOptions());
+    ~ResolveCalibration();
+
+    // Resolved outcome frequencies over the sample, [platoon_same][OutcomeRateIndex].
+    void rates(const ResolveCoefficients& coefficients, double (&out)[2][kNumOutcomeRates]) const;
+
+    // Data term of the loss alone; infinity for coefficients with a clamp lower bound above its upper.
+    double divergence(const ResolveCoefficients& coefficients) const;
+
+    CalibrationResult fit(const ResolveCoefficients& start = kResolveCoefficients);
+
+    std::size_t sample_size() const { return uniforms_.size(); }
+
+private:
+    double divergence(const ResolveCoefficients& coefficients, std::vector<PlateAppearanceResult>& scratch) const;
+    void rates(const ResolveCoefficients& coefficients, std::vector<PlateAppearanceResult>& scratch,
+               double (&out)[2][kNumOutcomeRates]) const;
+
+    CalibrationOptions options_;
+    // One lane per (side, pair, draw), sides outermost.
+    std::vector<float> contact_, power_, eye_, stuff_, control_, movement_, uniforms_;
+    std::vector<std::uint8_t> same_hand_;
+    std::unique_ptr<WorkStealingPool> pool_;
+};
+
+// Writes `coefficients` as baseball_stats/resolve_coefficients.json does (names
+// from kResolveCoefficientNames, values that round-trip exactly to the float).
+// Throws std::runtime_error if the file can't be written.
+void write_resolve_coefficients_json(const ResolveCoefficients& coefficients, const std::string& path);
@@ -0,0 +1,139 @@
+#include "engine/sim/run_expectancy.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+// Upper bound on PAs in one half-inning; live mass is ~1e-13 long before this.
+constexpr int kMaxLevels = 3 + 3 + static_cast<int>(kMaxInningRuns) + 40;
+constexpr double kLiveMassEpsilon = 1e-15;
+
+int runners(unsigned base_out) {
+    const unsigned bases = base_out_bases(base_out);
+    return static_cast<int>((bases & 1u) + ((bases >> 1) & 1u) + ((bases >> 2) & 1u));
+}
+
+std::array<OutcomeDistribution, kLineupSize> lineup_distributions(
+    const MatchupTable& table, const GameLineup& batting, std::uint32_t pitcher) {
+    std::array<OutcomeDistribution, kLineupSize> slots;
+    for (std::size_t s = 0; s < kLineupSize; ++s) slots[s] = table.at(batting.batters[s], pitcher);
+    return slots;
+}
+
+}  // namespace
+
+RunExpectancySolver::RunExpectancySolver(const std::array<OutcomeDistribution, kLineupSize>& slots) {
+    for (std::size_t s = 0; s < kLineupSize; ++s) {
+        float p[kNumPlateAppearanceResults];
+        outcome_probabilities(slots[s], p);
+        // Renormalize in double so float rounding doesn't leak mass every PA.
+        double total = 0.0;
+        for (float v : p) total += v;
+        for (std::size_t k = 0; k < kNumPlateAppearanceResults; ++k) probs_[s][k] = p[k] / total;
+    }
+    for (std::size_t s = 0; s < kLineupSize; ++s) innings_[s] = from_state(0, s);
+}
+
+RunExpectancySolver::RunExpectancySolver(const MatchupTable& table, const GameLineup& batting, std::uint32_t pitcher)
+    : RunExpectancySolver(lineup_distributions(table, batting, pitcher)) {}
+
+InningDistribution RunExpectancySolver::from_state(unsigned base_out, std::size_t slot) const {
+    if (base_out >= kNumBaseOutStates || slot >= kLineupSize) {
+        throw std::invalid_argument("RunExpectancySolver: state out of range");
+    }
+    InningDistribution out{};
+    // After t PAs, runs = t + (outs + runners at the start) - (outs + runners now).
+    const int start = static_cast<int>(base_out_outs(base_out)) + runners(base_out);
+    double mass[kNumBaseOutStates] = {};
+    double next[kNumBaseOutStates];
+    mass[base_out] = 1.0;
+    double live = 1.0;
+    for (int t = 0; t < kMaxLevels && live > kLiveMassEpsilon; ++t) {
+        const double* p = probs_[(slot + t) % kLineupSize];
+        const std::size_t leadoff = (slot + t + 1) % kLineupSize;
+        std::fill(std::begin(next), std::end(next), 0.0);
+        live = 0.0;
+        for (unsigned s = 0; s < kNumBaseOutStates; ++s) {
+            const double m = mass[s];
+            if (m == 0.0) continue;
+            const int runs_so_far = t + start - static_cast<int>(base_out_outs(s)) - runners(s);
+            for (std::size_t k = 0; k < kNumPlateAppearanceResults; ++k) {
+                const BaseOutTransition tr = kBaseOutTransitions[s][k];
+                const double q = m * p[k];
+                if (base_out_outs(tr.next) < 3) {
+                    next[tr.next] += q;
+                    live += q;
+                } else {
+                    const std::size_t r = std::min<std::size_t>(runs_so_far + tr.runs, kMaxInningRuns);
+                    out.joint[r][leadoff] += q;
+                }
+            }
+        }
+        std::copy(std::begin(next), std::end(next), std::begin(mass));
+    }
+    out.truncated = live;
+    for (std::size_t r = 0; r <= kMaxInningRuns; ++r) {
+        for (std::size_t s = 0; s < kLineupSize; ++s) {
+            out.runs[r] += out.joint[r][s];
+            out.next_leadoff[s] += out.joint[r][s];
+        }
+        out.expected_runs += static_cast<double>(r) * out.runs[r];
+    }
+    return out;
+}
+
+double RunExpectancySolver::expected_runs(int innings, std::size_t leadoff) const {
+    // Only the leadoff slot carries over between innings, so chaining its
+    // distribution is enough for the mean.
+    double lead[kLineupSize] = {};
+    lead[leadoff] = 1.0;
+    double total = 0.0;
+    for (int i = 0; i < innings; ++i) {
+        double next[kLineupSize] = {};
+        for (std::size_t s = 0; s < kLineupSize; ++s) {
+            if (lead[s] == 0.0) continue;
+            const InningDistribution& inn = innings_[s];
+            total += lead[s] * inn.expected_runs;
+            for (std::size_t n = 0; n < kLineupSize; ++n) next[n] += lead[s] * inn.next_leadoff[n];
+        }
+        std::copy(std::begin(next), std::end(next), std::begin(lead));
+    }
+    return total;
+}
+
+std::vector<double> RunExpectancySolver::game_runs(int innings, std::size_t leadoff) const {
+    // State is (leadoff slot, runs so far); runs and the next leadoff are
+    // correlated within an inning, hence the joint table.
+    std::vector<double> cur(kLineupSize * (kMaxGameRuns + 1), 0.0);
+    std::vector<double> next(cur.size());
+    cur[leadoff * (kMaxGameRuns + 1)] = 1.0;
+    for (int i = 0; i < innings; ++i) {
+        std::fill(next.begin(), next.end(), 0.0);
+        for (std::size_t s = 0; s < kLineupSize; ++s) {
+            const InningDistribution& inn = innings_[s];
+            for (std::size_t have = 0; have <= kMaxGameRuns; ++have) {
+                const double m = cur[s * (kMaxGameRuns + 1) + have];
+                if (m == 0.0) continue;
+                for (std::size_t r = 0; r <= kMaxInningRuns; ++r) {
+                    const std::size_t total = std::min(have + r, kMaxGameRuns);
+                    for (std::size_t n = 0; n < kLineupSize; ++n) {
+                        next[n * (kMaxGameRuns + 1) + total] += m * inn.joint[r][n];
+                    }
+                }
+            }
+        }
+        cur.swap(next);
+    }
+    std::vector<double> runs(kMaxGameRuns + 1, 0.0);
+    for (std::size_t s = 0; s < kLineupSize; ++s) {
+        for (std::size_t r = 0; r <= kMaxGameRuns; ++r) runs[r] += cur[s * (kMaxGameRuns + 1) + r];
+    }
+    return runs;
+}
+
+std::array<double, kNumBaseOutStates> RunExpectancySolver::run_expectancy(std::size_t slot) const {
+    std::array<double, kNumBaseOutStates> re{};
+    for (unsigned s = 0; s < kNumBaseOutStates; ++s) re[s] = from_state(s, slot).expected_runs;
+    return re;
+}
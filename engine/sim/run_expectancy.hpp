@@ -0,0 +1,62 @@
+#pragma once
+
+#include "engine/model/team.hpp"
+#include "engine/sim/game.hpp"
+#include "engine/sim/game_state.hpp"
+#include "engine/sim/matchup_table.hpp"
+#include "engine/sim/plate_appearence.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Run buckets per half-inning; the last one is "this many or more".
+constexpr std::size_t kMaxInningRuns = 40;
+// Run buckets per game; the last one is "this many or more".
+constexpr std::size_t kMaxGameRuns = 80;
+
+// Exact rest-of-half-inning outcome from some base-out state and batter due up.
+struct InningDistribution {
+    double joint[kMaxInningRuns + 1][kLineupSize];  // P(runs = r, slot s leads off next inning)
+    double runs[kMaxInningRuns + 1];
+    double next_leadoff[kLineupSize];
+    double expected_runs;
+    double truncated;  // mass still in play when the solver stopped (~1e-13)
+};
+
+// Markov-chain alternative to simulate_half_inning / simulate_game for one lineup
+// against one pitcher: exact run distributions instead of sampled ones.
+//
+// Base running is the kBaseOutTransitions table the game loop uses. Every PA
+// either records an out or adds exactly one to runners-on-base + runs-scored, so
+// after t PAs the runs so far are implied by the base-out state; each step is
+// therefore just 24 states x 8 outcomes, and a whole half-inning takes a few
+// thousand flops.
+class RunExpectancySolver {
+public:
+    // One outcome distribution per lineup slot.
+    explicit RunExpectancySolver(const std::array<OutcomeDistribution, kLineupSize>& slots);
+
+    // The same distributions the game loop draws from.
+    RunExpectancySolver(const MatchupTable& table, const GameLineup& batting, std::uint32_t pitcher);
+
+    // From an empty 0-out inning with `leadoff` up (cached).
+    const InningDistribution& half_inning(std::size_t leadoff) const { return innings_[leadoff]; }
+
+    // From any live base-out state (see base_out_index()) with `slot` up.
+    InningDistribution from_state(unsigned base_out, std::size_t slot) const;
+
+    // Expected runs over `innings` innings with `leadoff` batting first.
+    double expected_runs(int innings = 9, std::size_t leadoff = 0) const;
+
+    // Run distribution over `innings` innings (kMaxGameRuns + 1 buckets).
+    std::vector<double> game_runs(int innings = 9, std::size_t leadoff = 0) const;
+
+    // RE24: expected rest-of-inning runs for each base-out state with `slot` up.
+    std::array<double, kNumBaseOutStates> run_expectancy(std::size_t slot) const;
+
+private:
+    double probs_[kLineupSize][kNumPlateAppearanceResults];
+    std::array<InningDistribution, kLineupSize> innings_;
+};
@@ -0,0 +1,81 @@
+#include "engine/sim/scenario_comparison.hpp"
+
+#include "engine/core/thread_pool.hpp"
+
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+
+namespace {
+
+// values[s][rep * teams + t]: what replication rep added for team t in scenario s.
+std::vector<ScenarioDifference> summarize(
+    const std::vector<double> (&values)[2], std::size_t replications, std::size_t teams) {
+    std::vector<ScenarioDifference> out(teams);
+    for (std::size_t t = 0; t < teams; ++t) {
+        RunningStats a;
+        RunningStats b;
+        RunningStats diff;  // one per replication
+        for (std::size_t r = 0; r < replications; ++r) {
+            a.add(values[0][r * teams + t]);
+            b.add(values[1][r * teams + t]);
+            diff.add(values[1][r * teams + t] - values[0][r * teams + t]);
+        }
+        ScenarioDifference& s = out[t];
+        s.a_mean = a.mean();
+        s.b_mean = b.mean();
+        s.difference = diff.mean();
+        const double paired = diff.variance() / static_cast<double>(diff.count());
+        const double independent = (a.variance() + b.variance()) / static_cast<double>(replications);
+        s.standard_error = std::sqrt(paired);
+        s.variance_reduction = paired > 0.0 ? independent / paired
+                                            : (independent > 0.0 ? std::numeric_limits<double>::infinity() : 1.0);
+    }
+    return out;
+}
+
+}  // namespace
+
+ScenarioComparison compare_seasons(const SeasonSimulator& a, const SeasonSimulator& b, const SeasonConfig& config) {
+    const std::vector<ScheduledGame>& schedule = a.schedule();
+    bool same_league = a.num_teams() == b.num_teams() && schedule.size() == b.schedule().size();
+    for (std::size_t g = 0; same_league && g < schedule.size(); ++g) {
+        same_league = schedule[g].home == b.schedule()[g].home && schedule[g].away == b.schedule()[g].away;
+    }
+    if (!same_league) {
+        throw std::invalid_argument("compare_seasons: scenarios need the same teams and schedule");
+    }
+    const SeasonSimulator* sims[2] = {&a, &b};
+    const SeasonResults shapes[2] = {a.empty_results(), b.empty_results()};
+    const std::size_t teams = a.num_teams();
+    const std::size_t n = config.replications;
+
+    WorkStealingPool pool(config.threads);
+    std::vector<double> wins[2] = {std::vector<double>(n * teams), std::vector<double>(n * teams)};
+    std::vector<double> runs[2] = {std::vector<double>(n * teams), std::vector<double>(n * teams)};
+    std::unique_ptr<Arena[]> scratch(new Arena[pool.size()]);
+    // Both scenarios of a replication run back to back on one worker, off the same
+    // (seed, replication) streams; each replication is its own fold leaf, so what
+    // it added is read straight off it.
+    ReplicationFold folds[2];
+    fold_replications(pool, n, folds, 2, [&](std::size_t worker, std::size_t rep, ReplicationFold* chunk) {
+        for (int s = 0; s < 2; ++s) {
+            SeasonResults results = chunk[s].fresh(shapes[s]);
+            sims[s]->simulate_replication(config.seed, rep, results, nullptr, &scratch[worker], config.player_lines);
+            for (std::size_t t = 0; t < teams; ++t) {
+                wins[s][rep * teams + t] = static_cast<double>(results.teams[t].wins);
+                runs[s][rep * teams + t] = static_cast<double>(results.teams[t].runs_scored);
+            }
+            chunk[s].push({rep, 0, std::move(results)});
+        }
+    });
+
+    ScenarioComparison out;
+    out.replications = n;
+    out.wins = summarize(wins, n, teams);
+    out.runs_scored = summarize(runs, n, teams);
+    out.a = folds[0].result(shapes[0]);
+    out.b = folds[1].result(shapes[1]);
+    return out;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "engine/sim/season_simulator.hpp"
+
+#include <cstddef>
+#include <vector>
+
+// One per-season quantity in both scenarios, and their difference.
+struct ScenarioDifference {
+    double a_mean = 0.0;
+    double b_mean = 0.0;
+    double difference = 0.0;      // b - a
+    double standard_error = 0.0;  // of `difference`, under the paired design
+    // Variance of an independent comparison (fresh streams per scenario) at the
+    // same number of replications over the variance of this one: how many times
+    // more replications independent runs would need.
+    double variance_reduction = 0.0;
+};
+
+struct ScenarioComparison {
+    std::size_t replications = 0;
+    std::vector<ScenarioDifference> wins;         // per team
+    std::vector<ScenarioDifference> runs_scored;  // per team
+    SeasonResults a;
+    SeasonResults b;
+};
+
+// What-if comparison of two leagues over the same teams and schedule (say,
+// before and after a trade, or two lineups for one club). Replication r of both
+// plays every game on the same stream (common random numbers), so luck that
+// would have hit both scenarios cancels in the difference. The
+// variance-reduction factors are estimated from the same replications: the
+// independent variance from each scenario's own spread, the paired one from the
+// spread of the per-replication differences. `a` and `b` are folded like
+// SeasonSimulator::run's, so they equal a.run(config) and b.run(config).
+// Throws std::invalid_argument if the leagues do not line up.
+ScenarioComparison compare_seasons(const SeasonSimulator& a, const SeasonSimulator& b, const SeasonConfig& config);
@@ -0,0 +1,229 @@
+#include "engine/sim/season_checkpoint.hpp"
+
+#include "engine/core/instrument.hpp"
+#include "engine/core/thread_pool.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+
+namespace {
+
+constexpr char kMagic[8] = {'3', 'U', '3', 'D', 'C', 'K', 'P', 'T'};
+constexpr std::uint32_t kVersion = 1;
+
+[[noreturn]] void fail(const std::string& path, const std::string& what) {
+    throw std::runtime_error("season checkpoint " + path + ": " + what);
+}
+
+template <typename T>
+void write_value(std::ofstream& out, const T& v) {
+    out.write(reinterpret_cast<const char*>(&v), sizeof(v));
+}
+
+template <typename T>
+void write_array(std::ofstream& out, const std::vector<T>& v) {
+    out.write(reinterpret_cast<const char*>(v.data()), static_cast<std::streamsize>(v.size() * sizeof(T)));
+}
+
+template <typename T>
+void read_value(std::ifstream& in, const std::string& path, T& v) {
+    if (!in.read(reinterpret_cast<char*>(&v), sizeof(v))) fail(path, "truncated");
+}
+
+template <typename T>
+void read_array(std::ifstream& in, const std::string& path, std::vector<T>& v, std::size_t n) {
+    v.resize(n);
+    if (!in.read(reinterpret_cast<char*>(v.data()), static_cast<std::streamsize>(n * sizeof(T)))) fail(path, "truncated");
+}
+
+// Top-`spots` credit for one replication's final win totals; ties for the last
+// spots share them.
+void add_playoff_credit(const std::vector<std::uint32_t>& wins, std::size_t spots, std::vector<double>& credit,
+                        std::vector<std::uint32_t>& sorted) {
+    if (spots >= wins.size()) {
+        for (double& c : credit) c += 1.0;
+        return;
+    }
+    if (spots == 0) return;
+    sorted = wins;
+    std::nth_element(sorted.begin(), sorted.begin() + (spots - 1), sorted.end(), std::greater<std::uint32_t>());
+    const std::uint32_t cutoff = sorted[spots - 1];
+    std::size_t above = 0;
+    std::size_t at = 0;
+    for (std::uint32_t w : wins) {
+        above += w > cutoff;
+        at += w == cutoff;
+    }
+    const double share = static_cast<double>(spots - above) / static_cast<double>(at);
+    for (std::size_t t = 0; t < wins.size(); ++t) {
+        if (wins[t] > cutoff) {
+            credit[t] += 1.0;
+        } else if (wins[t] == cutoff) {
+            credit[t] += share;
+        }
+    }
+}
+
+}  // namespace
+
+SeasonCheckpoint::SeasonCheckpoint(const SeasonSimulator& sim, std::uint64_t seed, std::size_t replications)
+    : seed_(seed),
+      replications_(replications),
+      schedule_(sim.schedule()),
+      standings_(sim.num_teams()),
+      played_(schedule_.size(), 0),
+      fingerprints_(schedule_.size(), kNotCached),
+      cache_(schedule_.size() * replications) {}
+
+std::size_t SeasonCheckpoint::games_played() const {
+    return static_cast<std::size_t>(std::count(played_.begin(), played_.end(), 1));
+}
+
+void SeasonCheckpoint::record_result(std::size_t game, int home_runs, int away_runs) {
+    if (game >= schedule_.size()) throw std::invalid_argument("season checkpoint: no scheduled game " + std::to_string(game));
+    if (played_[game]) throw std::invalid_argument("season checkpoint: game " + std::to_string(game) + " already recorded");
+    if (home_runs < 0 || away_runs < 0) throw std::invalid_argument("season checkpoint: negative score");
+    TeamStanding& home = standings_[schedule_[game].home];
+    TeamStanding& away = standings_[schedule_[game].away];
+    home.runs_scored += home_runs;
+    home.runs_allowed += away_runs;
+    away.runs_scored += away_runs;
+    away.runs_allowed += home_runs;
+    if (home_runs > away_runs) {
+        ++home.wins;
+        ++away.losses;
+    } else if (away_runs > home_runs) {
+        ++away.wins;
+        ++home.losses;
+    }
+    played_[game] = 1;
+    fingerprints_[game] = kNotCached;
+}
+
+SeasonProjection SeasonCheckpoint::project(const SeasonSimulator& sim, const ProjectionConfig& config) {
+    const std::vector<ScheduledGame>& schedule = sim.schedule();
+    bool same_schedule = sim.num_teams() == standings_.size() && schedule.size() == schedule_.size();
+    for (std::size_t g = 0; same_schedule && g < schedule.size(); ++g) {
+        same_schedule = schedule[g].home == schedule_[g].home && schedule[g].away == schedule_[g].away;
+    }
+    if (!same_schedule) throw std::invalid_argument("season checkpoint: simulator has different teams or schedule");
+
+    // Future games whose inputs changed since they were cached (or never were).
+    std::vector<std::size_t> remaining;
+    std::vector<std::size_t> stale;
+    std::vector<std::uint64_t> fresh;
+    for (std::size_t g = 0; g < schedule_.size(); ++g) {
+        if (played_[g]) continue;
+        remaining.push_back(g);
+        const std::uint64_t key = sim.game_fingerprint(g);
+        if (key != fingerprints_[g] || key == kNotCached) {
+            stale.push_back(g);
+            fresh.push_back(key);
+        }
+    }
+
+    const std::size_t teams = standings_.size();
+    WorkStealingPool pool(config.threads);
+    std::vector<std::vector<RunningStats>> wins_stats(pool.size(), std::vector<RunningStats>(teams));
+    std::vector<std::vector<double>> credit(pool.size(), std::vector<double>(teams, 0.0));
+    std::vector<std::vector<std::uint32_t>> wins(pool.size(), std::vector<std::uint32_t>(teams));
+    std::vector<std::vector<std::uint32_t>> sorted(pool.size());
+    pool.parallel_for(replications_, [&](std::size_t worker, std::size_t rep) {
+        for (std::size_t g : stale) {
+            THREEUP3DOWN_COUNT(CACHE_REBUILDS);
+            const GameResult r = sim.play_scheduled_game(seed_, rep, g);
+            cache_[g * replications_ + rep] = {static_cast<std::uint16_t>(r.home_runs), static_cast<std::uint16_t>(r.away_runs)};
+        }
+        std::vector<std::uint32_t>& w = wins[worker];
+        for (std::size_t t = 0; t < teams; ++t) w[t] = standings_[t].wins;
+        for (std::size_t g : remaining) {
+            const CachedGame& c = cache_[g * replications_ + rep];
+            // Ties only happen at the inning cap; they count for neither side.
+            if (c.home_runs > c.away_runs) {
+                ++w[schedule_[g].home];
+            } else if (c.away_runs > c.home_runs) {
+                ++w[schedule_[g].away];
+            }
+        }
+        for (std::size_t t = 0; t < teams; ++t) wins_stats[worker][t].add(w[t]);
+        add_playoff_credit(w, config.playoff_spots, credit[worker], sorted[worker]);
+    });
+    for (std::size_t i = 0; i < stale.size(); ++i) fingerprints_[stale[i]] = fresh[i];
+
+    SeasonProjection out;
+    out.replications = replications_;
+    out.final_wins.resize(teams);
+    out.playoff_odds.assign(teams, 0.0);
+    for (std::size_t w = 0; w < pool.size(); ++w) {
+        for (std::size_t t = 0; t < teams; ++t) {
+            out.final_wins[t].merge(wins_stats[w][t]);
+            out.playoff_odds[t] += credit[w][t];
+        }
+    }
+    for (double& odds : out.playoff_odds) odds = replications_ ? odds / static_cast<double>(replications_) : 0.0;
+    out.games_simulated = stale.size() * replications_;
+    out.games_reused = (remaining.size() - stale.size()) * replications_;
+    return out;
+}
+
+void SeasonCheckpoint::save(const std::string& path) const {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) fail(path, "cannot open for writing");
+    out.write(kMagic, sizeof(kMagic));
+    write_value(out, kVersion);
+    write_value(out, seed_);
+    write_value(out, static_cast<std::uint64_t>(replications_));
+    write_value(out, static_cast<std::uint64_t>(standings_.size()));
+    write_value(out, static_cast<std::uint64_t>(schedule_.size()));
+    write_array(out, schedule_);
+    write_array(out, standings_);
+    write_array(out, played_);
+    write_array(out, fingerprints_);
+    write_array(out, cache_);
+    if (!out) fail(path, "write failed");
+}
+
+SeasonCheckpoint SeasonCheckpoint::load(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) fail(path, "cannot open");
+    char magic[sizeof(kMagic)];
+    std::uint32_t version = 0;
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0) fail(path, "not a season checkpoint");
+    read_value(in, path, version);
+    if (version != kVersion) fail(path, "unsupported version " + std::to_string(version));
+    SeasonCheckpoint c;
+    std::uint64_t replications = 0;
+    std::uint64_t teams = 0;
+    std::uint64_t games = 0;
+    read_value(in, path, c.seed_);
+    read_value(in, path, replications);
+    read_value(in, path, teams);
+    read_value(in, path, games);
+    c.replications_ = static_cast<std::size_t>(replications);
+    // The counts come from the file: check they fit what is left of it before
+    // allocating for them. Dividing keeps an absurd count from overflowing.
+    const std::streamoff header = in.tellg();
+    in.seekg(0, std::ios::end);
+    auto left = static_cast<std::uint64_t>(in.tellg() - header);
+    in.seekg(header);
+    auto take = [&](std::uint64_t n, std::uint64_t each, std::size_t size) {  // n * each elements of `size` bytes
+        if (each != 0 && n > left / each / size) fail(path, "truncated");
+        left -= n * each * size;
+    };
+    take(games, 1, sizeof(ScheduledGame) + sizeof(c.played_[0]) + sizeof(c.fingerprints_[0]));
+    take(teams, 1, sizeof(TeamStanding));
+    take(games, replications, sizeof(c.cache_[0]));
+    read_array(in, path, c.schedule_, games);
+    read_array(in, path, c.standings_, teams);
+    read_array(in, path, c.played_, games);
+    read_array(in, path, c.fingerprints_, games);
+    read_array(in, path, c.cache_, games * replications);
+    for (const ScheduledGame& g : c.schedule_) {
+        if (g.home >= teams || g.away >= teams) fail(path, "schedule references an unknown team");
+    }
+    if (in.peek() != std::ifstream::traits_type::eof()) fail(path, "trailing bytes");
+    return c;
+}
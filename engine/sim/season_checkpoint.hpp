@@ -0,0 +1,87 @@
+#pragma once
+
+#include "engine/core/stats.hpp"
+#include "engine/sim/season_simulator.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// One team's real record so far.
+struct TeamStanding {
+    std::uint32_t wins = 0;
+    std::uint32_t losses = 0;
+    std::uint64_t runs_scored = 0;
+    std::uint64_t runs_allowed = 0;
+};
+
+struct ProjectionConfig {
+    std::size_t playoff_spots = 1;  // best records league-wide that make it
+    std::size_t threads = 0;        // 0 = all hardware threads
+};
+
+struct SeasonProjection {
+    std::size_t replications = 0;
+    std::vector<RunningStats> final_wins;  // per team: real wins plus simulated ones
+    // Per team: share of replications finishing in the top playoff_spots, with
+    // teams tied for the last spots splitting them.
+    std::vector<double> playoff_odds;
+    std::size_t games_simulated = 0;  // (game, replication) pairs played by this projection
+    std::size_t games_reused = 0;     // taken from the checkpoint's cache instead
+};
+
+// Mid-season state for nightly playoff odds: the real standings, which
+// scheduled games are done, and every replication's simulated result of every
+// game still to play.
+//
+// Game g of replication r always plays on game_rng(seed, r, g), so its stream
+// position is fixed by (seed, r, g) alone and nothing more needs saving. Each
+// cached game also keeps the SeasonSimulator::game_fingerprint() it was played
+// under: both lineups and staffs and, through the matchup table, their ratings.
+// A projection from a rebuilt simulator replays only the games whose
+// fingerprint changed (a trade, an injury, a ratings update) and reuses the
+// rest, so after a quiet day the nightly run is just the tally.
+class SeasonCheckpoint {
+public:
+    SeasonCheckpoint() = default;
+
+    // Start of the season: nothing played or cached. Memory is 4 bytes per
+    // (scheduled game, replication).
+    SeasonCheckpoint(const SeasonSimulator& sim, std::uint64_t seed, std::size_t replications);
+
+    // The real result of scheduled game `game`. Throws std::invalid_argument for
+    // an unknown or already recorded game.
+    void record_result(std::size_t game, int home_runs, int away_runs);
+
+    // Simulates the rest of the season `replications` times from the real
+    // standings, updating the cache. `sim` must have this checkpoint's teams and
+    // schedule (std::invalid_argument otherwise) but may have any rosters.
+    SeasonProjection project(const SeasonSimulator& sim, const ProjectionConfig& config = ProjectionConfig());
+
+    std::uint64_t seed() const { return seed_; }
+    std::size_t replications() const { return replications_; }
+    const std::vector<TeamStanding>& standings() const { return standings_; }
+    bool played(std::size_t game) const { return played_.at(game) != 0; }
+    std::size_t games_played() const;
+
+    // Throws std::runtime_error if the file can't be written / is missing or malformed.
+    void save(const std::string& path) const;
+    static SeasonCheckpoint load(const std::string& path);
+
+private:
+    struct CachedGame {
+        std::uint16_t home_runs;
+        std::uint16_t away_runs;
+    };
+
+    static constexpr std::uint64_t kNotCached = 0;
+
+    std::uint64_t seed_ = 0;
+    std::size_t replications_ = 0;
+    std::vector<ScheduledGame> schedule_;
+    std::vector<TeamStanding> standings_;
+    std::vector<std::uint8_t> played_;
+    std::vector<std::uint64_t> fingerprints_;  // per game: what its cached replays were played under
+    std::vector<CachedGame> cache_;            // [game * replications_ + replication]
+};
@@ -0,0 +1,440 @@
+#include "engine/sim/season_simulator.hpp"
+
+#include "engine/core/instrument.hpp"
+#include "engine/core/thread_pool.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+namespace {
+
+// Every distinct batter and pitcher across the league gets one MatchupTable row/column.
+struct LeagueIndex {
+    std::vector<PlayerId> batters;
+    std::vector<PlayerId> pitchers;
+    std::unordered_map<PlayerId, std::uint32_t> batter_rows;
+    std::unordered_map<PlayerId, std::uint32_t> pitcher_rows;
+
+    static std::uint32_t row(
+        PlayerId id, std::vector<PlayerId>& ids, std::unordered_map<PlayerId, std::uint32_t>& rows) {
+        auto it = rows.emplace(id, static_cast<std::uint32_t>(ids.size())).first;
+        if (it->second == ids.size()) ids.push_back(id);
+        return it->second;
+    }
+};
+
+LeagueIndex index_league(const RosterStore& roster, const std::vector<Team>& teams, std::vector<GameLineup>& lineups) {
+    LeagueIndex index;
+    lineups.resize(teams.size());
+    for (std::size_t t = 0; t < teams.size(); ++t) {
+        const Team& team = teams[t];
+        if (team.lineup.size() != kLineupSize) {
+            throw std::invalid_argument("team " + team.name + " needs a full lineup");
+        }
+        for (std::size_t s = 0; s < kLineupSize; ++s) {
+            if (team.lineup[s] >= roster.size()) throw std::invalid_argument("team " + team.name + " has an unknown batter");
+            lineups[t].batters[s] = LeagueIndex::row(team.lineup[s], index.batters, index.batter_rows);
+        }
+        if (team.starting_pitcher >= roster.size()) throw std::invalid_argument("team " + team.name + " has an unknown pitcher");
+        lineups[t].pitcher = LeagueIndex::row(team.starting_pitcher, index.pitchers, index.pitcher_rows);
+        if (team.bullpen.size() > kMaxBullpen) {
+            throw std::invalid_argument("team " + team.name + " has more than " + std::to_string(kMaxBullpen) + " relievers");
+        }
+        for (std::size_t r = 0; r < team.bullpen.size(); ++r) {
+            if (team.bullpen[r] >= roster.size()) throw std::invalid_argument("team " + team.name + " has an unknown reliever");
+            lineups[t].bullpen[r] = LeagueIndex::row(team.bullpen[r], index.pitchers, index.pitcher_rows);
+        }
+        lineups[t].bullpen_size = static_cast<std::uint8_t>(team.bullpen.size());
+    }
+    return index;
+}
+
+// Runs-per-game histogram: one-run bins, anything past the last in overflow.
+constexpr double kMaxHistogramGameRuns = 30.0;
+// Replications per work item in fold_replications(); a power of two so whole
+// chunks are single fold nodes.
+constexpr std::size_t kReplicationChunk = 16;
+
+// FNV-1a, for the fingerprints.
+struct Fnv1a {
+    std::uint64_t h = 0xcbf29ce484222325ULL;
+
+    void bytes(const void* data, std::size_t n) {
+        const auto* p = static_cast<const unsigned char*>(data);
+        for (std::size_t i = 0; i < n; ++i) h = (h ^ p[i]) * 0x100000001b3ULL;
+    }
+
+    template <typename T>
+    void value(const T& v) {
+        bytes(&v, sizeof(v));
+    }
+};
+
+double rate(std::uint64_t num, std::uint64_t den) {
+    return static_cast<double>(num) / static_cast<double>(den);
+}
+
+}  // namespace
+
+void SeasonResults::merge(const SeasonResults& other) {
+    replications += other.replications;
+    for (std::size_t t = 0; t < teams.size(); ++t) {
+        TeamSeasonTotals& mine = teams[t];
+        const TeamSeasonTotals& theirs = other.teams[t];
+        mine.wins += theirs.wins;
+        mine.losses += theirs.losses;
+        mine.runs_scored += theirs.runs_scored;
+        mine.runs_allowed += theirs.runs_allowed;
+        mine.pitches_thrown += theirs.pitches_thrown;
+        for (std::size_t w = 0; w < mine.win_histogram.size(); ++w) {
+            mine.win_histogram[w] += theirs.win_histogram[w];
+        }
+        mine.game_runs.merge(theirs.game_runs);
+        mine.season_wins.merge(theirs.season_wins);
+        mine.season_runs_scored.merge(theirs.season_runs_scored);
+    }
+    for (std::size_t b = 0; b < batters.size(); ++b) {
+        BatterSeasonTotals& mine = batters[b];
+        const BatterSeasonTotals& theirs = other.batters[b];
+        mine.line.merge(theirs.line);
+        mine.batting_average.merge(theirs.batting_average);
+        mine.on_base_pct.merge(theirs.on_base_pct);
+        mine.slugging.merge(theirs.slugging);
+        mine.strikeout_rate.merge(theirs.strikeout_rate);
+        mine.walk_rate.merge(theirs.walk_rate);
+    }
+    for (std::size_t p = 0; p < pitchers.size(); ++p) {
+        PitcherSeasonTotals& mine = pitchers[p];
+        const PitcherSeasonTotals& theirs = other.pitchers[p];
+        mine.against.merge(theirs.against);
+        mine.games_started += theirs.games_started;
+        mine.relief_appearances += theirs.relief_appearances;
+        mine.runs_allowed += theirs.runs_allowed;
+        mine.strikeout_rate.merge(theirs.strikeout_rate);
+        mine.walk_rate.merge(theirs.walk_rate);
+        mine.season_runs_allowed.merge(theirs.season_runs_allowed);
+    }
+}
+
+void ReplicationFold::push(Node node) {
+    if (node.first != end_ || node.level >= 64 || node.first % (std::size_t{1} << node.level) != 0) {
+        throw std::invalid_argument(
+            "ReplicationFold: node at " + std::to_string(node.first) + " (level " + std::to_string(node.level) +
+            ") does not continue at " + std::to_string(end_));
+    }
+    end_ = node.first + (std::size_t{1} << node.level);
+    pending_.push_back(std::move(node));
+    // Close every node whose two halves are now both here.
+    while (pending_.size() >= 2) {
+        Node& left = pending_[pending_.size() - 2];
+        Node& right = pending_.back();
+        if (left.level != right.level || left.first % (std::size_t{2} << left.level) != 0) break;
+        left.results.merge(right.results);
+        ++left.level;
+        spare_.push_back(std::move(right.results));
+        pending_.pop_back();
+    }
+}
+
+SeasonResults ReplicationFold::fresh(const SeasonResults& shape) {
+    if (spare_.empty()) return shape;
+    SeasonResults results = std::move(spare_.back());
+    spare_.pop_back();
+    results = shape;  // same sizes, so no reallocation
+    return results;
+}
+
+std::vector<ReplicationFold::Node> ReplicationFold::release() {
+    std::vector<Node> nodes = std::move(pending_);
+    pending_.clear();
+    return nodes;
+}
+
+SeasonResults ReplicationFold::result(const SeasonResults& shape) {
+    if (pending_.empty()) return shape;
+    SeasonResults total = std::move(pending_.front().results);
+    for (std::size_t i = 1; i < pending_.size(); ++i) total.merge(pending_[i].results);
+    pending_.clear();
+    return total;
+}
+
+void fold_replications(
+    WorkStealingPool& pool, std::size_t count, ReplicationFold* folds, std::size_t num_folds,
+    const std::function<void(std::size_t, std::size_t, ReplicationFold*)>& play) {
+    if (count == 0 || num_folds == 0) return;
+    const std::size_t first = folds[0].end();
+    const std::size_t end = first + count;
+    const std::size_t first_chunk = first / kReplicationChunk;
+    const std::size_t chunks = (end - 1) / kReplicationChunk + 1 - first_chunk;
+    // A window of chunks at a time, a few per worker so stealing can balance them.
+    const std::size_t window = 4 * pool.size();
+    std::vector<ReplicationFold> chunk_folds(std::min(window, chunks) * num_folds);
+    for (std::size_t begin = 0; begin < chunks; begin += window) {
+        const std::size_t n = std::min(window, chunks - begin);
+        pool.parallel_for(n, [&](std::size_t worker, std::size_t i) {
+            const std::size_t chunk = first_chunk + begin + i;
+            const std::size_t lo = std::max(first, chunk * kReplicationChunk);
+            const std::size_t hi = std::min(end, (chunk + 1) * kReplicationChunk);
+            ReplicationFold* local = &chunk_folds[i * num_folds];
+            for (std::size_t k = 0; k < num_folds; ++k) local[k] = ReplicationFold(lo);
+            for (std::size_t rep = lo; rep < hi; ++rep) play(worker, rep, local);
+        });
+        for (std::size_t i = 0; i < n; ++i) {
+            for (std::size_t k = 0; k < num_folds; ++k) {
+                for (ReplicationFold::Node& node : chunk_folds[i * num_folds + k].release()) folds[k].push(std::move(node));
+            }
+        }
+    }
+}
+
+void add_replication_lines(
+    SeasonResults& results, const std::uint32_t* wins, const std::uint64_t* runs, const BattingLine* batting,
+    const BattingLine* pitching) {
+    for (std::size_t t = 0; t < results.teams.size(); ++t) {
+        TeamSeasonTotals& team = results.teams[t];
+        ++team.win_histogram[wins[t]];
+        team.season_wins.add(wins[t]);
+        team.season_runs_scored.add(static_cast<double>(runs[t]));
+    }
+    for (std::size_t b = 0; batting && b < results.batters.size(); ++b) {
+        const BattingLine& line = batting[b];
+        const std::uint64_t pa = line.plate_appearances();
+        if (pa == 0) continue;
+        BatterSeasonTotals& totals = results.batters[b];
+        totals.line.merge(line);
+        totals.on_base_pct.add(rate(line.times_on_base(), pa));
+        totals.strikeout_rate.add(rate(line.count(PlateAppearanceResult::STRIKEOUT), pa));
+        totals.walk_rate.add(rate(line.count(PlateAppearanceResult::WALK), pa));
+        const std::uint64_t ab = line.at_bats();
+        if (ab > 0) {
+            totals.batting_average.add(rate(line.hits(), ab));
+            totals.slugging.add(rate(line.total_bases(), ab));
+        }
+    }
+    for (std::size_t p = 0; pitching && p < results.pitchers.size(); ++p) {
+        const BattingLine& against = pitching[p];
+        const std::uint64_t faced = against.plate_appearances();
+        if (faced == 0) continue;
+        PitcherSeasonTotals& totals = results.pitchers[p];
+        totals.against.merge(against);
+        totals.runs_allowed += against.runs_batted_in;
+        totals.strikeout_rate.add(rate(against.count(PlateAppearanceResult::STRIKEOUT), faced));
+        totals.walk_rate.add(rate(against.count(PlateAppearanceResult::WALK), faced));
+        totals.season_runs_allowed.add(static_cast<double>(against.runs_batted_in));
+    }
+    ++results.replications;
+}
+
+SeasonSimulator::SeasonSimulator(
+    const RosterStore& roster,
+    const std::vector<Team>& teams,
+    std::vector<ScheduledGame> schedule,
+    SimulationMode mode,
+    const FatigueModel& fatigue,
+    MatchupDistribution distribution)
+    : schedule_(std::move(schedule)),
+      // lineups_ and the id lists are declared (and so constructed) before table_;
+      // indexing fills them in.
+      table_([&] {
+          LeagueIndex index = index_league(roster, teams, lineups_);
+          batter_ids_ = std::move(index.batters);
+          pitcher_ids_ = std::move(index.pitchers);
+          return MatchupTable(roster, batter_ids_, pitcher_ids_, fatigue, distribution);
+      }()) {
+    if (mode == SimulationMode::PITCH) {
+        pitch_table_.emplace(roster, table_, batter_ids_, pitcher_ids_);
+    }
+    for (const ScheduledGame& g : schedule_) {
+        if (g.home >= teams.size() || g.away >= teams.size()) {
+            throw std::invalid_argument("schedule references an unknown team");
+        }
+    }
+}
+
+std::uint64_t SeasonSimulator::fingerprint() const {
+    Fnv1a f;
+    f.value(static_cast<int>(mode()));
+    f.value(lineups_.size());
+    for (const GameLineup& l : lineups_) {
+        f.bytes(l.batters.data(), sizeof(l.batters));
+        f.value(l.pitcher);
+        f.value(l.bullpen_size);
+        f.bytes(l.bullpen.data(), l.bullpen_size * sizeof(l.bullpen[0]));
+        f.value(l.policy.pull_at_bucket);
+        f.value(l.policy.late_inning);
+        f.value(l.policy.late_pull_at_bucket);
+    }
+    f.value(schedule_.size());
+    for (const ScheduledGame& g : schedule_) {
+        f.value(g.home);
+        f.value(g.away);
+    }
+    f.bytes(batter_ids_.data(), batter_ids_.size() * sizeof(PlayerId));
+    f.bytes(pitcher_ids_.data(), pitcher_ids_.size() * sizeof(PlayerId));
+    f.value(table_.fatigue_buckets());
+    for (std::size_t p = 0; p < table_.num_pitchers(); ++p) {
+        f.value(table_.fatigue_schedule(p));
+        for (std::size_t k = 0; k < table_.fatigue_buckets(); ++k) {
+            for (std::size_t b = 0; b < table_.num_batters(); ++b) {
+                f.value(table_.at(b, p, static_cast<unsigned>(k)));
+                if (!pitch_table_) continue;
+                // By probability: the alias tables have padding bytes.
+                for (unsigned c = 0; c < kNumCountIds; ++c) {
+                    const PitchAliasTable& pitch = pitch_table_->alias_at(b, p, c, static_cast<unsigned>(k));
+                    for (std::size_t r = 0; r < kNumPitchResults; ++r) f.value(pitch.probability(r));
+                }
+            }
+        }
+    }
+    return f.h;
+}
+
+std::uint64_t SeasonSimulator::game_fingerprint(std::size_t game) const {
+    const ScheduledGame& g = schedule_.at(game);
+    Fnv1a f;
+    f.value(static_cast<int>(mode()));
+    f.value(table_.fatigue_buckets());
+    const GameLineup* sides[2] = {&lineups_[g.away], &lineups_[g.home]};
+    for (int bottom = 0; bottom < 2; ++bottom) {
+        const GameLineup& batting = *sides[bottom];
+        const GameLineup& fielding = *sides[1 - bottom];
+        f.value(fielding.policy.pull_at_bucket);
+        f.value(fielding.policy.late_inning);
+        f.value(fielding.policy.late_pull_at_bucket);
+        f.value(fielding.bullpen_size);
+        for (std::size_t s = 0; s < kLineupSize; ++s) f.value(batter_ids_[batting.batters[s]]);
+        for (std::size_t i = 0; i <= fielding.bullpen_size; ++i) {
+            const std::uint32_t p = i == 0 ? fielding.pitcher : fielding.bullpen[i - 1];
+            f.value(pitcher_ids_[p]);
+            f.value(table_.fatigue_schedule(p));
+            for (unsigned k = 0; k < table_.fatigue_buckets(); ++k) {
+                for (std::size_t s = 0; s < kLineupSize; ++s) {
+                    const std::uint32_t b = batting.batters[s];
+                    f.value(table_.at(b, p, k));
+                    if (!pitch_table_) continue;
+                    for (unsigned c = 0; c < kNumCountIds; ++c) {
+                        const PitchAliasTable& pitch = pitch_table_->alias_at(b, p, c, k);
+                        for (std::size_t r = 0; r < kNumPitchResults; ++r) f.value(pitch.probability(r));
+                    }
+                }
+            }
+        }
+    }
+    return f.h;
+}
+
+GameResult SeasonSimulator::play_scheduled_game(std::uint64_t seed, std::size_t replication, std::size_t game) const {
+    RNG rng = game_rng(seed, replication, game);
+    return play(schedule_.at(game), rng, nullptr);
+}
+
+SeasonResults SeasonSimulator::empty_results() const {
+    SeasonResults results;
+    results.teams.resize(lineups_.size());
+    for (auto& team : results.teams) {
+        team.win_histogram.assign(schedule_.size() + 1, 0);
+        team.game_runs = Histogram(0.0, kMaxHistogramGameRuns, static_cast<std::size_t>(kMaxHistogramGameRuns));
+    }
+    results.batters.resize(batter_ids_.size());
+    for (std::size_t b = 0; b < batter_ids_.size(); ++b) results.batters[b].id = batter_ids_[b];
+    results.pitchers.resize(pitcher_ids_.size());
+    for (std::size_t p = 0; p < pitcher_ids_.size(); ++p) results.pitchers[p].id = pitcher_ids_[p];
+    return results;
+}
+
+GameResult SeasonSimulator::play(const ScheduledGame& game, RNG& rng, const GameEventTarget* events) const {
+    const GameLineup& home = lineups_[game.home];
+    const GameLineup& away = lineups_[game.away];
+    if (pitch_table_) {
+        return events ? simulate_game(*pitch_table_, home, away, rng, *events) : simulate_game(*pitch_table_, home, away, rng);
+    }
+    return events ? simulate_game(table_, home, away, rng, *events) : simulate_game(table_, home, away, rng);
+}
+
+void SeasonSimulator::simulate_replication(
+    std::uint64_t seed, std::size_t replication, SeasonResults& results, EventLogWriter* events,
+    Arena* scratch, bool player_lines) const {
+    THREEUP3DOWN_SCOPE("replication");
+    if (scratch) scratch->reset();
+    std::pmr::memory_resource* memory = scratch ? scratch : std::pmr::get_default_resource();
+    // This replication's lines, folded into the totals (and their spreads) at the end.
+    std::pmr::vector<std::uint32_t> wins(lineups_.size(), 0, memory);
+    std::pmr::vector<std::uint64_t> runs(lineups_.size(), 0, memory);
+    std::pmr::vector<BattingLine> batting(player_lines ? batter_ids_.size() : 0, memory);
+    std::pmr::vector<BattingLine> pitching(player_lines ? pitcher_ids_.size() : 0, memory);
+
+    GameStatLines lines;
+    lines.pitchers = pitching.data();
+    GameEventTarget target{events, batter_ids_.data(), pitcher_ids_.data(), 0, player_lines ? &lines : nullptr};
+    // Nothing to report per PA: the loop without a hook.
+    const GameEventTarget* observe = events || player_lines ? &target : nullptr;
+    for (std::size_t g = 0; g < schedule_.size(); ++g) {
+        const ScheduledGame& game = schedule_[g];
+        if (player_lines) {
+            const GameLineup* sides[2] = {&lineups_[game.away], &lineups_[game.home]};
+            for (int bottom = 0; bottom < 2; ++bottom) {
+                for (std::size_t s = 0; s < kLineupSize; ++s) lines.batters[bottom][s] = &batting[sides[bottom]->batters[s]];
+            }
+        }
+        RNG rng = game_rng(seed, replication, g);
+        target.game_id = static_cast<std::uint64_t>(replication) * schedule_.size() + g;
+        const GameResult r = play(game, rng, observe);
+
+        const GameLineup& home_staff = lineups_[game.home];
+        const GameLineup& away_staff = lineups_[game.away];
+        ++results.pitchers[home_staff.pitcher].games_started;
+        ++results.pitchers[away_staff.pitcher].games_started;
+        for (int k = 0; k < r.home_relievers; ++k) ++results.pitchers[home_staff.bullpen[k]].relief_appearances;
+        for (int k = 0; k < r.away_relievers; ++k) ++results.pitchers[away_staff.bullpen[k]].relief_appearances;
+
+        TeamSeasonTotals& home = results.teams[game.home];
+        TeamSeasonTotals& away = results.teams[game.away];
+        home.runs_scored += r.home_runs;
+        home.runs_allowed += r.away_runs;
+        away.runs_scored += r.away_runs;
+        away.runs_allowed += r.home_runs;
+        home.pitches_thrown += r.home_pitches;
+        away.pitches_thrown += r.away_pitches;
+        home.game_runs.add(r.home_runs);
+        away.game_runs.add(r.away_runs);
+        runs[game.home] += r.home_runs;
+        runs[game.away] += r.away_runs;
+        // Ties only happen if a game hits the inning cap; they count for neither side.
+        if (r.home_runs > r.away_runs) {
+            ++wins[game.home];
+            ++home.wins;
+            ++away.losses;
+        } else if (r.away_runs > r.home_runs) {
+            ++wins[game.away];
+            ++away.wins;
+            ++home.losses;
+        }
+    }
+    add_replication_lines(
+        results, wins.data(), runs.data(), player_lines ? batting.data() : nullptr,
+        player_lines ? pitching.data() : nullptr);
+}
+
+SeasonResults SeasonSimulator::run(const SeasonConfig& config, EventLog* events) const {
+    WorkStealingPool pool(config.threads);
+    std::vector<EventLogWriter> writers;
+    if (events) {
+        writers.reserve(pool.size());
+        for (std::size_t w = 0; w < pool.size(); ++w) writers.push_back(events->writer());
+    }
+    std::unique_ptr<Arena[]> scratch(new Arena[pool.size()]);
+    const SeasonResults shape = empty_results();
+    ReplicationFold fold;
+    fold_replications(pool, config.replications, &fold, 1, [&](std::size_t worker, std::size_t rep, ReplicationFold* chunk) {
+        SeasonResults results = chunk->fresh(shape);
+        simulate_replication(
+            config.seed, rep, results, events ? &writers[worker] : nullptr, &scratch[worker], config.player_lines);
+        chunk->push({rep, 0, std::move(results)});
+    });
+    for (EventLogWriter& w : writers) w.flush();
+    return fold.result(shape);
+}
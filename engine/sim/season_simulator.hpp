@@ -0,0 +1,255 @@
+#pragma once
+
+#include "engine/core/arena.hpp"
+#include "engine/core/rng.hpp"
+#include "engine/core/stats.hpp"
+#include "engine/model/roster_store.hpp"
+#include "engine/model/team.hpp"
+#include "engine/sim/game.hpp"
+#include "engine/sim/matchup_table.hpp"
+#include "engine/sim/pitch_matchup_table.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <vector>
+
+struct ScheduledGame {
+    std::uint32_t home;  // index into the simulator's teams
+    std::uint32_t away;
+};
+
+// PLATE_APPEARANCE (the default) draws whole PAs; PITCH walks every count, which
+// costs a few draws per PA but gives pitch counts.
+enum class SimulationMode { PLATE_APPEARANCE, PITCH };
+
+struct SeasonConfig {
+    std::uint64_t seed = 0;
+    std::size_t replications = 1;
+    std::size_t threads = 0;  // 0 = all hardware threads
+    // Per-batter and per-pitcher lines (SeasonResults::batters / pitchers
+    // beyond games started and relief appearances). Off, replications without
+    // an event log play the game loop with no per-PA hook at all; the team
+    // results are the same either way.
+    bool player_lines = true;
+};
+
+// Totals over all replications. The integer counts and histograms merge exactly;
+// the RunningStats (one value per replication) are combined by ReplicationFold,
+// so they too come out bit-identical however the work was split.
+struct TeamSeasonTotals {
+    std::uint64_t wins = 0;
+    std::uint64_t losses = 0;
+    std::uint64_t runs_scored = 0;
+    std::uint64_t runs_allowed = 0;
+    std::uint64_t pitches_thrown = 0;  // by the team's pitchers; pitch mode only
+    std::vector<std::uint64_t> win_histogram;  // [w] = replications with exactly w wins
+    Histogram game_runs;                       // runs scored per game
+    RunningStats season_wins;
+    RunningStats season_runs_scored;
+};
+
+// One batter, keyed by roster id. `line` sums every replication; the RunningStats
+// hold the spread of single-season rates (seasons with at least one PA, or AB for
+// average and slugging).
+struct BatterSeasonTotals {
+    PlayerId id = 0;
+    BattingLine line;
+    RunningStats batting_average;
+    RunningStats on_base_pct;
+    RunningStats slugging;
+    RunningStats strikeout_rate;  // per PA
+    RunningStats walk_rate;       // per PA
+};
+
+// One pitcher (starter or reliever): what opposing batters did against them.
+// Runs are charged to whoever was pitching when they scored.
+struct PitcherSeasonTotals {
+    PlayerId id = 0;
+    BattingLine against;
+    std::uint64_t games_started = 0;
+    std::uint64_t relief_appearances = 0;
+    std::uint64_t runs_allowed = 0;
+    RunningStats strikeout_rate;  // per batter faced
+    RunningStats walk_rate;
+    RunningStats season_runs_allowed;
+};
+
+struct SeasonResults {
+    std::size_t replications = 0;
+    std::vector<TeamSeasonTotals> teams;
+    std::vector<BatterSeasonTotals> batters;    // one per distinct PlayerId in any lineup
+    std::vector<PitcherSeasonTotals> pitchers;  // one per distinct starter or reliever
+
+    double mean_wins(std::size_t team) const {
+        return replications ? static_cast<double>(teams[team].wins) / replications : 0.0;
+    }
+
+    void merge(const SeasonResults& other);
+};
+
+// Combines per-replication results in a tree fixed by replication index alone:
+// node [first, first + 2^level) has first a multiple of 2^level and is only ever
+// made by merging its two halves, and what is left at the end is merged left to
+// right. Floating-point merges are not associative, so this is what keeps the
+// RunningStats bit-identical across thread counts, chunkings and machines.
+//
+// Nodes are pushed in replication order, as single replications (level 0) or as
+// nodes another fold released; a fold may start anywhere (a shard's first
+// replication) and hand its pending nodes on to the fold that owns the range.
+class ReplicationFold {
+public:
+    struct Node {
+        std::size_t first = 0;  // replications [first, first + 2^level)
+        unsigned level = 0;
+        SeasonResults results;
+    };
+
+    explicit ReplicationFold(std::size_t first = 0) : end_(first) {}
+
+    // Throws std::invalid_argument unless node.first == end() and is a
+    // multiple of 2^node.level.
+    void push(Node node);
+
+    // A zeroed copy of `shape` (empty_results()) for the next replication,
+    // reusing the storage of a node that was merged away when there is one.
+    SeasonResults fresh(const SeasonResults& shape);
+
+    // One past the last replication pushed.
+    std::size_t end() const { return end_; }
+    bool empty() const { return pending_.empty(); }
+
+    // The pending nodes in replication order; the fold keeps only end().
+    std::vector<Node> release();
+
+    // Everything pushed, merged; `shape` itself if nothing was.
+    SeasonResults result(const SeasonResults& shape);
+
+private:
+    std::vector<Node> pending_;  // in replication order
+    std::vector<SeasonResults> spare_;
+    std::size_t end_;
+};
+
+class WorkStealingPool;
+
+// Plays the next `count` replications of `num_folds` folds (all at the same
+// end()) across `pool`, in chunks aligned to multiples of 16 and a few chunks
+// per worker at a time. play(worker, replication, chunk) pushes that
+// replication's leaf into chunk[0, num_folds); each chunk's nodes then go into
+// folds[k] in replication order, so the folds come out the same for any pool.
+void fold_replications(
+    WorkStealingPool& pool, std::size_t count, ReplicationFold* folds, std::size_t num_folds,
+    const std::function<void(std::size_t, std::size_t, ReplicationFold*)>& play);
+
+// What simulate_replication adds once a replication's games are played: each
+// team's wins and runs (by team) into its win histogram and season spreads,
+// and, with `batting` / `pitching` (by table row; null without player lines),
+// each player's line and rate spreads. Then counts the replication. Other
+// backends call it too, so their leaves are the CPU's.
+void add_replication_lines(
+    SeasonResults& results, const std::uint32_t* wins, const std::uint64_t* runs, const BattingLine* batting,
+    const BattingLine* pitching);
+
+// A season backend: SeasonSimulator on the CPU or CudaSeasonSimulator on a
+// device. Built from the same league, every backend returns the same results
+// for the same config.
+class SeasonRunner {
+public:
+    virtual ~SeasonRunner() = default;
+
+    virtual SeasonResults run(const SeasonConfig& config) const = 0;
+    virtual std::size_t num_teams() const = 0;
+    virtual const std::vector<ScheduledGame>& schedule() const = 0;
+    virtual std::uint64_t fingerprint() const = 0;
+};
+
+// Per-game stream: a pure function of (master seed, replication, game id), so any
+// game can be replayed on its own and thread scheduling never changes results.
+inline RNG game_rng(std::uint64_t seed, std::uint64_t replication, std::uint64_t game) {
+    std::uint64_t key = seed ^ (replication * 0xd1b54a32d192ed03ULL);
+    return RNG(splitmix64(key), game);
+}
+
+// Monte Carlo season runner: plays the schedule `replications` times across a
+// work-stealing pool (one replication per work item). Each team's bullpen is
+// used as its GameLineup policy says; with `fatigue` (default: none) pitchers
+// tire within a game and start every game fresh. The Outcomes and Platoon
+// policies go to the MatchupTable, e.g. LeagueOutcomes{} for a season of
+// league-average matchups.
+class SeasonSimulator : public SeasonRunner {
+public:
+    template <typename Outcomes = RatingsOutcomes, typename Platoon = PlatoonSplit>
+    SeasonSimulator(
+        const RosterStore& roster,
+        const std::vector<Team>& teams,
+        std::vector<ScheduledGame> schedule,
+        SimulationMode mode = SimulationMode::PLATE_APPEARANCE,
+        const FatigueModel& fatigue = FatigueModel(),
+        Outcomes = Outcomes(),
+        Platoon = Platoon())
+        : SeasonSimulator(
+              roster, teams, std::move(schedule), mode, fatigue, &matchup_distribution<Outcomes, Platoon>) {}
+
+    // Replications go out in aligned chunks; each chunk is folded on its worker
+    // and the chunks are pushed into one ReplicationFold in order, so the results
+    // are bit-identical for any thread count. Memory scales with players, teams
+    // and threads, not replications. With `events`, every PA is logged (one
+    // buffered writer per worker); game ids are replication * schedule().size()
+    // + game index.
+    SeasonResults run(const SeasonConfig& config, EventLog* events) const;
+    SeasonResults run(const SeasonConfig& config) const override { return run(config, nullptr); }
+
+    // Plays one replication of the schedule and adds it into `results` (which must
+    // come from empty_results()), logging PAs to `events` if given. Scratch comes
+    // from `scratch` (reset on entry) when given, so a warmed-up arena makes the
+    // whole replication allocation-free; otherwise from the default heap.
+    // `player_lines` is SeasonConfig::player_lines.
+    void simulate_replication(
+        std::uint64_t seed, std::size_t replication, SeasonResults& results, EventLogWriter* events = nullptr,
+        Arena* scratch = nullptr, bool player_lines = true) const;
+
+    SeasonResults empty_results() const;
+
+    std::size_t num_teams() const override { return lineups_.size(); }
+    const std::vector<ScheduledGame>& schedule() const override { return schedule_; }
+    SimulationMode mode() const { return pitch_table_ ? SimulationMode::PITCH : SimulationMode::PLATE_APPEARANCE; }
+    // Per team, by table row/column; what other backends upload.
+    const std::vector<GameLineup>& lineups() const { return lineups_; }
+    const MatchupTable& matchup_table() const { return table_; }
+
+    // Hash of everything a replication depends on besides (seed, replication):
+    // lineups, bullpens, schedule, mode and the matchup table. Two simulators with
+    // the same fingerprint play every replication identically.
+    std::uint64_t fingerprint() const override;
+
+    // The same for one scheduled game: both lineups and staffs (by PlayerId),
+    // the bullpen policies and every matchup-table entry the game can read.
+    // Equal game fingerprints mean the game plays out identically for equal
+    // (seed, replication), even between simulators built from different leagues.
+    std::uint64_t game_fingerprint(std::size_t game) const;
+
+    // Plays scheduled game `game` of `replication` on its own stream, exactly as
+    // simulate_replication does.
+    GameResult play_scheduled_game(std::uint64_t seed, std::size_t replication, std::size_t game) const;
+
+private:
+    SeasonSimulator(
+        const RosterStore& roster,
+        const std::vector<Team>& teams,
+        std::vector<ScheduledGame> schedule,
+        SimulationMode mode,
+        const FatigueModel& fatigue,
+        MatchupDistribution distribution);
+
+    GameResult play(const ScheduledGame& game, RNG& rng, const GameEventTarget* events) const;
+
+    std::vector<GameLineup> lineups_;
+    std::vector<ScheduledGame> schedule_;
+    // Table row/column -> PlayerId.
+    std::vector<PlayerId> batter_ids_;
+    std::vector<PlayerId> pitcher_ids_;
+    MatchupTable table_;
+    std::optional<PitchMatchupTable> pitch_table_;  // built in pitch mode only
+};
@@ -0,0 +1,435 @@
+#include "engine/sim/sim_service.hpp"
+
+#include "engine/core/socket.hpp"
+#include "engine/sim/game_state.hpp"
+#include "engine/sim/season_simulator.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <map>
+#include <stdexcept>
+#include <sys/socket.h>
+
+namespace sim_service_detail {
+
+struct Query {
+    explicit Query(const MatchupQuery& q) : spec(q) {}
+
+    const MatchupQuery spec;
+    std::size_t next_game = 0;       // scheduler only, under the service mutex
+    std::atomic<bool> stopped{false};  // done: the scheduler drops its lanes
+
+    mutable std::mutex mutex;
+    mutable std::condition_variable changed;
+    // Games finish out of order; they wait here (at most a lane's worth) to be
+    // folded into the estimate in game order. Value: (home runs, away runs).
+    std::map<std::size_t, std::pair<int, int>> out_of_order;
+    RunningStats home_wins;
+    MatchupEstimate estimate;
+
+    // Caller holds `mutex`.
+    void finish(QueryStatus status) {
+        estimate.status = status;
+        stopped.store(true, std::memory_order_relaxed);
+        changed.notify_all();
+    }
+
+    void record(std::size_t game, int home, int away) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (estimate.status != QueryStatus::RUNNING) return;
+        out_of_order.emplace(game, std::make_pair(home, away));
+        while (!out_of_order.empty() && out_of_order.begin()->first == estimate.games) {
+            const auto [h, a] = out_of_order.begin()->second;
+            out_of_order.erase(out_of_order.begin());
+            ++estimate.games;
+            home_wins.add(h > a ? 1.0 : h == a ? 0.5 : 0.0);
+            estimate.home_runs.add(h);
+            estimate.away_runs.add(a);
+            estimate.home_win_probability = home_wins.mean();
+            estimate.standard_error = std::sqrt(home_wins.variance() / static_cast<double>(estimate.games));
+            if (estimate.games == spec.max_games) {
+                finish(QueryStatus::COMPLETE);
+            } else if (spec.target_standard_error > 0.0 && estimate.games >= std::max<std::size_t>(spec.min_games, 2) &&
+                       estimate.standard_error <= spec.target_standard_error) {
+                finish(QueryStatus::CONVERGED);
+            }
+            if (estimate.status != QueryStatus::RUNNING) return;
+        }
+        changed.notify_all();
+    }
+
+    void cancel() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (estimate.status == QueryStatus::RUNNING) finish(QueryStatus::CANCELLED);
+    }
+};
+
+}  // namespace sim_service_detail
+
+using sim_service_detail::Query;
+
+namespace {
+
+constexpr std::size_t kMaxRequestBytes = 8192;
+constexpr int kRequestTimeoutMs = 5000;
+
+// ---- HTTP ----
+
+struct BadRequest : std::invalid_argument {
+    using std::invalid_argument::invalid_argument;
+};
+
+std::string http_response(int code, const char* reason, const std::string& body) {
+    return "HTTP/1.1 " + std::to_string(code) + " " + reason +
+           "\r\nContent-Type: application/json\r\nContent-Length: " + std::to_string(body.size()) +
+           "\r\nConnection: close\r\n\r\n" + body;
+}
+
+std::string json_string(const std::string& s) {
+    std::string out = "\"";
+    for (char c : s) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char buf[8];
+            std::snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned>(c));
+            out += buf;
+        } else {
+            out += c;
+        }
+    }
+    return out + "\"";
+}
+
+std::string json_number(double v) {
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%.6g", v);
+    return buf;
+}
+
+std::uint64_t parse_number(const std::string& name, const std::string& text) {
+    if (text.empty() || text.size() > 19 || text.find_first_not_of("0123456789") != std::string::npos) {
+        throw BadRequest(name + ": not a non-negative integer");
+    }
+    return std::stoull(text);
+}
+
+double parse_real(const std::string& name, const std::string& text) {
+    std::size_t used = 0;
+    double v = 0.0;
+    try {
+        v = std::stod(text, &used);
+    } catch (const std::exception&) {
+        used = 0;
+    }
+    if (text.empty() || used != text.size() || !(v >= 0.0)) throw BadRequest(name + ": not a non-negative number");
+    return v;
+}
+
+void parse_lineup(const std::string& name, const std::string& text, std::array<PlayerId, kLineupSize>& out) {
+    std::size_t n = 0;
+    std::size_t begin = 0;
+    while (begin <= text.size()) {
+        const std::size_t end = std::min(text.find(',', begin), text.size());
+        if (n == kLineupSize) throw BadRequest(name + ": more than " + std::to_string(kLineupSize) + " batters");
+        out[n++] = static_cast<PlayerId>(parse_number(name, text.substr(begin, end - begin)));
+        begin = end + 1;
+    }
+    if (n != kLineupSize) throw BadRequest(name + ": needs " + std::to_string(kLineupSize) + " batters");
+}
+
+std::string estimate_json(const MatchupEstimate& e) {
+    return "{\"status\":\"" + std::string(query_status_name(e.status)) + "\",\"games\":" + std::to_string(e.games) +
+           ",\"home_win_probability\":" + json_number(e.home_win_probability) +
+           ",\"standard_error\":" + json_number(e.standard_error) +
+           ",\"home_runs\":" + json_number(e.home_runs.mean()) + ",\"away_runs\":" + json_number(e.away_runs.mean()) +
+           "}";
+}
+
+}  // namespace
+
+const char* query_status_name(QueryStatus status) {
+    switch (status) {
+    case QueryStatus::RUNNING: return "running";
+    case QueryStatus::COMPLETE: return "complete";
+    case QueryStatus::CONVERGED: return "converged";
+    case QueryStatus::CANCELLED: return "cancelled";
+    }
+    return "unknown";
+}
+
+MatchupEstimate QueryHandle::snapshot() const {
+    std::lock_guard<std::mutex> lock(query_->mutex);
+    return query_->estimate;
+}
+
+MatchupEstimate QueryHandle::wait() const {
+    std::unique_lock<std::mutex> lock(query_->mutex);
+    query_->changed.wait(lock, [&] { return query_->estimate.status != QueryStatus::RUNNING; });
+    return query_->estimate;
+}
+
+bool QueryHandle::wait_for(int timeout_ms) const {
+    std::unique_lock<std::mutex> lock(query_->mutex);
+    return query_->changed.wait_for(lock, std::chrono::milliseconds(timeout_ms),
+                                    [&] { return query_->estimate.status != QueryStatus::RUNNING; });
+}
+
+bool QueryHandle::done() const {
+    std::lock_guard<std::mutex> lock(query_->mutex);
+    return query_->estimate.status != QueryStatus::RUNNING;
+}
+
+void QueryHandle::cancel() {
+    query_->cancel();
+}
+
+struct SimService::Lane {
+    std::shared_ptr<Query> query;
+    std::size_t game;
+    GameState state;
+    RNG rng;
+};
+
+SimService::SimService(RosterStore roster, SimServiceOptions options)
+    : roster_(std::move(roster)), options_(options) {
+    if (options_.lanes == 0) throw std::invalid_argument("SimService: lanes must be positive");
+    scheduler_ = std::thread([this] { run(); });
+}
+
+SimService::~SimService() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    scheduler_.join();
+}
+
+QueryHandle SimService::submit(const MatchupQuery& query) {
+    const auto known = [&](PlayerId id) { return id < roster_.size(); };
+    if (!std::all_of(query.home_lineup.begin(), query.home_lineup.end(), known) ||
+        !std::all_of(query.away_lineup.begin(), query.away_lineup.end(), known) || !known(query.home_pitcher) ||
+        !known(query.away_pitcher)) {
+        throw std::invalid_argument("SimService: query names a player not in the roster");
+    }
+    if (query.max_games == 0) throw std::invalid_argument("SimService: max_games must be positive");
+    if (!(query.target_standard_error >= 0.0)) throw std::invalid_argument("SimService: negative target_standard_error");
+    auto q = std::make_shared<Query>(query);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_) throw std::invalid_argument("SimService: shutting down");
+        pending_.push_back(q);
+        ++stats_.queries;
+    }
+    wake_.notify_all();
+    return QueryHandle(std::move(q));
+}
+
+SimServiceStats SimService::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+// One new game per query in turn until the lanes are full. Caller holds mutex_.
+void SimService::refill(std::vector<Lane>& lanes) {
+    while (lanes.size() < options_.lanes && !pending_.empty()) {
+        std::shared_ptr<Query> q = std::move(pending_.front());
+        pending_.pop_front();
+        if (q->stopped.load(std::memory_order_relaxed) || q->next_game == q->spec.max_games) continue;
+        const std::size_t game = q->next_game++;
+        lanes.push_back({q, game, GameState(), game_rng(q->spec.seed, 0, game)});
+        pending_.push_back(std::move(q));
+    }
+}
+
+void SimService::run() {
+    const std::size_t width = options_.lanes;
+    std::vector<Lane> lanes;
+    lanes.reserve(width);
+    std::vector<float> contact(width), power(width), eye(width), stuff(width), control(width), movement(width);
+    std::vector<float> uniforms(width);
+    std::vector<std::uint8_t> same_hand(width);
+    std::vector<PlateAppearanceResult> results(width);
+    std::uint64_t batches = 0;
+    std::uint64_t pas = 0;
+
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            stats_.batches += batches;
+            stats_.plate_appearances += pas;
+            batches = pas = 0;
+            wake_.wait(lock, [&] { return stopping_ || !pending_.empty() || !lanes.empty(); });
+            if (stopping_) break;
+            refill(lanes);
+        }
+        lanes.erase(std::remove_if(lanes.begin(), lanes.end(),
+                                   [](const Lane& l) { return l.query->stopped.load(std::memory_order_relaxed); }),
+                    lanes.end());
+        const std::size_t n = lanes.size();
+        if (n == 0) continue;
+
+        for (std::size_t i = 0; i < n; ++i) {
+            Lane& lane = lanes[i];
+            const MatchupQuery& q = lane.query->spec;
+            const bool bottom = lane.state.bottom();
+            const PlayerId b = (bottom ? q.home_lineup : q.away_lineup)[lane.state.batting_slot()];
+            const PlayerId p = bottom ? q.away_pitcher : q.home_pitcher;
+            contact[i] = roster_.contact()[b];
+            power[i] = roster_.power()[b];
+            eye[i] = roster_.eye()[b];
+            stuff[i] = roster_.stuff()[p];
+            control[i] = roster_.control()[p];
+            movement[i] = roster_.movement()[p];
+            same_hand[i] = static_cast<std::uint8_t>(platoon_same(roster_.bats(b), roster_.throws(p)));
+            uniforms[i] = lane.rng.uniform();
+        }
+        const PlateAppearanceBatch batch{
+            contact.data(), power.data(), eye.data(),
+            stuff.data(), control.data(), movement.data(),
+            same_hand.data(), uniforms.data(), n
+        };
+        resolve_batch(batch, results.data(), options_.kernel);
+        ++batches;
+        pas += n;
+
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            Lane& lane = lanes[i];
+            lane.state.apply(results[i]);
+            if (lane.state.final()) {
+                lane.query->record(lane.game, lane.state.home_score(), lane.state.away_score());
+            } else {
+                if (kept != i) lanes[kept] = std::move(lane);
+                ++kept;
+            }
+        }
+        lanes.erase(lanes.begin() + static_cast<std::ptrdiff_t>(kept), lanes.end());
+    }
+
+    // Shutting down: nobody will play the rest.
+    for (const Lane& lane : lanes) lane.query->cancel();
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const std::shared_ptr<Query>& q : pending_) q->cancel();
+    pending_.clear();
+}
+
+SimHttpFront::SimHttpFront(SimService& service, std::size_t max_connections)
+    : service_(service), max_connections_(max_connections), listener_("sim service") {}
+
+SimHttpFront::~SimHttpFront() = default;
+
+std::uint16_t SimHttpFront::listen(std::uint16_t port, const std::string& address) {
+    return listener_.listen(port, address, 64);
+}
+
+void SimHttpFront::serve() {
+    listener_.serve([this](int fd) { serve_connection(fd); }, max_connections_);
+}
+
+void SimHttpFront::stop() {
+    listener_.stop();
+}
+
+void SimHttpFront::serve_connection(int fd) {
+    set_socket_timeouts(fd, kRequestTimeoutMs);
+
+    // Only the request line matters; read through the end of the headers.
+    std::string request;
+    char buf[1024];
+    while (request.find("\r\n\r\n") == std::string::npos && request.size() < kMaxRequestBytes) {
+        const ssize_t got = ::recv(fd, buf, sizeof(buf), 0);
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) break;
+        request.append(buf, static_cast<std::size_t>(got));
+    }
+    const std::size_t line_end = request.find("\r\n");
+    std::string response;
+    if (line_end == std::string::npos) {
+        response = http_response(400, "Bad Request", "{\"error\":\"incomplete request\"}");
+    } else {
+        const std::string line = request.substr(0, line_end);
+        const std::size_t sp1 = line.find(' ');
+        const std::size_t sp2 = sp1 == std::string::npos ? sp1 : line.find(' ', sp1 + 1);
+        if (sp2 == std::string::npos || line.compare(sp2 + 1, 5, "HTTP/") != 0) {
+            response = http_response(400, "Bad Request", "{\"error\":\"malformed request line\"}");
+        } else if (line.compare(0, sp1, "GET") != 0) {
+            response = http_response(405, "Method Not Allowed", "{\"error\":\"only GET is supported\"}");
+        } else {
+            response = respond(line.substr(sp1 + 1, sp2 - sp1 - 1));
+        }
+    }
+    send_all(fd, response.data(), response.size());
+}
+
+std::string SimHttpFront::respond(const std::string& target) {
+    const std::size_t question = target.find('?');
+    const std::string path = target.substr(0, question);
+    std::map<std::string, std::string> params;
+    if (question != std::string::npos) {
+        std::size_t begin = question + 1;
+        while (begin < target.size()) {
+            const std::size_t end = std::min(target.find('&', begin), target.size());
+            const std::string pair = target.substr(begin, end - begin);
+            const std::size_t eq = pair.find('=');
+            if (!pair.empty()) params[pair.substr(0, eq)] = eq == std::string::npos ? "" : pair.substr(eq + 1);
+            begin = end + 1;
+        }
+    }
+
+    if (path == "/health") {
+        const SimServiceStats s = service_.stats();
+        return http_response(200, "OK",
+                             "{\"players\":" + std::to_string(service_.roster().size()) +
+                                 ",\"queries\":" + std::to_string(s.queries) + ",\"batches\":" +
+                                 std::to_string(s.batches) + ",\"plate_appearances\":" +
+                                 std::to_string(s.plate_appearances) + "}");
+    }
+    if (path != "/matchup") return http_response(404, "Not Found", "{\"error\":" + json_string("no such path " + path) + "}");
+
+    try {
+        MatchupQuery q;
+        std::uint64_t budget_ms = 0;
+        bool have[4] = {false, false, false, false};
+        for (const auto& [name, value] : params) {
+            if (name == "home") {
+                parse_lineup(name, value, q.home_lineup);
+                have[0] = true;
+            } else if (name == "away") {
+                parse_lineup(name, value, q.away_lineup);
+                have[1] = true;
+            } else if (name == "home_pitcher") {
+                q.home_pitcher = static_cast<PlayerId>(parse_number(name, value));
+                have[2] = true;
+            } else if (name == "away_pitcher") {
+                q.away_pitcher = static_cast<PlayerId>(parse_number(name, value));
+                have[3] = true;
+            } else if (name == "seed") {
+                q.seed = parse_number(name, value);
+            } else if (name == "games") {
+                q.max_games = static_cast<std::size_t>(parse_number(name, value));
+            } else if (name == "se") {
+                q.target_standard_error = parse_real(name, value);
+            } else if (name == "min_games") {
+                q.min_games = static_cast<std::size_t>(parse_number(name, value));
+            } else if (name == "budget_ms") {
+                budget_ms = std::min<std::uint64_t>(parse_number(name, value), 3600000);
+            } else {
+                throw BadRequest("unknown parameter " + name);
+            }
+        }
+        if (!have[0] || !have[1] || !have[2] || !have[3]) {
+            throw BadRequest("home, away, home_pitcher and away_pitcher are required");
+        }
+        QueryHandle handle = service_.submit(q);
+        if (budget_ms > 0 && !handle.wait_for(static_cast<int>(budget_ms))) handle.cancel();
+        return http_response(200, "OK", estimate_json(handle.wait()));
+    } catch (const std::invalid_argument& e) {
+        return http_response(400, "Bad Request", "{\"error\":" + json_string(e.what()) + "}");
+    }
+}
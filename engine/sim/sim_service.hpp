@@ -0,0 +1,173 @@
+#pragma once
+
+#include "engine/core/socket.hpp"
+#include "engine/core/stats.hpp"
+#include "engine/model/roster_store.hpp"
+#include "engine/model/team.hpp"
+#include "engine/sim/batch_resolver.hpp"
+
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Long-running service for interactive questions ("home win probability for
+// tonight's matchup"), so each one doesn't pay for a process start and a
+// roster load.
+//
+// The service owns a warm RosterStore and one scheduler thread. Every game of
+// every query in flight is one lane of a lockstep batch: each step resolves the
+// next PA of all lanes with a single resolve_batch() call, so concurrent
+// queries share batches instead of queueing behind each other. Lanes are handed
+// out round-robin across queries, and a finished game's lane goes straight to
+// the next game waiting.
+//
+// Game g of a query always plays on game_rng(seed, 0, g), starters only (no
+// fatigue or bullpen), and results are folded in game order. So an estimate
+// over n games is the same whatever else was running, and so is the point
+// where a query converges.
+
+struct MatchupQuery {
+    std::array<PlayerId, kLineupSize> home_lineup{};
+    std::array<PlayerId, kLineupSize> away_lineup{};
+    PlayerId home_pitcher = 0;
+    PlayerId away_pitcher = 0;
+    std::uint64_t seed = 0;
+    std::size_t max_games = 10000;
+    // Stop early once the home win probability's standard error is at most
+    // this, but not before min_games. 0 plays all max_games.
+    double target_standard_error = 0.0;
+    std::size_t min_games = 100;
+};
+
+enum class QueryStatus {
+    RUNNING,
+    COMPLETE,   // played max_games
+    CONVERGED,  // reached target_standard_error
+    CANCELLED,  // cancel(), or the service shut down
+};
+
+const char* query_status_name(QueryStatus status);
+
+struct MatchupEstimate {
+    QueryStatus status = QueryStatus::RUNNING;
+    std::size_t games = 0;              // games 0 .. games-1 of the query
+    double home_win_probability = 0.0;  // ties at the inning cap count half
+    double standard_error = 0.0;
+    RunningStats home_runs;
+    RunningStats away_runs;
+};
+
+namespace sim_service_detail {
+struct Query;
+}
+
+// A submitted query. Copies share it; it stays valid after the service is gone.
+class QueryHandle {
+public:
+    QueryHandle() = default;
+
+    // The estimate over the games finished so far; status RUNNING until done.
+    MatchupEstimate snapshot() const;
+    MatchupEstimate wait() const;
+    // True if the query finished within timeout_ms.
+    bool wait_for(int timeout_ms) const;
+    bool done() const;
+
+    // Stops handing out the query's games; the ones in flight are dropped.
+    // No-op once done.
+    void cancel();
+
+private:
+    friend class SimService;
+    explicit QueryHandle(std::shared_ptr<sim_service_detail::Query> query) : query_(std::move(query)) {}
+
+    std::shared_ptr<sim_service_detail::Query> query_;
+};
+
+struct SimServiceOptions {
+    std::size_t lanes = 4096;  // games in flight at once, across all queries
+    BatchKernel kernel = best_batch_kernel();
+};
+
+struct SimServiceStats {
+    std::uint64_t queries = 0;
+    std::uint64_t batches = 0;  // resolve_batch calls
+    std::uint64_t plate_appearances = 0;
+};
+
+class SimService {
+public:
+    explicit SimService(RosterStore roster, SimServiceOptions options = SimServiceOptions());
+    // Cancels whatever is still running.
+    ~SimService();
+
+    SimService(const SimService&) = delete;
+    SimService& operator=(const SimService&) = delete;
+
+    // Throws std::invalid_argument for an unknown player or max_games == 0.
+    QueryHandle submit(const MatchupQuery& query);
+
+    const RosterStore& roster() const { return roster_; }
+    SimServiceStats stats() const;
+
+private:
+    struct Lane;
+
+    void run();
+    void refill(std::vector<Lane>& lanes);
+
+    const RosterStore roster_;
+    const SimServiceOptions options_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    std::deque<std::shared_ptr<sim_service_detail::Query>> pending_;  // still handing out games
+    SimServiceStats stats_;
+    bool stopping_ = false;
+    std::thread scheduler_;
+};
+
+// Minimal HTTP/1.1 front for a SimService; one request per connection, each
+// on its own thread, at most max_connections at once (see TcpListener).
+//
+//   GET /matchup?home=<9 ids>&away=<9 ids>&home_pitcher=<id>&away_pitcher=<id>
+//               [&seed=0][&games=10000][&se=0][&min_games=100][&budget_ms=0]
+//   GET /health
+//
+// Ids are comma separated. With budget_ms, a query still running when the
+// budget is up is cancelled and its partial estimate returned. Answers are JSON;
+// malformed requests get a 400 with {"error": ...}.
+class SimHttpFront {
+public:
+    explicit SimHttpFront(SimService& service, std::size_t max_connections = 64);
+    ~SimHttpFront();
+
+    SimHttpFront(const SimHttpFront&) = delete;
+    SimHttpFront& operator=(const SimHttpFront&) = delete;
+
+    // Binds and listens; port 0 picks a free one. Returns the bound port.
+    // Throws std::runtime_error if the socket can't be set up.
+    std::uint16_t listen(std::uint16_t port, const std::string& address = "0.0.0.0");
+
+    // Accepts connections until stop() (callable from any thread), then waits
+    // for the ones still being answered.
+    void serve();
+    void stop();
+
+    // Status line, headers and body for one request line's target.
+    std::string respond(const std::string& target);
+
+private:
+    void serve_connection(int fd);
+
+    SimService& service_;
+    const std::size_t max_connections_;
+    TcpListener listener_;
+};
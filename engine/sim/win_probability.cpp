@@ -0,0 +1,214 @@
+#include "engine/sim/win_probability.hpp"
+
+#include "engine/sim/run_expectancy.hpp"
+
+#include <algorithm>
+
+namespace {
+
+constexpr int kLeads = 2 * WinProbabilityTable::kMaxLead + 1;
+
+// Below this a (runs, next leadoff) cell can't move an answer; the solver's
+// own truncation is ~1e-13.
+constexpr double kNegligibleMass = 1e-16;
+
+int clamp_lead(int lead) {
+    return std::clamp(lead, -WinProbabilityTable::kMaxLead, WinProbabilityTable::kMaxLead);
+}
+
+}  // namespace
+
+WinProbabilityTable::WinProbabilityTable(
+    const MatchupTable& table, const GameLineup& home, const GameLineup& away, WinProbabilityOptions options)
+    : table_(table), pitches_(nullptr), home_(home), away_(away), options_(options) {
+    const RunExpectancySolver sides[2] = {
+        RunExpectancySolver(table, away, home.pitcher),  // top halves
+        RunExpectancySolver(table, home, away.pitcher),
+    };
+    halves_.resize(2 * kNumBaseOutStates * kLineupSize);
+    for (int bottom = 0; bottom < 2; ++bottom) {
+        for (unsigned s = 0; s < kNumBaseOutStates; ++s) {
+            for (unsigned slot = 0; slot < kLineupSize; ++slot) {
+                const InningDistribution d = sides[bottom].from_state(s, slot);
+                HalfInning& h = halves_[(bottom * kNumBaseOutStates + s) * kLineupSize + slot];
+                h.expected_runs = d.expected_runs;
+                for (std::size_t r = 0; r <= kMaxInningRuns; ++r) {
+                    for (std::size_t n = 0; n < kLineupSize; ++n) {
+                        if (d.joint[r][n] > kNegligibleMass) {
+                            h.terms.push_back({static_cast<std::uint8_t>(r), static_cast<std::uint8_t>(n), d.joint[r][n]});
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // Backwards from the inning cap. Only reachable leads are filled in: from
+    // the bottom of the 9th on the home side can't be ahead at the start of
+    // its half, and from the 10th on every inning starts tied.
+    start_.assign(static_cast<std::size_t>(kMaxInnings) * 2 * kLineupSize * kLineupSize * kLeads, 0.0);
+    for (int inning = kMaxInnings; inning >= 1; --inning) {
+        for (int bottom = 1; bottom >= 0; --bottom) {
+            int lo = -kMaxLead;
+            int hi = kMaxLead;
+            if (bottom && inning >= 9) hi = 0;
+            if (!bottom && inning >= 10) lo = hi = 0;
+            for (unsigned a = 0; a < kLineupSize; ++a) {
+                for (unsigned m = 0; m < kLineupSize; ++m) {
+                    for (int lead = lo; lead <= hi; ++lead) {
+                        start(inning, bottom != 0, a, m, lead) = rest_of_half(inning, bottom != 0, 0, a, m, lead);
+                    }
+                }
+            }
+        }
+    }
+}
+
+WinProbabilityTable::WinProbabilityTable(
+    const MatchupTable& table, const PitchMatchupTable& pitches, const GameLineup& home, const GameLineup& away,
+    WinProbabilityOptions options)
+    : WinProbabilityTable(table, home, away, options) {
+    pitches_ = &pitches;
+    count_outcomes_.resize(2 * kLineupSize * kNumCountIds * kNumPlateAppearanceResults);
+    for (int bottom = 0; bottom < 2; ++bottom) {
+        const GameLineup& batting = bottom ? home : away;
+        const std::uint32_t pitcher = bottom ? away.pitcher : home.pitcher;
+        for (std::size_t slot = 0; slot < kLineupSize; ++slot) {
+            PitchCountDistribution dist;
+            for (unsigned c = 0; c < kNumCountIds; ++c) {
+                const PitchAliasTable& alias = pitches.alias_at(batting.batters[slot], pitcher, c);
+                for (std::size_t k = 0; k < kNumPitchResults; ++k) dist.probs[c][k] = static_cast<float>(alias.probability(k));
+            }
+            for (unsigned c = 0; c < kNumCountIds; ++c) {
+                if ((c & 3u) == 3u) continue;  // no such count
+                double probs[kNumPlateAppearanceResults];
+                double pitches_left = 0.0;
+                count_chain_outcomes(dist, probs, pitches_left, c);
+                std::copy(std::begin(probs), std::end(probs),
+                          count_outcomes_.begin() +
+                              static_cast<std::ptrdiff_t>(((bottom * kLineupSize + slot) * kNumCountIds + c) *
+                                                          kNumPlateAppearanceResults));
+            }
+        }
+    }
+}
+
+double& WinProbabilityTable::start(int inning, bool bottom, unsigned away_slot, unsigned home_slot, int lead) {
+    return start_[((((inning - 1) * 2 + bottom) * kLineupSize + away_slot) * kLineupSize + home_slot) * kLeads +
+                  (lead + kMaxLead)];
+}
+
+double WinProbabilityTable::start(int inning, bool bottom, unsigned away_slot, unsigned home_slot, int lead) const {
+    return start_[((((inning - 1) * 2 + bottom) * kLineupSize + away_slot) * kLineupSize + home_slot) * kLeads +
+                  (lead + kMaxLead)];
+}
+
+// Home win probability from (base_out, batter due up) in the given half,
+// summed over how the half ends.
+double WinProbabilityTable::rest_of_half(
+    int inning, bool bottom, unsigned base_out, unsigned away_slot, unsigned home_slot, int lead) const {
+    double p = 0.0;
+    if (!bottom) {
+        for (const Term& t : half(false, base_out, away_slot).terms) {
+            const int after = lead - t.runs;
+            // Ahead after the top of the 9th or later: the home side doesn't bat.
+            const double v = inning >= 9 && after > 0 ? 1.0 : start(inning, true, t.next_slot, home_slot, clamp_lead(after));
+            p += t.probability * v;
+        }
+        return p;
+    }
+    for (const Term& t : half(true, base_out, home_slot).terms) {
+        const int after = lead + t.runs;
+        double v;
+        if (inning < 9) {
+            v = start(inning + 1, false, away_slot, t.next_slot, clamp_lead(after));
+        } else if (after != 0) {
+            // Taking the lead at any point in the half is a walk-off, so the
+            // half's total decides it.
+            v = after > 0 ? 1.0 : 0.0;
+        } else {
+            v = inning >= kMaxInnings ? 0.5 : start(inning + 1, false, away_slot, t.next_slot, 0);
+        }
+        p += t.probability * v;
+    }
+    return p;
+}
+
+double WinProbabilityTable::value(GameState state) const {
+    const int lead = state.home_score() - state.away_score();
+    if (state.final()) return lead > 0 ? 1.0 : lead < 0 ? 0.0 : 0.5;
+    return rest_of_half(state.inning(), state.bottom(), state.base_out(), state.lineup_slot(false),
+                        state.lineup_slot(true), clamp_lead(lead));
+}
+
+bool WinProbabilityTable::in_table(GameState state) const {
+    if (state.final()) return true;
+    const int lead = state.home_score() - state.away_score();
+    return lead >= -kMaxLead && lead <= kMaxLead;
+}
+
+WinProbability WinProbabilityTable::lookup(GameState state) const {
+    WinProbability out;
+    if (state.final()) {
+        const int lead = state.home_score() - state.away_score();
+        out.home_win = lead > 0 ? 1.0 : lead < 0 ? 0.0 : 0.5;
+        out.source = WinProbabilitySource::FINAL;
+        return out;
+    }
+    if (!in_table(state)) return rollout(state, options_.rollouts);
+    const bool bottom = state.bottom();
+    const unsigned slot = state.batting_slot();
+    if (!pitches_ || state.count_id() == 0) {
+        out.home_win = value(state);
+        out.expected_inning_runs = half(bottom, state.base_out(), slot).expected_runs;
+        return out;
+    }
+    // Mid-PA: over how this PA can still end.
+    const double* probs =
+        &count_outcomes_[((bottom * kLineupSize + slot) * kNumCountIds + state.count_id()) * kNumPlateAppearanceResults];
+    const unsigned next_slot = slot + 1 == kLineupSize ? 0u : slot + 1;
+    for (std::size_t k = 0; k < kNumPlateAppearanceResults; ++k) {
+        if (probs[k] == 0.0) continue;
+        GameState next = state;
+        next.apply(static_cast<PlateAppearanceResult>(k));
+        out.home_win += probs[k] * value(next);
+        const BaseOutTransition t = kBaseOutTransitions[state.base_out()][k];
+        const double rest = base_out_outs(t.next) < 3 ? half(bottom, t.next, next_slot).expected_runs : 0.0;
+        out.expected_inning_runs += probs[k] * (t.runs + rest);
+    }
+    return out;
+}
+
+WinProbability WinProbabilityTable::rollout(GameState state, std::size_t games) const {
+    WinProbability out;
+    out.source = WinProbabilitySource::ROLLOUT;
+    out.rollouts = games;
+    if (games == 0) return out;
+    RNG rng(options_.seed, state.raw());
+    const bool pitch_level = pitches_ && state.count_id() != 0;
+    const bool bottom = state.bottom();
+    const int inning = state.inning();
+    double wins = 0.0;
+    double runs = 0.0;
+    for (std::size_t g = 0; g < games; ++g) {
+        GameState s = state;
+        bool counted = false;
+        while (!s.final()) {
+            if (pitch_level && s.count_id() != 0) {
+                play_pitch(*pitches_, home_, away_, s, rng);
+            } else {
+                // The rest of the game at PA level, as the table models it.
+                play_plate_appearance(table_, home_, away_, s, rng);
+            }
+            if (!counted && (s.final() || s.bottom() != bottom || s.inning() != inning)) {
+                counted = true;
+                runs += bottom ? s.home_score() - state.home_score() : s.away_score() - state.away_score();
+            }
+        }
+        const int lead = s.home_score() - s.away_score();
+        wins += lead > 0 ? 1.0 : lead < 0 ? 0.0 : 0.5;
+    }
+    out.home_win = wins / static_cast<double>(games);
+    out.expected_inning_runs = runs / static_cast<double>(games);
+    return out;
+}
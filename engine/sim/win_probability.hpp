@@ -0,0 +1,104 @@
+#pragma once
+
+#include "engine/sim/game.hpp"
+#include "engine/sim/game_state.hpp"
+#include "engine/sim/matchup_table.hpp"
+#include "engine/sim/pitch_matchup_table.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+enum class WinProbabilitySource {
+    TABLE,    // the exact value table
+    ROLLOUT,  // Monte Carlo from the state
+    FINAL,    // the game is over
+};
+
+struct WinProbability {
+    double home_win = 0.0;              // ties at the inning cap count half
+    double expected_inning_runs = 0.0;  // batting side, rest of this half-inning (as RE24: walk-offs not cut short)
+    WinProbabilitySource source = WinProbabilitySource::TABLE;
+    std::size_t rollouts = 0;
+};
+
+struct WinProbabilityOptions {
+    std::size_t rollouts = 4000;  // games per fallback answer
+    std::uint64_t seed = 0;       // fallback streams are RNG(seed, state.raw())
+};
+
+// Live win probability for one game (two lineups against two starters), from
+// any GameState.
+//
+// Built once from the Markov solver (RunExpectancySolver::from_state for every
+// base-out state and batter due up, both sides), then a backward pass over
+// half-innings: the home side's win probability at the start of every half of
+// every inning, for every pair of lineup slots and lead. A lookup decodes the
+// state and sums one half-inning's (runs, next leadoff) distribution against
+// that table: a few hundred multiply-adds, no simulation.
+//
+// Walk-offs, the home side skipping the bottom half and extra innings up to
+// kMaxInnings are exact. Built with a PitchMatchupTable, a mid-PA count is
+// exact too: the count chain gives the PA's outcome distribution from that
+// count (count_chain_outcomes), and each outcome's next state is looked up.
+// Without one, the count is ignored. Only a lead beyond kMaxLead falls back to
+// Monte Carlo rollouts.
+//
+// Like play_plate_appearance, starters pitch the whole game, fresh. `table` and
+// `pitches` must outlive this.
+class WinProbabilityTable {
+public:
+    static constexpr int kMaxLead = 30;
+
+    WinProbabilityTable(
+        const MatchupTable& table, const GameLineup& home, const GameLineup& away,
+        WinProbabilityOptions options = WinProbabilityOptions());
+
+    WinProbabilityTable(
+        const MatchupTable& table, const PitchMatchupTable& pitches, const GameLineup& home, const GameLineup& away,
+        WinProbabilityOptions options = WinProbabilityOptions());
+
+    WinProbability lookup(GameState state) const;
+
+    // True if lookup() answers `state` without rollouts.
+    bool in_table(GameState state) const;
+
+    // Monte Carlo estimate from `state` over `games` rollouts, whether or not
+    // the table covers it.
+    WinProbability rollout(GameState state, std::size_t games) const;
+
+private:
+    // One term of a half-inning's (runs, next leadoff) distribution.
+    struct Term {
+        std::uint8_t runs;
+        std::uint8_t next_slot;
+        double probability;
+    };
+
+    struct HalfInning {
+        std::vector<Term> terms;
+        double expected_runs;
+    };
+
+    const HalfInning& half(bool bottom, unsigned base_out, unsigned slot) const {
+        return halves_[(bottom * kNumBaseOutStates + base_out) * kLineupSize + slot];
+    }
+
+    double& start(int inning, bool bottom, unsigned away_slot, unsigned home_slot, int lead);
+    double start(int inning, bool bottom, unsigned away_slot, unsigned home_slot, int lead) const;
+    double rest_of_half(int inning, bool bottom, unsigned base_out, unsigned away_slot, unsigned home_slot, int lead) const;
+    // Table value of a state between PAs; leads past kMaxLead saturate.
+    double value(GameState state) const;
+
+    const MatchupTable& table_;
+    const PitchMatchupTable* pitches_;
+    GameLineup home_;
+    GameLineup away_;
+    WinProbabilityOptions options_;
+    std::vector<HalfInning> halves_;  // [bottom][base_out][slot due up]
+    // With pitches_: PA outcome probabilities from each count, [bottom][slot][count_id][result].
+    std::vector<double> count_outcomes_;
+    // Home win probability at the start of each half-inning:
+    // [inning - 1][bottom][away slot][home slot][lead + kMaxLead], lead = home - away.
+    std::vector<double> start_;
+};
@@ -0,0 +1,54 @@
+#include "engine/core/alias_table.hpp"
+#include "engine/sim/plate_appearence.hpp"
+
+#include <cmath>
+#include <iostream>
+
+int main() {
+    RNG rng(11);
+    for (int trial = 0; trial < 200; ++trial) {
+        const OutcomeDistribution dist = outcome_distribution(
+            rng.uniform(), rng.uniform(), rng.uniform(), rng.uniform(), rng.uniform(), rng.uniform(), trial & 1);
+        float probs[kNumPlateAppearanceResults];
+        outcome_probabilities(dist, probs);
+        const OutcomeAliasTable table = make_alias_table(dist);
+        for (std::size_t k = 0; k < kNumPlateAppearanceResults; ++k) {
+            if (std::fabs(table.probability(k) - probs[k]) > 1e-6) {
+                std::cerr << "alias table mass differs for outcome " << k << "\n";
+                return 1;
+            }
+        }
+    }
+
+    // Degenerate and lopsided inputs still cover every u.
+    const float single_outcome[4] = {0.f, 0.f, 3.f, 0.f};
+    const AliasTable<4> certain(single_outcome);
+    for (float u = 0.f; u < 1.f; u += 1.f / 1024) {
+        if (certain.sample(u) != 2) {
+            std::cerr << "zero-probability outcome was sampled\n";
+            return 1;
+        }
+    }
+    if (certain.sample(0.99999994f) != 2) {
+        std::cerr << "largest uniform fell off the table\n";
+        return 1;
+    }
+
+    // Empirical frequencies over a fine grid of u match the input.
+    const float skewed[8] = {0.5f, 0.01f, 0.2f, 0.05f, 0.004f, 0.03f, 0.2f, 0.006f};
+    const AliasTable<8> alias(skewed);
+    const int steps = 1 << 20;
+    int counts[8] = {};
+    for (int i = 0; i < steps; ++i) {
+        ++counts[alias.sample(static_cast<float>(i) / steps)];
+    }
+    for (int k = 0; k < 8; ++k) {
+        if (std::fabs(static_cast<double>(counts[k]) / steps - skewed[k]) > 1e-4) {
+            std::cerr << "alias sampling frequency off for outcome " << k << "\n";
+            return 1;
+        }
+    }
+
+    std::cout << "AliasTable OK\n";
+    return 0;
+}
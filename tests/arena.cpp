@@ -0,0 +1,109 @@
+#include "engine/core/arena.hpp"
+#include "engine/sim/season_simulator.hpp"
+#include "tests/test_league.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <vector>
+
+// Count every global heap allocation (plain and over-aligned new; pmr's default
+// resource goes through the latter) so the test can assert the hot loop makes none.
+namespace {
+std::size_t g_heap_allocations = 0;
+}
+
+void* operator new(std::size_t size) {
+    ++g_heap_allocations;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t align) {
+    ++g_heap_allocations;
+    const std::size_t a = static_cast<std::size_t>(align);
+    if (void* p = std::aligned_alloc(a, (size + a - 1) / a * a)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+int main() {
+    // Bumping: alignment honoured, growth past the first block, reset folds the chain into one block.
+    {
+        Arena arena(256);
+        void* a = arena.allocate(3, 1);
+        void* b = arena.allocate(8, 64);
+        if (reinterpret_cast<std::uintptr_t>(b) % 64 != 0 || a == b) {
+            std::cerr << "arena ignores alignment\n";
+            return 1;
+        }
+        std::pmr::vector<double> big(1000, 1.0, &arena);
+        if (arena.upstream_allocations() < 2 || arena.bytes_allocated() < 8000) {
+            std::cerr << "arena did not grow\n";
+            return 1;
+        }
+        const std::size_t grown = arena.capacity();
+        arena.reset();
+        const std::size_t after_reset = arena.upstream_allocations();
+        if (arena.capacity() != grown || arena.bytes_allocated() != 0) {
+            std::cerr << "reset lost capacity\n";
+            return 1;
+        }
+        std::pmr::vector<double> again(1000, 2.0, &arena);
+        if (arena.upstream_allocations() != after_reset) {
+            std::cerr << "arena went back to the heap after reset\n";
+            return 1;
+        }
+    }
+
+    RosterStore roster;
+    const std::vector<Team> teams = make_teams(
+        roster, 4, [](int t, std::size_t s) { return 0.3f + 0.02f * s + 0.05f * t; },
+        [](int t) { return 0.45f + 0.03f * t; });
+    const std::vector<ScheduledGame> schedule = round_robin(4);
+
+    const std::string path = "arena_test_events.bin";
+    std::remove(path.c_str());
+    for (SimulationMode mode : {SimulationMode::PLATE_APPEARANCE, SimulationMode::PITCH}) {
+        const SeasonSimulator sim(roster, teams, schedule, mode);
+        SeasonResults results = sim.empty_results();
+        EventLog log(path);
+        EventLogWriter writer = log.writer(1 << 16);  // larger than the run: nothing flushes mid-loop
+        Arena scratch;
+        sim.simulate_replication(5, 0, results, &writer, &scratch);  // warm-up sizes the arena
+
+        const std::size_t before = g_heap_allocations;
+        for (std::size_t rep = 1; rep < 50; ++rep) {
+            sim.simulate_replication(5, rep, results, &writer, &scratch);
+        }
+        const std::size_t allocations = g_heap_allocations - before;
+        if (allocations != 0) {
+            std::cerr << allocations << " heap allocations in 49 replications ("
+                      << (mode == SimulationMode::PITCH ? "pitch" : "PA") << " mode)\n";
+            return 1;
+        }
+        // Without the arena the same loop does hit the heap, so the counter is live.
+        const std::size_t heap_before = g_heap_allocations;
+        sim.simulate_replication(5, 50, results, &writer);
+        if (g_heap_allocations == heap_before) {
+            std::cerr << "allocation counter is not counting\n";
+            return 1;
+        }
+        if (results.replications != 51) {
+            std::cerr << "replications went missing\n";
+            return 1;
+        }
+    }
+    std::remove(path.c_str());
+
+    std::cout << "arena ok\n";
+    return 0;
+}
@@ -0,0 +1,73 @@
+#include "engine/sim/batch_resolver.hpp"
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+int main() {
+    // Odd size so every kernel also exercises its scalar tail.
+    const std::size_t n = 4099;
+    RNG rng(2024);
+    std::vector<float> contact(n), power(n), eye(n), stuff(n), control(n), movement(n), uniforms(n);
+    std::vector<std::uint8_t> same_hand(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        same_hand[i] = static_cast<std::uint8_t>((i * 7) % 3 == 0);
+        contact[i] = rng.uniform();
+        power[i] = rng.uniform();
+        eye[i] = rng.uniform();
+        stuff[i] = rng.uniform();
+        control[i] = rng.uniform();
+        movement[i] = rng.uniform();
+        uniforms[i] = rng.uniform();
+    }
+    // Pin a few lanes to the rating extremes where the clamps bite.
+    contact[0] = 0.f; power[0] = 1.f; eye[0] = 1.f; stuff[0] = 1.f; control[0] = 0.f; movement[0] = 0.f;
+    contact[1] = 1.f; power[1] = 0.f; eye[1] = 0.f; stuff[1] = 0.f; control[1] = 1.f; movement[1] = 1.f;
+    // Put some draws exactly on a threshold: any rounding difference in a kernel flips these.
+    for (std::size_t i = 2; i < 512; ++i) {
+        const OutcomeDistribution dist = outcome_distribution(
+            contact[i], power[i], eye[i], stuff[i], control[i], movement[i], same_hand[i]);
+        uniforms[i] = dist.cumulative[i % (kNumPlateAppearanceResults - 1)];
+    }
+
+    PlateAppearanceBatch batch{
+        contact.data(), power.data(), eye.data(),
+        stuff.data(), control.data(), movement.data(),
+        same_hand.data(), uniforms.data(), n
+    };
+
+    std::vector<PlateAppearanceResult> scalar(n), simd(n);
+    resolve_batch(batch, scalar.data(), BatchKernel::SCALAR);
+    resolve_batch(batch, simd.data());
+
+    for (std::size_t i = 0; i < n; ++i) {
+        const OutcomeDistribution dist = outcome_distribution(
+            contact[i], power[i], eye[i], stuff[i], control[i], movement[i], same_hand[i]);
+        const PlateAppearanceResult expected = sample_outcome(dist, uniforms[i]);
+        if (scalar[i] != expected) {
+            std::cerr << "scalar batch lane " << i << " differs from outcome_distribution\n";
+            return 1;
+        }
+        if (simd[i] != scalar[i]) {
+            std::cerr << "vector kernel lane " << i << " differs from scalar\n";
+            return 1;
+        }
+    }
+
+    // Calibration candidates: every kernel still matches outcome_distribution.
+    ResolveCoefficients tuned = kResolveCoefficients;
+    for (std::size_t c = 0; c < kNumResolveCoefficients; ++c) tuned[c] *= c % 2 ? 0.9f : 1.15f;
+    resolve_batch(batch, scalar.data(), BatchKernel::SCALAR, tuned);
+    resolve_batch(batch, simd.data(), best_batch_kernel(), tuned);
+    for (std::size_t i = 0; i < n; ++i) {
+        const OutcomeDistribution dist = outcome_distribution(
+            contact[i], power[i], eye[i], stuff[i], control[i], movement[i], same_hand[i], tuned);
+        if (scalar[i] != sample_outcome(dist, uniforms[i]) || simd[i] != scalar[i]) {
+            std::cerr << "lane " << i << " differs with calibrated coefficients\n";
+            return 1;
+        }
+    }
+
+    std::cout << "BatchResolver OK (kernel " << static_cast<int>(best_batch_kernel()) << ")\n";
+    return 0;
+}
@@ -0,0 +1,124 @@
+#include "engine/sim/cuda_season_simulator.hpp"
+#include "tests/test_league.hpp"
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+bool same_stats(const RunningStats& a, const RunningStats& b) {
+    return a.count() == b.count() && a.mean() == b.mean() && a.m2() == b.m2() && a.min() == b.min() &&
+           a.max() == b.max();
+}
+
+bool same_line(const BattingLine& a, const BattingLine& b) {
+    for (std::size_t r = 0; r < kNumPlateAppearanceResults; ++r) {
+        if (a.results[r] != b.results[r]) return false;
+    }
+    return a.runs_batted_in == b.runs_batted_in;
+}
+
+// Bit for bit, spreads and player lines included.
+bool same_results(const SeasonResults& cpu, const SeasonResults& gpu) {
+    if (cpu.replications != gpu.replications || cpu.teams.size() != gpu.teams.size() ||
+        cpu.batters.size() != gpu.batters.size() || cpu.pitchers.size() != gpu.pitchers.size()) {
+        return false;
+    }
+    for (std::size_t t = 0; t < cpu.teams.size(); ++t) {
+        const TeamSeasonTotals& x = cpu.teams[t];
+        const TeamSeasonTotals& y = gpu.teams[t];
+        if (x.wins != y.wins || x.losses != y.losses || x.runs_scored != y.runs_scored ||
+            x.runs_allowed != y.runs_allowed || x.win_histogram != y.win_histogram ||
+            x.game_runs.overflow() != y.game_runs.overflow() || !same_stats(x.season_wins, y.season_wins) ||
+            !same_stats(x.season_runs_scored, y.season_runs_scored)) {
+            return false;
+        }
+        for (std::size_t b = 0; b < x.game_runs.bins(); ++b) {
+            if (x.game_runs[b] != y.game_runs[b]) return false;
+        }
+    }
+    for (std::size_t i = 0; i < cpu.batters.size(); ++i) {
+        const BatterSeasonTotals& x = cpu.batters[i];
+        const BatterSeasonTotals& y = gpu.batters[i];
+        if (x.id != y.id || !same_line(x.line, y.line) || !same_stats(x.batting_average, y.batting_average) ||
+            !same_stats(x.on_base_pct, y.on_base_pct) || !same_stats(x.slugging, y.slugging) ||
+            !same_stats(x.strikeout_rate, y.strikeout_rate) || !same_stats(x.walk_rate, y.walk_rate)) {
+            return false;
+        }
+    }
+    for (std::size_t i = 0; i < cpu.pitchers.size(); ++i) {
+        const PitcherSeasonTotals& x = cpu.pitchers[i];
+        const PitcherSeasonTotals& y = gpu.pitchers[i];
+        if (x.id != y.id || !same_line(x.against, y.against) || x.games_started != y.games_started ||
+            x.relief_appearances != y.relief_appearances || x.runs_allowed != y.runs_allowed ||
+            !same_stats(x.strikeout_rate, y.strikeout_rate) || !same_stats(x.walk_rate, y.walk_rate) ||
+            !same_stats(x.season_runs_allowed, y.season_runs_allowed)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+int main() {
+    const int num_teams = 4;
+    RosterStore roster;
+    const std::vector<Team> teams = make_teams(
+        roster, num_teams, [](int t, std::size_t s) { return 0.3f + 0.1f * t + 0.01f * s; },
+        [](int t) { return 0.4f + 0.05f * t; });
+    const std::vector<ScheduledGame> schedule = round_robin(num_teams, 10);
+
+    // What the device loop doesn't model is refused up front.
+    std::vector<Team> with_bullpen = teams;
+    with_bullpen[2].bullpen.push_back(roster.add(make_player(0.5f)));
+    for (int reject = 0; reject < 2; ++reject) {
+        bool threw = false;
+        try {
+            if (reject == 0) {
+                const CudaSeasonSimulator sim(roster, teams, schedule, SimulationMode::PITCH);
+            } else {
+                const CudaSeasonSimulator sim(roster, with_bullpen, schedule);
+            }
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        if (!threw) {
+            std::cerr << (reject == 0 ? "pitch mode" : "a bullpen") << " was accepted\n";
+            return 1;
+        }
+    }
+
+    const SeasonSimulator cpu(roster, teams, schedule);
+    SeasonConfig config;
+    config.seed = 7;
+    config.replications = 257;
+
+    // A league the device can't play (or any league, without a device) falls
+    // back to the CPU engine.
+    const SeasonSimulator cpu_bullpen(roster, with_bullpen, schedule);
+    if (!same_results(cpu_bullpen.run(config), make_season_runner(roster, with_bullpen, schedule)->run(config))) {
+        std::cerr << "make_season_runner's fallback differs from SeasonSimulator\n";
+        return 1;
+    }
+
+    if (!CudaSeasonSimulator::available()) {
+        std::cout << "CudaSeasonSimulator skipped (no CUDA device)\n";
+        return 0;
+    }
+
+    const CudaSeasonSimulator gpu(roster, teams, schedule);
+    const SeasonRunner& runner = gpu;
+    for (const bool lines : {true, false}) {
+        config.player_lines = lines;
+        if (!same_results(cpu.run(config), runner.run(config))) {
+            std::cerr << "device seasons differ from the CPU's" << (lines ? "" : " without player lines") << "\n";
+            return 1;
+        }
+    }
+
+    std::cout << "CudaSeasonSimulator OK\n";
+    return 0;
+}
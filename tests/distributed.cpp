@@ -0,0 +1,218 @@
+#include "engine/sim/distributed.hpp"
+#include "tests/test_league.hpp"
+
+#include <arpa/inet.h>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <netinet/in.h>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+// Every field, spreads included, bit for bit: the wire encoding carries them all.
+bool same_results(const SeasonResults& a, const SeasonResults& b) {
+    return encode_season_results(a) == encode_season_results(b);
+}
+
+// A node that takes one unit and dies before answering or, given `reply`,
+// after sending reply(unit id) in place of the unit's results.
+class DroppingNode {
+public:
+    explicit DroppingNode(std::function<std::string(std::uint64_t)> reply = nullptr) {
+        fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        ::bind(fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        ::listen(fd_, 1);
+        socklen_t len = sizeof(addr);
+        ::getsockname(fd_, reinterpret_cast<sockaddr*>(&addr), &len);
+        port_ = ntohs(addr.sin_port);
+        thread_ = std::thread([this, reply] {
+            const int c = ::accept(fd_, nullptr, nullptr);
+            char request[45];  // magic, id .. replications, player_lines
+            if (!reply) {
+                ::recv(c, request, 16, 0);
+            } else if (::recv(c, request, sizeof(request), MSG_WAITALL) == sizeof(request)) {
+                std::uint64_t id;
+                std::memcpy(&id, request + 4, sizeof(id));
+                const std::string bytes = reply(id);
+                ::send(c, bytes.data(), bytes.size(), MSG_NOSIGNAL);
+            }
+            ::close(c);
+        });
+    }
+    ~DroppingNode() {
+        thread_.join();
+        ::close(fd_);
+    }
+    std::uint16_t port() const { return port_; }
+
+private:
+    int fd_;
+    std::uint16_t port_;
+    std::thread thread_;
+};
+
+template <class T>
+void append(std::string& out, T value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+// An OK reply header for unit `id`, announcing `size` bytes of payload.
+std::string ok_header(std::uint64_t id, std::uint64_t size) {
+    std::string out;
+    append(out, std::uint32_t{0x53524853});
+    append(out, std::uint8_t{0});
+    append(out, id);
+    append(out, size);
+    return out;
+}
+
+}  // namespace
+
+int main() {
+    const int num_teams = 4;
+    RosterStore roster;
+    const std::vector<Team> teams = make_teams(
+        roster, num_teams, [](int t, std::size_t s) { return 0.35f + 0.08f * t + 0.01f * s; },
+        [](int t) { return 0.45f + 0.04f * t; });
+    const std::vector<ScheduledGame> schedule = round_robin(num_teams);
+    const SeasonSimulator sim(roster, teams, schedule);
+
+    SeasonConfig config;
+    config.seed = 21;
+    config.replications = 70;
+    config.threads = 2;
+    const SeasonResults local = sim.run(config);
+
+    // Round trip through the wire format.
+    const SeasonResults decoded = decode_season_results(encode_season_results(local), sim.empty_results());
+    if (!same_results(local, decoded) || decoded.teams[1].season_runs_scored.m2() != local.teams[1].season_runs_scored.m2()) {
+        std::cerr << "season results do not round-trip\n";
+        return 1;
+    }
+    try {
+        decode_season_results(encode_season_results(local).substr(1), sim.empty_results());
+        std::cerr << "truncated results decoded\n";
+        return 1;
+    } catch (const std::runtime_error&) {
+    }
+
+    // A unit's nodes only decode against the unit they were played for.
+    {
+        ShardWorker worker(sim, 1);
+        WorkUnit unit;
+        unit.league = sim.fingerprint();
+        unit.seed = config.seed;
+        unit.first_replication = 5;
+        unit.replications = 9;
+        const std::string bytes = encode_unit_nodes(worker.run_unit(unit));
+        if (decode_unit_nodes(bytes, sim.empty_results(), unit).size() != 4) {  // [5, 6), [6, 8), [8, 12), [12, 14)
+            std::cerr << "unit nodes do not round-trip\n";
+            return 1;
+        }
+        unit.first_replication = 4;
+        try {
+            decode_unit_nodes(bytes, sim.empty_results(), unit);
+            std::cerr << "nodes for another unit decoded\n";
+            return 1;
+        } catch (const std::runtime_error&) {
+        }
+        // A node count no unit can hold is refused before anything is allocated.
+        std::string huge;
+        append(huge, std::uint64_t{1} << 60);
+        try {
+            decode_unit_nodes(huge, sim.empty_results(), unit);
+            std::cerr << "absurd node count decoded\n";
+            return 1;
+        } catch (const std::runtime_error&) {
+        }
+    }
+
+    // Two workers on loopback, each with its own copy of the league.
+    const SeasonSimulator remote(roster, teams, schedule);
+    ShardWorker worker_a(remote, 1);
+    ShardWorker worker_b(remote, 2);
+    const std::uint16_t port_a = worker_a.listen(0, "127.0.0.1");
+    const std::uint16_t port_b = worker_b.listen(0, "127.0.0.1");
+    std::thread serve_a([&] { worker_a.serve(); });
+    std::thread serve_b([&] { worker_b.serve(); });
+
+    int status = 0;
+    for (std::size_t unit : {7, 16, 64}) {
+        ShardOptions options;
+        options.replications_per_unit = unit;
+        options.timeout_ms = 10000;
+        ShardCoordinator coordinator({{"127.0.0.1", port_a}, {"127.0.0.1", port_b}}, options);
+        const SeasonResults sharded = coordinator.run(sim, config);
+        if (!same_results(local, sharded) || coordinator.last_run().units != (70 + unit - 1) / unit) {
+            std::cerr << "sharded run (units of " << unit << ") differs from the local one\n";
+            status = 1;
+        }
+    }
+
+    // A node lost mid-unit: its unit is issued again and the totals do not change.
+    {
+        DroppingNode dropping;
+        ShardOptions options;
+        options.replications_per_unit = 10;
+        options.timeout_ms = 10000;
+        ShardCoordinator coordinator({{"127.0.0.1", dropping.port()}, {"127.0.0.1", port_a}}, options);
+        const SeasonResults sharded = coordinator.run(sim, config);
+        if (!same_results(local, sharded) || coordinator.last_run().workers_lost != 1 || coordinator.last_run().reissued != 1) {
+            std::cerr << "lost node was not recovered from\n";
+            status = 1;
+        }
+    }
+
+    // Replies announcing more than a unit can hold, in bytes or in nodes: the
+    // sender is dropped like a lost node instead of taking the run down.
+    const std::function<std::string(std::uint64_t)> liars[] = {
+        [](std::uint64_t id) { return ok_header(id, ~std::uint64_t{0}); },
+        [](std::uint64_t id) {
+            std::string out = ok_header(id, sizeof(std::uint64_t));
+            append(out, ~std::uint64_t{0});
+            return out;
+        },
+    };
+    for (const auto& liar : liars) {
+        DroppingNode lying(liar);
+        ShardOptions options;
+        options.replications_per_unit = 10;
+        options.timeout_ms = 10000;
+        ShardCoordinator coordinator({{"127.0.0.1", lying.port()}, {"127.0.0.1", port_a}}, options);
+        const SeasonResults sharded = coordinator.run(sim, config);
+        if (!same_results(local, sharded) || coordinator.last_run().workers_lost != 1 || coordinator.last_run().reissued != 1) {
+            std::cerr << "oversized reply was not recovered from\n";
+            status = 1;
+        }
+    }
+
+    // A worker refuses units for a different league.
+    {
+        std::vector<Team> other = teams;
+        std::swap(other[0].lineup[0], other[0].lineup[1]);
+        const SeasonSimulator other_sim(roster, other, schedule);
+        ShardCoordinator coordinator({{"127.0.0.1", port_b}});
+        try {
+            coordinator.run(other_sim, config);
+            std::cerr << "league mismatch accepted\n";
+            status = 1;
+        } catch (const std::runtime_error&) {
+        }
+    }
+
+    worker_a.stop();
+    worker_b.stop();
+    serve_a.join();
+    serve_b.join();
+    if (status == 0) std::cout << "Distributed OK\n";
+    return status;
+}
@@ -0,0 +1,128 @@
+#include "engine/sim/event_log.hpp"
+#include "engine/sim/season_simulator.hpp"
+#include "tests/test_league.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+int main() {
+    const std::string path = "event_log_test.bin";
+    std::remove(path.c_str());
+
+    // Two writers with tiny buffers, then reopen and append: one header, every record.
+    {
+        EventLog log(path);
+        EventLogWriter a = log.writer(3);
+        EventLogWriter b = log.writer(5);
+        for (std::uint16_t i = 0; i < 10; ++i) {
+            PlateAppearanceEvent e{};
+            e.game_id = 1;
+            e.pa_index = i;
+            a.append(e);
+            e.game_id = 2;
+            b.append(e);
+        }
+    }
+    {
+        EventLog log(path);
+        EventLogWriter w = log.writer();
+        PlateAppearanceEvent e{};
+        e.game_id = 3;
+        w.append(e);
+        w.flush();
+    }
+    {
+        const EventLogReader reader = EventLogReader::open(path);
+        std::map<std::uint64_t, int> per_game;
+        for (const PlateAppearanceEvent& e : reader) ++per_game[e.game_id];
+        if (reader.size() != 21 || per_game[1] != 10 || per_game[2] != 10 || per_game[3] != 1) {
+            std::cerr << "event log lost or duplicated records\n";
+            return 1;
+        }
+    }
+
+    // A season with logging: same results as without, and the log replays every game.
+    RosterStore roster;
+    const std::vector<Team> teams = make_teams(
+        roster, 2, [](int t, std::size_t s) { return 0.35f + 0.03f * s + 0.1f * t; }, [](int) { return 0.5f; });
+    const SeasonSimulator sim(roster, teams, {{0, 1}, {1, 0}, {0, 1}});
+    SeasonConfig config;
+    config.seed = 21;
+    config.replications = 40;
+    config.threads = 2;
+    std::remove(path.c_str());
+    SeasonResults logged;
+    {
+        EventLog log(path);
+        logged = sim.run(config, &log);
+    }
+    const SeasonResults plain = sim.run(config);
+    if (logged.teams[0].runs_scored != plain.teams[0].runs_scored || logged.teams[1].wins != plain.teams[1].wins) {
+        std::cerr << "logging changed the simulation\n";
+        return 1;
+    }
+
+    const EventLogReader reader = EventLogReader::open(path);
+    std::map<std::uint64_t, std::vector<const PlateAppearanceEvent*>> games;
+    std::uint64_t total_runs = 0;
+    for (const PlateAppearanceEvent& e : reader) {
+        games[e.game_id].push_back(&e);
+        total_runs += e.runs;
+    }
+    const std::uint64_t expected_runs = plain.teams[0].runs_scored + plain.teams[1].runs_scored;
+    if (games.size() != config.replications * sim.schedule().size() || total_runs != expected_runs) {
+        std::cerr << "log does not cover the season\n";
+        return 1;
+    }
+    for (const auto& [id, events] : games) {
+        for (std::size_t i = 0; i < events.size(); ++i) {
+            if (events[i]->pa_index != i) {
+                std::cerr << "PAs of game " << id << " out of order\n";
+                return 1;
+            }
+        }
+        // Pre-states chain: each PA starts where the previous one left the game.
+        const GameState first = GameState::from_raw(events.front()->state);
+        if (first != GameState()) {
+            std::cerr << "game " << id << " does not start from a fresh state\n";
+            return 1;
+        }
+        GameState replay = first;
+        for (const PlateAppearanceEvent* e : events) {
+            if (GameState::from_raw(e->state) != replay) {
+                std::cerr << "game " << id << " pre-state mismatch at PA " << e->pa_index << "\n";
+                return 1;
+            }
+            replay.apply(static_cast<PlateAppearanceResult>(e->result));
+        }
+        if (!replay.final()) {
+            std::cerr << "game " << id << " log stops before the game ended\n";
+            return 1;
+        }
+    }
+
+    // Anything else in the file is refused.
+    {
+        std::ofstream junk(path, std::ios::binary | std::ios::trunc);
+        junk << std::string(100, 'x');
+    }
+    bool threw = false;
+    try {
+        EventLog log(path);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    std::remove(path.c_str());
+    if (!threw) {
+        std::cerr << "foreign file accepted as an event log\n";
+        return 1;
+    }
+
+    std::cout << "event_log ok (" << reader.size() << " PAs)\n";
+    return 0;
+}
@@ -0,0 +1,190 @@
+#include "engine/sim/event_log.hpp"
+#include "engine/sim/game.hpp"
+#include "engine/sim/season_simulator.hpp"
+#include "tests/test_league.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+Player tiring_player(float r, float stamina) {
+    return make_player(batter_ratings(r), pitcher_ratings(r, stamina));
+}
+
+float probability(const OutcomeDistribution& dist, PlateAppearanceResult r) {
+    float probs[kNumPlateAppearanceResults];
+    outcome_probabilities(dist, probs);
+    return probs[static_cast<std::size_t>(r)];
+}
+
+}  // namespace
+
+int main() {
+    RosterStore roster;
+    std::vector<PlayerId> batters;
+    for (int s = 0; s < 9; ++s) batters.push_back(roster.add(make_player(0.45f + 0.01f * s)));
+    const std::vector<PlayerId> pitchers = {roster.add(tiring_player(0.6f, 0.1f)), roster.add(tiring_player(0.6f, 0.9f))};
+
+    // Bucket 0 is the fresh pitcher, identical to the table built without fatigue;
+    // each later bucket gives up more walks and homers and gets fewer strikeouts.
+    const MatchupTable fresh(roster, batters, pitchers);
+    const MatchupTable tiring(roster, batters, pitchers, FatigueModel::standard());
+    if (fresh.fatigue_buckets() != 1 || tiring.fatigue_buckets() != kMaxFatigueBuckets ||
+        tiring.num_pitchers() != pitchers.size()) {
+        std::cerr << "wrong bucket counts\n";
+        return 1;
+    }
+    for (std::size_t p = 0; p < pitchers.size(); ++p) {
+        for (std::size_t b = 0; b < batters.size(); ++b) {
+            if (std::memcmp(&fresh.at(b, p), &tiring.at(b, p, 0), sizeof(OutcomeDistribution)) != 0) {
+                std::cerr << "fresh bucket differs from the no-fatigue table\n";
+                return 1;
+            }
+            for (unsigned k = 1; k < kMaxFatigueBuckets; ++k) {
+                const OutcomeDistribution& before = tiring.at(b, p, k - 1);
+                const OutcomeDistribution& after = tiring.at(b, p, k);
+                if (probability(after, PlateAppearanceResult::WALK) <= probability(before, PlateAppearanceResult::WALK) ||
+                    probability(after, PlateAppearanceResult::STRIKEOUT) >= probability(before, PlateAppearanceResult::STRIKEOUT) ||
+                    probability(after, PlateAppearanceResult::HOMERUN) <= probability(before, PlateAppearanceResult::HOMERUN)) {
+                    std::cerr << "bucket " << k << " is not more tired than bucket " << k - 1 << "\n";
+                    return 1;
+                }
+            }
+        }
+    }
+
+    // Schedules: strictly later buckets, and more stamina tires later.
+    const FatigueSchedule& low = tiring.fatigue_schedule(0);
+    const FatigueSchedule& high = tiring.fatigue_schedule(1);
+    for (std::size_t k = 1; k < kMaxFatigueBuckets; ++k) {
+        if (low.starts[k] <= low.starts[k - 1] || high.starts[k] <= low.starts[k]) {
+            std::cerr << "fatigue schedule out of order at bucket " << k << "\n";
+            return 1;
+        }
+    }
+    if (low.starts[kMaxFatigueBuckets] != kNeverTired || fresh.fatigue_schedule(0).starts[1] != kNeverTired) {
+        std::cerr << "unused buckets should never start\n";
+        return 1;
+    }
+
+    // Without fatigue or a bullpen, games draw exactly as the starters-only PA loop.
+    GameLineup home{};
+    GameLineup away{};
+    for (std::size_t s = 0; s < kLineupSize; ++s) home.batters[s] = away.batters[s] = static_cast<std::uint32_t>(s);
+    home.pitcher = 0;
+    away.pitcher = 1;
+    for (std::uint64_t seed = 0; seed < 50; ++seed) {
+        RNG game(seed);
+        const GameResult r = simulate_game(fresh, home, away, game);
+        RNG step(seed);
+        GameState state;
+        while (!state.final()) play_plate_appearance(fresh, home, away, state, step);
+        if (r.home_runs != state.home_score() || r.away_runs != state.away_score() || r.home_relievers != 0) {
+            std::cerr << "no-fatigue game changed\n";
+            return 1;
+        }
+    }
+
+    // A bullpen that never gets called puts the game on the full staff loop;
+    // it still has to draw exactly as the starters-only loop.
+    GameLineup idle_home = home;
+    idle_home.bullpen_size = 1;
+    idle_home.bullpen[0] = 1;
+    idle_home.policy.pull_at_bucket = idle_home.policy.late_pull_at_bucket = 99;
+    for (std::uint64_t seed = 0; seed < 50; ++seed) {
+        RNG lean(seed);
+        RNG staffed(seed);
+        const GameResult a = simulate_game(fresh, home, away, lean);
+        const GameResult b = simulate_game(fresh, idle_home, away, staffed);
+        if (a.home_runs != b.home_runs || a.away_runs != b.away_runs || a.plate_appearances != b.plate_appearances ||
+            b.home_relievers != 0) {
+            std::cerr << "staff loop and starters-only loop disagree\n";
+            return 1;
+        }
+    }
+
+    // With a bullpen, the low-stamina starter leaves sooner and so faces fewer
+    // batters (the first reliever's appearances count the games the starter did
+    // not finish).
+    const int num_teams = 2;
+    std::vector<Team> teams(num_teams);
+    for (int t = 0; t < num_teams; ++t) {
+        teams[t].name = "Team " + std::to_string(t);
+        for (std::size_t s = 0; s < kLineupSize; ++s) teams[t].lineup.push_back(roster.add(make_player(0.5f)));
+        teams[t].starting_pitcher = roster.add(tiring_player(0.5f, t == 0 ? 0.0f : 1.0f));
+        for (int r = 0; r < 3; ++r) teams[t].bullpen.push_back(roster.add(tiring_player(0.5f, 0.1f)));
+    }
+    std::vector<ScheduledGame> schedule;
+    for (int round = 0; round < 20; ++round) schedule.push_back({static_cast<std::uint32_t>(round & 1), static_cast<std::uint32_t>(1 - (round & 1))});
+
+    SeasonConfig config;
+    config.seed = 3;
+    config.replications = 16;
+    config.threads = 2;
+    for (SimulationMode mode : {SimulationMode::PLATE_APPEARANCE, SimulationMode::PITCH}) {
+        const FatigueModel model = mode == SimulationMode::PITCH ? FatigueModel::pitch_count() : FatigueModel::standard();
+        const SeasonSimulator sim(roster, teams, schedule, mode, model);
+        const SeasonResults results = sim.run(config);
+        std::uint64_t pulled[num_teams] = {};
+        std::uint64_t starter_faced[num_teams] = {};
+        std::uint64_t runs_allowed = 0;
+        std::uint64_t runs_scored = 0;
+        std::uint64_t faced = 0;
+        std::uint64_t batter_pas = 0;
+        for (const PitcherSeasonTotals& p : results.pitchers) {
+            for (int t = 0; t < num_teams; ++t) {
+                if (p.id == teams[t].bullpen[0]) pulled[t] = p.relief_appearances;
+                if (p.id == teams[t].starting_pitcher) starter_faced[t] = p.against.plate_appearances();
+            }
+            runs_allowed += p.runs_allowed;
+            faced += p.against.plate_appearances();
+        }
+        for (const BatterSeasonTotals& b : results.batters) batter_pas += b.line.plate_appearances();
+        for (const TeamSeasonTotals& t : results.teams) runs_scored += t.runs_scored;
+        if (pulled[0] == 0 || pulled[0] < pulled[1] || 4 * starter_faced[0] > 3 * starter_faced[1] ||
+            runs_allowed != runs_scored || faced != batter_pas) {
+            std::cerr << "bullpen usage looks wrong: starters faced " << starter_faced[0] << " / " << starter_faced[1] << "\n";
+            return 1;
+        }
+    }
+
+    // Every relief appearance is a reliever who faced a batter: the manager
+    // doesn't make a change after the PA that ends the game. Deep, quickly
+    // tiring bullpens make late changes common.
+    std::vector<Team> deep = teams;
+    std::set<PlayerId> relievers;
+    for (Team& team : deep) {
+        team.bullpen.clear();
+        for (int r = 0; r < 7; ++r) team.bullpen.push_back(roster.add(tiring_player(0.5f, 0.0f)));
+        relievers.insert(team.bullpen.begin(), team.bullpen.end());
+    }
+    const std::string path = "fatigue_test_events.bin";
+    for (SimulationMode mode : {SimulationMode::PLATE_APPEARANCE, SimulationMode::PITCH}) {
+        std::remove(path.c_str());
+        const SeasonSimulator sim(roster, deep, schedule, mode, FatigueModel::standard());
+        std::uint64_t appearances = 0;
+        {
+            EventLog log(path);
+            for (const PitcherSeasonTotals& p : sim.run(config, &log).pitchers) appearances += p.relief_appearances;
+        }
+        std::set<std::pair<std::uint64_t, std::uint32_t>> seen;  // (game, reliever)
+        for (const PlateAppearanceEvent& e : EventLogReader::open(path)) {
+            if (relievers.count(e.pitcher)) seen.insert({e.game_id, e.pitcher});
+        }
+        std::remove(path.c_str());
+        if (appearances == 0 || appearances != seen.size()) {
+            std::cerr << (mode == SimulationMode::PITCH ? "pitch" : "PA") << " mode: " << appearances
+                      << " relief appearances, " << seen.size() << " relievers faced a batter\n";
+            return 1;
+        }
+    }
+
+    std::cout << "Fatigue OK\n";
+    return 0;
+}
@@ -0,0 +1,103 @@
+#include "engine/sim/game_state.hpp"
+
+#include <iostream>
+
+namespace {
+
+constexpr std::size_t idx(PlateAppearanceResult r) { return static_cast<std::size_t>(r); }
+
+// Spot checks on the base-running table, worked out by hand.
+static_assert(kBaseOutTransitions[base_out_index(7, 0)][idx(PlateAppearanceResult::WALK)].runs == 1, "bases-loaded walk scores");
+static_assert(kBaseOutTransitions[base_out_index(2, 0)][idx(PlateAppearanceResult::WALK)].next == base_out_index(3, 0), "walk doesn't push an unforced runner");
+static_assert(kBaseOutTransitions[base_out_index(5, 1)][idx(PlateAppearanceResult::SINGLE)].next == base_out_index(3, 1), "single: first to second");
+static_assert(kBaseOutTransitions[base_out_index(5, 1)][idx(PlateAppearanceResult::SINGLE)].runs == 1, "single: third scores");
+static_assert(kBaseOutTransitions[base_out_index(1, 2)][idx(PlateAppearanceResult::DOUBLE)].next == base_out_index(6, 2), "double: first to third");
+static_assert(kBaseOutTransitions[base_out_index(7, 2)][idx(PlateAppearanceResult::HOMERUN)].runs == 4, "grand slam");
+static_assert(kBaseOutTransitions[base_out_index(3, 2)][idx(PlateAppearanceResult::OUT)].next == base_out_index(3, 3), "third out");
+
+void play(GameState& s, PlateAppearanceResult r, int times = 1) {
+    for (int i = 0; i < times; ++i) s.apply(r);
+}
+
+}  // namespace
+
+int main() {
+    GameState s;
+    if (s.inning() != 1 || s.bottom() || s.final() || s.base_out() != 0 || s.away_score() != 0) {
+        std::cerr << "fresh state is not top of the first\n";
+        return 1;
+    }
+
+    s.set_count_id(3 * 4 + 2);
+    if (s.balls() != 3 || s.strikes() != 2 || s.base_out() != 0 || s.inning() != 1) {
+        std::cerr << "count bits overlap other fields\n";
+        return 1;
+    }
+
+    // Three walks then a slam: runners and runs go to the side at bat, the count resets.
+    play(s, PlateAppearanceResult::WALK, 3);
+    play(s, PlateAppearanceResult::HOMERUN);
+    if (s.away_score() != 4 || s.home_score() != 0 || s.bases() != 0 || s.count_id() != 0
+        || s.lineup_slot(false) != 4 || s.lineup_slot(true) != 0) {
+        std::cerr << "slam not credited to the visitors\n";
+        return 1;
+    }
+    play(s, PlateAppearanceResult::STRIKEOUT, 3);
+    if (!s.bottom() || s.inning() != 1 || s.base_out() != 0 || s.lineup_slot(false) != 7) {
+        std::cerr << "three outs did not end the top half\n";
+        return 1;
+    }
+
+    // Lineup slot wraps after the ninth batter.
+    play(s, PlateAppearanceResult::OUT, 3);
+    play(s, PlateAppearanceResult::OUT, 2);
+    if (s.lineup_slot(false) != 0 || s.inning() != 2 || s.outs() != 2) {
+        std::cerr << "lineup slot did not wrap\n";
+        return 1;
+    }
+
+    // Walk-off: home trails by one in the bottom of the 9th and hits a two-run homer.
+    GameState w;
+    w.set_inning(9, true);
+    w.set_score(3, 2);
+    play(w, PlateAppearanceResult::SINGLE);
+    if (w.final()) {
+        std::cerr << "game ended before the home side led\n";
+        return 1;
+    }
+    play(w, PlateAppearanceResult::HOMERUN);
+    if (!w.final() || w.home_score() != 4) {
+        std::cerr << "walk-off not detected\n";
+        return 1;
+    }
+
+    // Home side doesn't bat in the 9th when ahead; a tie after nine goes to the 10th.
+    GameState ahead;
+    ahead.set_inning(9, false);
+    ahead.set_score(1, 2);
+    play(ahead, PlateAppearanceResult::OUT, 3);
+    GameState tied;
+    tied.set_inning(9, true);
+    tied.set_score(2, 2);
+    play(tied, PlateAppearanceResult::OUT, 3);
+    if (!ahead.final() || tied.final() || tied.inning() != 10 || tied.bottom()) {
+        std::cerr << "end-of-game rules wrong\n";
+        return 1;
+    }
+
+    // A leadoff homer in the 10th mustn't end the game before the home half.
+    play(tied, PlateAppearanceResult::HOMERUN);
+    if (tied.final()) {
+        std::cerr << "game ended mid top half\n";
+        return 1;
+    }
+
+    // Raw round trip: the state really is just its bits.
+    if (GameState::from_raw(tied.raw()) != tied) {
+        std::cerr << "raw round trip failed\n";
+        return 1;
+    }
+
+    std::cout << "game_state ok\n";
+    return 0;
+}
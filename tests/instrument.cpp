@@ -0,0 +1,116 @@
+#include "engine/core/instrument.hpp"
+#include "engine/sim/game.hpp"
+#include "engine/sim/season_simulator.hpp"
+#include "tests/test_league.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::size_t occurrences(const std::string& text, const std::string& what) {
+    std::size_t n = 0;
+    for (std::size_t at = text.find(what); at != std::string::npos; at = text.find(what, at + 1)) ++n;
+    return n;
+}
+
+std::string read_file(const std::string& path) {
+    std::ifstream in(path);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+}
+
+}  // namespace
+
+// Runs in both builds: with THREEUP3DOWN_INSTRUMENT=ON the counters and trace
+// must account for every PA; without it everything must stay at zero.
+int main() {
+    RosterStore roster;
+    const std::vector<Team> teams = make_teams(
+        roster, 2, [](int, std::size_t s) { return 0.45f + 0.02f * s; }, [](int) { return 0.5f; });
+    const std::vector<PlayerId> pitchers = {teams[0].starting_pitcher, teams[1].starting_pitcher};
+    const std::uint64_t scale = instrument::kEnabled ? 1 : 0;
+
+    instrument::reset_counters();
+    const MatchupTable table(roster, teams[0].lineup, pitchers);
+    GameLineup home{};
+    GameLineup away{};
+    for (std::size_t s = 0; s < kLineupSize; ++s) home.batters[s] = away.batters[s] = static_cast<std::uint32_t>(s);
+    home.pitcher = 0;
+    away.pitcher = 1;
+    RNG rng(3);
+    const GameResult game = simulate_game(table, home, away, rng);
+    const instrument::CounterTotals one = instrument::counter_totals();
+    const std::uint64_t pas = static_cast<std::uint64_t>(game.plate_appearances);
+    if (one[Counter::PLATE_APPEARANCES] != scale * pas || one[Counter::RNG_DRAWS] != scale * pas ||
+        one[Counter::TABLE_LOOKUPS] != scale * pas || one[Counter::CACHE_REBUILDS] != scale) {
+        std::cerr << "one game counted " << one[Counter::PLATE_APPEARANCES] << " PAs, " << one[Counter::RNG_DRAWS]
+                  << " draws, " << one[Counter::TABLE_LOOKUPS] << " lookups for " << pas << " PAs\n";
+        return 1;
+    }
+
+    // A threaded season: the pool's threads have exited by the time we read, so
+    // their counts must have been folded into the totals.
+    std::vector<ScheduledGame> schedule;
+    for (int g = 0; g < 10; ++g) schedule.push_back({static_cast<std::uint32_t>(g % 2), static_cast<std::uint32_t>(1 - g % 2)});
+    const SeasonSimulator sim(roster, teams, schedule);
+    instrument::reset_counters();
+    instrument::TraceConfig trace;
+    trace.sample_every = 4;
+    instrument::start_trace(trace);
+    SeasonConfig config;
+    config.seed = 9;
+    config.replications = 8;
+    config.threads = 2;
+    const SeasonResults results = sim.run(config);
+    instrument::stop_trace();
+    std::uint64_t season_pas = 0;
+    for (const BatterSeasonTotals& b : results.batters) season_pas += b.line.plate_appearances();
+    const instrument::CounterTotals season = instrument::counter_totals();
+    if (season[Counter::PLATE_APPEARANCES] != scale * season_pas || season[Counter::TABLE_LOOKUPS] != scale * season_pas ||
+        season[Counter::RNG_DRAWS] < scale * season_pas) {
+        std::cerr << "season counted " << season[Counter::PLATE_APPEARANCES] << " PAs, expected " << season_pas << "\n";
+        return 1;
+    }
+
+    // One in four of each scope, per thread: 80 games over a few threads sample 20 to 23.
+    const std::size_t recorded = instrument::recorded_events();
+    const std::string path = "instrument_test_trace.json";
+    instrument::write_chrome_trace(path);
+    const std::string json = read_file(path);
+    std::remove(path.c_str());
+    const std::size_t games = occurrences(json, "\"name\":\"game\"");
+    if (json.rfind("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", 0) != 0 ||
+        occurrences(json, "\"plate_appearances\":" + std::to_string(season[Counter::PLATE_APPEARANCES])) != 1 ||
+        occurrences(json, "\"ph\":\"X\"") != recorded || instrument::recorded_events() != 0) {
+        std::cerr << "malformed trace\n";
+        return 1;
+    }
+    if (instrument::kEnabled ? (games < 20 || games > 23 || occurrences(json, "\"name\":\"replication\"") < 2 ||
+                                occurrences(json, "\"name\":\"half_inning\"") <= games)
+                             : recorded != 0) {
+        std::cerr << "trace recorded " << games << " of 80 games\n";
+        return 1;
+    }
+
+    // Past the per-thread cap, events are dropped rather than grown without bound.
+    trace.sample_every = 1;
+    trace.max_events_per_thread = 5;
+    instrument::start_trace(trace);
+    RNG more(4);
+    for (int g = 0; g < 3; ++g) simulate_game(table, home, away, more);
+    instrument::stop_trace();
+    if (instrument::recorded_events() != 5 * scale || (instrument::kEnabled && instrument::dropped_events() == 0)) {
+        std::cerr << "trace cap not applied\n";
+        return 1;
+    }
+
+    std::cout << "Instrument OK (" << (instrument::kEnabled ? "enabled" : "compiled out") << ", "
+              << season_pas << " season PAs)\n";
+    return 0;
+}
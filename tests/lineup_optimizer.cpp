@@ -0,0 +1,100 @@
+#include "engine/sim/lineup_optimizer.hpp"
+#include "engine/sim/run_expectancy.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+namespace {
+
+OutcomeDistribution batter(float contact, float power, float eye) {
+    return outcome_distribution(contact, power, eye, 0.5f, 0.5f, 0.5f, 0);
+}
+
+}  // namespace
+
+int main() {
+    // Four distinct batter types (2 + 2 + 2 + 3): 7560 distinct orderings.
+    const OutcomeDistribution types[4] = {
+        batter(0.9f, 0.2f, 0.8f), batter(0.5f, 0.9f, 0.4f), batter(0.6f, 0.5f, 0.6f), batter(0.2f, 0.2f, 0.2f)};
+    const int type_of[kLineupSize] = {3, 0, 1, 3, 2, 0, 3, 1, 2};
+    std::array<OutcomeDistribution, kLineupSize> slots;
+    for (std::size_t s = 0; s < kLineupSize; ++s) slots[s] = types[type_of[s]];
+    const LineupOptimizer small(slots);
+    LineupOptimizerConfig two_threads;
+    two_threads.threads = 2;
+    const LineupOptimizerResult best = small.optimize(two_threads);
+    if (best.orderings != 7560) {
+        std::cerr << "symmetry pruning visited " << best.orderings << " orderings\n";
+        return 1;
+    }
+    if (std::fabs(small.evaluate(best.order) - best.expected_runs) > 1e-9) {
+        std::cerr << "reported value " << best.expected_runs << " vs " << small.evaluate(best.order) << "\n";
+        return 1;
+    }
+
+    // Nine distinct batters: nothing to fold by symmetry, so all 9! orderings.
+    std::array<OutcomeDistribution, kLineupSize> all_distinct;
+    for (std::size_t s = 0; s < kLineupSize; ++s) {
+        all_distinct[s] = batter(0.2f + 0.08f * s, 0.8f - 0.07f * s, 0.3f + 0.05f * ((s * 4) % 9));
+    }
+    const LineupOptimizer nine(all_distinct);
+    const LineupOptimizerResult every = nine.optimize();
+    if (every.orderings != 362880) {
+        std::cerr << "nine distinct batters visited " << every.orderings << " orderings\n";
+        return 1;
+    }
+    std::array<OutcomeDistribution, kLineupSize> nine_ordered;
+    for (std::size_t s = 0; s < kLineupSize; ++s) nine_ordered[s] = all_distinct[every.order[s]];
+    if (std::fabs(RunExpectancySolver(nine_ordered).expected_runs() - every.expected_runs) > 1e-6) {
+        std::cerr << "nine-batter optimum disagrees with the solver\n";
+        return 1;
+    }
+
+    // Five types (1 + 1 + 2 + 2 + 3), 15120 orderings: agrees with the solver, beats
+    // any shuffle, and doesn't depend on the thread count.
+    const int mixed_type[kLineupSize] = {0, 1, 2, 2, 3, 3, 4, 4, 4};
+    std::array<OutcomeDistribution, kLineupSize> distinct;
+    for (std::size_t s = 0; s < kLineupSize; ++s) {
+        const int t = mixed_type[s];
+        distinct[s] = batter(0.2f + 0.15f * t, 0.9f - 0.18f * t, 0.3f + 0.1f * ((t * 3) % 5));
+    }
+    const LineupOptimizer optimizer(distinct);
+    const auto start = std::chrono::steady_clock::now();
+    LineupOptimizerConfig one_thread;
+    one_thread.threads = 1;
+    const LineupOptimizerResult r1 = optimizer.optimize(one_thread);
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    LineupOptimizerConfig three_threads;
+    three_threads.threads = 3;
+    const LineupOptimizerResult r3 = optimizer.optimize(three_threads);
+    if (r1.order != r3.order || r1.expected_runs != r3.expected_runs) {
+        std::cerr << "result depends on thread count\n";
+        return 1;
+    }
+
+    std::array<OutcomeDistribution, kLineupSize> ordered;
+    for (std::size_t s = 0; s < kLineupSize; ++s) ordered[s] = distinct[r1.order[s]];
+    const double exact = RunExpectancySolver(ordered).expected_runs();
+    if (std::fabs(exact - r1.expected_runs) > 1e-6) {
+        std::cerr << "optimizer value " << r1.expected_runs << " vs solver " << exact << "\n";
+        return 1;
+    }
+
+    std::array<std::size_t, kLineupSize> order;
+    for (std::size_t s = 0; s < kLineupSize; ++s) order[s] = s;
+    RNG rng(17);
+    for (int trial = 0; trial < 300; ++trial) {
+        if (optimizer.evaluate(order) > r1.expected_runs + 1e-9) {
+            std::cerr << "found an ordering better than the optimum\n";
+            return 1;
+        }
+        for (std::size_t i = kLineupSize - 1; i > 0; --i) {
+            std::swap(order[i], order[static_cast<std::size_t>(rng.uniform() * (i + 1))]);
+        }
+    }
+
+    std::cout << "lineup_optimizer ok (" << r1.expected_runs << " runs, " << r1.orderings << " orderings, " << seconds << " s)\n";
+    return 0;
+}
@@ -0,0 +1,98 @@
+#include "engine/sim/matchup_table.hpp"
+#include "engine/sim/plate_appearence.hpp"
+#include "tests/test_league.hpp"
+
+#include <iostream>
+#include <vector>
+
+int main() {
+    RosterStore roster;
+    std::vector<PlayerId> batters;
+    std::vector<PlayerId> pitchers;
+    for (int i = 0; i < 6; ++i) {
+        float r = 0.1f + 0.15f * i;
+        const PlayerId id = roster.add(make_player(
+            BatterRatings{r, 1.0f - r, r * 0.5f, 0.5f, 0.5f, 0.5f}, PitcherRatings{r, 1.0f - r, r * 0.8f, 0.5f}));
+        batters.push_back(id);
+        // Pitchers in a different order than batters so row/column mixups show up.
+        pitchers.insert(pitchers.begin(), id);
+    }
+
+    MatchupTable table(roster, batters, pitchers);
+    if (table.num_batters() != batters.size() || table.num_pitchers() != pitchers.size()) {
+        std::cerr << "matchup table has wrong shape\n";
+        return 1;
+    }
+
+    for (std::size_t p = 0; p < pitchers.size(); ++p) {
+        for (std::size_t b = 0; b < batters.size(); ++b) {
+            RNG direct_rng(1234);
+            RNG table_rng(1234);
+            PlateAppearance direct(roster.player(batters[b]), roster.player(pitchers[p]), direct_rng);
+            PlateAppearance cached(table.at(b, p), table_rng);
+            for (int i = 0; i < 1000; ++i) {
+                if (direct.resolve() != cached.resolve()) {
+                    std::cerr << "table path diverged for batter " << b << " pitcher " << p << "\n";
+                    return 1;
+                }
+            }
+        }
+    }
+
+    if (platoon_same(Handedness::LEFT, Handedness::LEFT) != 1 ||
+        platoon_same(Handedness::RIGHT, Handedness::LEFT) != 0 ||
+        platoon_same(Handedness::SWITCH, Handedness::SWITCH) != 0) {
+        std::cerr << "platoon_same has the wrong truth table\n";
+        return 1;
+    }
+    // Same-handed matchups strike out more often in the league tables.
+    const OutcomeDistribution opposite = outcome_distribution(0.5f, 0.5f, 0.5f, 0.5f, 0.5f, 0.5f, 0);
+    const OutcomeDistribution same = outcome_distribution(0.5f, 0.5f, 0.5f, 0.5f, 0.5f, 0.5f, 1);
+    if (same.cumulative[1] - same.cumulative[0] <= opposite.cumulative[1] - opposite.cumulative[0]) {
+        std::cerr << "platoon adjustment not applied\n";
+        return 1;
+    }
+
+    // Policy variants of the PA: league rates ignore ratings, NoPlatoon ignores hands.
+    const Player& batter = roster.player(batters[0]);
+    const Player& pitcher = roster.player(pitchers[2]);
+    const int same_hand = platoon_same(batter.bats, pitcher.throws);
+    RNG policy_rng(5);
+    const BasicPlateAppearance<LeagueOutcomes, NoPlatoon> league(batter, pitcher, policy_rng);
+    const BasicPlateAppearance<LeagueOutcomes, PlatoonSplit> league_split(batter, pitcher, policy_rng);
+    const BasicPlateAppearance<RatingsOutcomes, NoPlatoon> neutral(batter, pitcher, policy_rng);
+    const BasicPlateAppearance<RatingsOutcomes, PlatoonSplit> split(batter, pitcher, policy_rng);
+    const PlateAppearance plain(batter, pitcher, policy_rng);
+    for (std::size_t i = 0; i + 1 < kNumPlateAppearanceResults; ++i) {
+        if (league.distribution().cumulative[i] != kLeagueOutcomeRates.cumulative[i] ||
+            league_split.distribution().cumulative[i] != kPlatoonOutcomeRates[same_hand].cumulative[i] ||
+            split.distribution().cumulative[i] != plain.distribution().cumulative[i]) {
+            std::cerr << "PA policy " << i << " picked the wrong distribution\n";
+            return 1;
+        }
+    }
+    const OutcomeDistribution mid_neutral = neutral_outcome_distribution(0.5f, 0.5f, 0.5f, 0.5f, 0.5f, 0.5f);
+    const float walks[3] = {opposite.cumulative[0], mid_neutral.cumulative[0], same.cumulative[0]};
+    if (neutral.distribution().cumulative[6] <= 0.f || (walks[1] - walks[0]) * (walks[2] - walks[1]) <= 0.f) {
+        std::cerr << "neutral matchup is not between the platoon sides\n";
+        return 1;
+    }
+
+    // The same policies build whole tables.
+    const MatchupTable neutral_table(roster, batters, pitchers, FatigueModel(), RatingsOutcomes{}, NoPlatoon{});
+    for (std::size_t p = 0; p < pitchers.size(); ++p) {
+        for (std::size_t b = 0; b < batters.size(); ++b) {
+            const OutcomeDistribution expected = matchup_distribution<RatingsOutcomes, NoPlatoon>(
+                roster.player(batters[b]), roster.player(pitchers[p]));
+            for (std::size_t i = 0; i + 1 < kNumPlateAppearanceResults; ++i) {
+                if (neutral_table.at(b, p).cumulative[i] != expected.cumulative[i]) {
+                    std::cerr << "NoPlatoon table differs from the PA policy at " << b << ", " << p << "\n";
+                    return 1;
+                }
+            }
+        }
+    }
+
+    std::cout << "MatchupTable OK\n";
+    return 0;
+}
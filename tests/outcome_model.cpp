@@ -0,0 +1,153 @@
+#include "engine/model/outcome_model.hpp"
+#include "engine/model/outcome_rates.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+template<typename T>
+void put(std::ofstream& out, T v) {
+    out.write(reinterpret_cast<const char*>(&v), sizeof(v));
+}
+
+// Hand-built export in the pa_model.py export_model_trees() layout: one boosting
+// round, eight classes in LabelEncoder (alphabetical) order, class 0 ("Double")
+// split on count_id.
+void write_model(const std::string& path) {
+    std::ofstream out(path, std::ios::binary);
+    out.write("3U3DXGB1", 8);
+    const std::vector<std::string> names = {"count_id", "platoon_same"};
+    const std::uint32_t classes[] = {RATE_DOUBLE, RATE_HBP, RATE_HR, RATE_OUT, RATE_SINGLE, RATE_STRIKEOUT, RATE_TRIPLE, RATE_WALK};
+    put<std::uint32_t>(out, 1);   // version
+    put<std::uint32_t>(out, 2);   // features
+    put<std::uint32_t>(out, 8);   // classes
+    put<std::uint32_t>(out, 8);   // trees
+    put<std::uint32_t>(out, 10);  // nodes
+    for (const auto& n : names) {
+        put<std::uint32_t>(out, static_cast<std::uint32_t>(n.size()));
+        out.write(n.data(), static_cast<std::streamsize>(n.size()));
+    }
+    for (std::uint32_t c : classes) put(out, c);
+    for (int c = 0; c < 8; ++c) put(out, 0.5f);
+    const std::uint32_t offsets[] = {0, 3, 4, 5, 6, 7, 8, 9, 10};
+    for (std::uint32_t o : offsets) put(out, o);
+    // Tree 0: count_id < 1.5 ? +1 : -1
+    put(out, 1.5f); put<std::int32_t>(out, 0); put<std::uint32_t>(out, 1); put<std::uint32_t>(out, 1);
+    put(out, 1.0f); put<std::int32_t>(out, -1); put<std::uint32_t>(out, 0); put<std::uint32_t>(out, 0);
+    put(out, -1.0f); put<std::int32_t>(out, -1); put<std::uint32_t>(out, 0); put<std::uint32_t>(out, 0);
+    // Trees 1-7: constant leaves 0.1 * class
+    for (int c = 1; c < 8; ++c) {
+        put(out, 0.1f * c); put<std::int32_t>(out, -1); put<std::uint32_t>(out, 0); put<std::uint32_t>(out, 0);
+    }
+}
+
+bool check(const OutcomeModel& model, float count_id, float double_leaf) {
+    const float features[] = {count_id, 0.f};
+    float probs[kNumOutcomeRates];
+    model.predict_proba(features, probs);
+
+    const std::uint32_t classes[] = {RATE_DOUBLE, RATE_HBP, RATE_HR, RATE_OUT, RATE_SINGLE, RATE_STRIKEOUT, RATE_TRIPLE, RATE_WALK};
+    double margin[8];
+    double total = 0.0;
+    for (int c = 0; c < 8; ++c) {
+        margin[c] = std::exp(0.5 + (c == 0 ? double_leaf : 0.1 * c));
+        total += margin[c];
+    }
+    for (int c = 0; c < 8; ++c) {
+        if (std::fabs(probs[classes[c]] - margin[c] / total) > 1e-6) return false;
+    }
+    return true;
+}
+
+// A real XGBClassifier export, written with its predict_proba values by
+// `python baseball_stats/pa_model.py --write-test-fixture tests/data`.
+const std::string kFixture = std::string(THREEUP3DOWN_TEST_DATA_DIR) + "/outcome_model_xgb";
+
+// Largest |OutcomeModel - predict_proba| accepted; pa_model.py's EXPORT_TOLERANCE.
+constexpr double kExportTolerance = 1e-5;
+
+std::vector<std::string> split(const std::string& line) {
+    std::istringstream in(line);
+    std::vector<std::string> fields;
+    for (std::string f; in >> f;) fields.push_back(f);
+    return fields;
+}
+
+// Rows checked against the stored probabilities, or -1 if a row is off by more
+// than kExportTolerance (or the file doesn't line up with the model).
+long check_fixture(const OutcomeModel& model, std::ifstream& expected) {
+    std::string line;
+    std::getline(expected, line);
+    const std::vector<std::string> header = split(line);
+    if (header.size() != model.num_features() + kNumOutcomeRates) return -1;
+    for (std::size_t f = 0; f < model.num_features(); ++f) {
+        if (header[f] != model.feature_names()[f]) return -1;
+    }
+    long rows = 0;
+    while (std::getline(expected, line)) {
+        const std::vector<std::string> fields = split(line);
+        if (fields.empty()) continue;
+        if (fields.size() != header.size()) return -1;
+        std::vector<float> features(model.num_features());
+        for (std::size_t f = 0; f < features.size(); ++f) features[f] = std::strtof(fields[f].c_str(), nullptr);
+        float probs[kNumOutcomeRates];
+        model.predict_proba(features.data(), probs);
+        for (std::size_t k = 0; k < kNumOutcomeRates; ++k) {
+            if (std::fabs(probs[k] - std::strtod(fields[features.size() + k].c_str(), nullptr)) > kExportTolerance) return -1;
+        }
+        ++rows;
+    }
+    return rows;
+}
+
+}  // namespace
+
+int main() {
+    const std::string path = "outcome_model_test.trees";
+    write_model(path);
+    const OutcomeModel model = OutcomeModel::load(path);
+    std::remove(path.c_str());
+
+    if (model.num_features() != 2 || model.num_trees() != 8 || model.feature_names()[0] != "count_id") {
+        std::cerr << "model header read wrong\n";
+        return 1;
+    }
+    if (!check(model, 0.f, 1.0f) || !check(model, 14.f, -1.0f) || !check(model, NAN, 1.0f)) {
+        std::cerr << "predict_proba does not match the hand-computed softmax\n";
+        return 1;
+    }
+
+    std::ifstream expected(kFixture + ".expected");
+    if (!expected) {
+        std::cout << "XGBClassifier fixture skipped (" << kFixture << ".* not generated)\n";
+    } else {
+        const long rows = check_fixture(OutcomeModel::load(kFixture + ".trees"), expected);
+        if (rows <= 0) {
+            std::cerr << "OutcomeModel differs from the fixture's predict_proba by more than " << kExportTolerance << "\n";
+            return 1;
+        }
+    }
+
+    bool threw = false;
+    try {
+        OutcomeModel::load("does_not_exist.trees");
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    if (!threw) {
+        std::cerr << "loading a missing model should throw\n";
+        return 1;
+    }
+
+    std::cout << "OutcomeModel OK\n";
+    return 0;
+}
@@ -0,0 +1,103 @@
+#include "engine/sim/game.hpp"
+#include "engine/sim/pitch_model.hpp"
+#include "engine/sim/season_simulator.hpp"
+#include "tests/test_league.hpp"
+
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+// A left-handed pitcher at `r`, with a three-pitch mix.
+Player pitcher_with_mix(float r) {
+    Player p = make_player(batter_ratings(r), pitcher_ratings(r), Handedness::RIGHT, Handedness::LEFT);
+    p.pitchTypeRatings = PitchTypeRatings{};
+    p.pitchTypeRatings->fastball = Pitch{0.8f, 0.4f, r, 0.6f};
+    p.pitchTypeRatings->slider = Pitch{0.5f, 0.8f, r * 0.8f, 0.3f};
+    p.pitchTypeRatings->changeup = Pitch{0.4f, 0.6f, r, 0.1f};
+    return p;
+}
+
+}  // namespace
+
+int main() {
+    static_assert(kCountTransitions[3 * 4 + 1][static_cast<std::size_t>(PitchResult::BALL)].result
+                      == static_cast<int>(PlateAppearanceResult::WALK), "ball four");
+    static_assert(kCountTransitions[2][static_cast<std::size_t>(PitchResult::FOUL)].next_count == 2, "two-strike foul");
+    static_assert(kCountTransitions[1][static_cast<std::size_t>(PitchResult::FOUL)].next_count == 2, "foul is a strike");
+
+    // Walking the calibrated count reproduces the PA model's outcome mix.
+    RNG rng(5);
+    for (int trial = 0; trial < 100; ++trial) {
+        const float contact = rng.uniform();
+        const float eye = rng.uniform();
+        const OutcomeDistribution pa = outcome_distribution(
+            contact, rng.uniform(), eye, rng.uniform(), rng.uniform(), rng.uniform(), trial & 1);
+        const PitchArsenal arsenal{rng.uniform(), rng.uniform(), rng.uniform()};
+        const PitchCountDistribution dist = pitch_count_distribution(pa, arsenal, contact, eye);
+        float expect[kNumPlateAppearanceResults];
+        outcome_probabilities(pa, expect);
+        double got[kNumPlateAppearanceResults];
+        double pitches = 0.0;
+        count_chain_outcomes(dist, got, pitches);
+        for (std::size_t k = 0; k < kNumPlateAppearanceResults; ++k) {
+            if (std::fabs(got[k] - expect[k]) > 1e-5) {
+                std::cerr << "pitch chain misses PA outcome " << k << ": " << got[k] << " vs " << expect[k] << "\n";
+                return 1;
+            }
+        }
+        if (pitches < 2.5 || pitches > 6.0) {
+            std::cerr << "implausible pitches per PA: " << pitches << "\n";
+            return 1;
+        }
+    }
+
+    // Arsenal is the usage-weighted mix, with the pitcher ratings as a fallback.
+    const PitchArsenal mixed = pitch_arsenal(pitcher_with_mix(0.5f));
+    const PitchArsenal plain = pitch_arsenal(make_player(0.5f));
+    if (std::fabs(mixed.velocity - 0.67f) > 1e-5f || plain.control != 0.5f) {
+        std::cerr << "arsenal weighting wrong\n";
+        return 1;
+    }
+
+    // Season in pitch mode: deterministic, counts pitches, same run environment.
+    RosterStore roster;
+    std::vector<Team> teams(2);
+    for (int t = 0; t < 2; ++t) {
+        teams[t].name = "Team " + std::to_string(t);
+        for (std::size_t s = 0; s < kLineupSize; ++s) {
+            teams[t].lineup.push_back(roster.add(make_player(0.4f + 0.02f * s)));
+        }
+        teams[t].starting_pitcher = roster.add(pitcher_with_mix(0.5f));
+    }
+    std::vector<ScheduledGame> schedule{{0, 1}, {1, 0}};
+    const SeasonSimulator pa_sim(roster, teams, schedule);
+    const SeasonSimulator pitch_sim(roster, teams, schedule, SimulationMode::PITCH);
+    SeasonConfig config;
+    config.seed = 9;
+    config.replications = 1000;
+    config.threads = 2;
+    const SeasonResults a = pitch_sim.run(config);
+    const SeasonResults b = pitch_sim.run(config);
+    const SeasonResults pa = pa_sim.run(config);
+    if (a.teams[0].pitches_thrown != b.teams[0].pitches_thrown || a.teams[1].runs_scored != b.teams[1].runs_scored) {
+        std::cerr << "pitch mode not deterministic\n";
+        return 1;
+    }
+    if (a.teams[0].pitches_thrown == 0 || pa.teams[0].pitches_thrown != 0) {
+        std::cerr << "pitch counts missing\n";
+        return 1;
+    }
+    const double games = 2.0 * config.replications;
+    const double pitch_runs = (a.teams[0].runs_scored + a.teams[1].runs_scored) / games;
+    const double pa_runs = (pa.teams[0].runs_scored + pa.teams[1].runs_scored) / games;
+    if (std::fabs(pitch_runs - pa_runs) > 0.5) {
+        std::cerr << "pitch mode run environment drifted: " << pitch_runs << " vs " << pa_runs << "\n";
+        return 1;
+    }
+    std::cout << "pitch_model ok (" << pitch_runs << " vs " << pa_runs << " runs/game, "
+              << (a.teams[0].pitches_thrown + a.teams[1].pitches_thrown) / games << " pitches/game)\n";
+    return 0;
+}
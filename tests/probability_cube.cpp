@@ -0,0 +1,158 @@
+#include "engine/model/outcome_rates.hpp"
+#include "engine/model/probability_cube.hpp"
+#include "engine/sim/event_log.hpp"
+#include "engine/sim/game.hpp"
+#include "tests/test_league.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+constexpr std::uint32_t kInnings = 3;
+
+// Same layout as baseball_stats/export_prob_cube.py; cell value encodes its own coordinates.
+float cell_tag(std::uint32_t count, std::uint32_t platoon, std::uint32_t inning, std::uint32_t outs) {
+    return static_cast<float>(count * 1000 + platoon * 100 + inning * 10 + outs);
+}
+
+// value(count, platoon, inning, outs, k): entry k of that cell's row.
+template <typename Value>
+void write_cube(const std::string& path, Value value) {
+    std::ofstream out(path, std::ios::binary);
+    char header[64] = {'3', 'U', '3', 'D', 'C', 'U', 'B', 'E'};
+    const std::uint32_t fields[] = {1, 16, 2, kInnings, 3, 8, 1};
+    std::memcpy(header + 8, fields, sizeof(fields));
+    out.write(header, sizeof(header));
+    for (std::uint32_t c = 0; c < 16; ++c)
+        for (std::uint32_t p = 0; p < 2; ++p)
+            for (std::uint32_t i = 0; i < kInnings; ++i)
+                for (std::uint32_t o = 0; o < 3; ++o)
+                    for (int k = 0; k < 8; ++k) {
+                        const float v = value(c, p, i, o, k);
+                        out.write(reinterpret_cast<const char*>(&v), sizeof(v));
+                    }
+}
+
+// For the game loop: at 0 outs, a walk (opposite hands) or HBP (same hand)
+// half the time; at 1 out, a single half the time in the first inning only;
+// otherwise strikeouts at 1 out and outs at 2. Each draw the sim makes can so
+// be traced back to the row it came from.
+float context_row(std::uint32_t, std::uint32_t platoon, std::uint32_t inning, std::uint32_t outs, int k) {
+    static constexpr float kOnBase[2][8] = {{0.5f, 0.5f, 0.5f, 0.5f, 0.5f, 0.5f, 1, 1}, {0, 0.5f, 0.5f, 0.5f, 0.5f, 0.5f, 1, 1}};
+    static constexpr float kSingle[8] = {0, 0, 0.5f, 0.5f, 0.5f, 0.5f, 1, 1};
+    static constexpr float kStrikeout[8] = {0, 0, 0, 0, 0, 0, 1, 1};
+    static constexpr float kOut[8] = {0, 0, 0, 0, 0, 0, 0, 1};
+    if (outs == 0) return kOnBase[platoon][k];
+    if (outs == 1) return inning == 0 ? kSingle[k] : kStrikeout[k];
+    return kOut[k];
+}
+
+// What context_row allows at `before`, for a batter on `same_hand` terms.
+bool allowed(const GameState& before, int same_hand, PlateAppearanceResult r) {
+    using R = PlateAppearanceResult;
+    if (before.outs() == 0) return r == R::STRIKEOUT || r == (same_hand ? R::HBP : R::WALK);
+    if (before.outs() == 1) return r == R::STRIKEOUT || (before.inning() == 1 && r == R::SINGLE);
+    return r == R::OUT;
+}
+
+}  // namespace
+
+int main() {
+    const std::string path = "probability_cube_test.bin";
+    write_cube(path, [](std::uint32_t c, std::uint32_t p, std::uint32_t i, std::uint32_t o, int k) {
+        return k == 0 ? cell_tag(c, p, i, o) : (k + 1) / 8.0f;
+    });
+    {
+        const ProbabilityCube cube = ProbabilityCube::open(path);
+        if (cube.num_innings() != static_cast<int>(kInnings)) {
+            std::cerr << "wrong inning count\n";
+            return 1;
+        }
+        if (cube.row(14, 1, 2, 2)[0] != cell_tag(14, 1, 1, 2)) {
+            std::cerr << "row lookup hit the wrong cell\n";
+            return 1;
+        }
+        // Extra innings reuse the last tabulated inning.
+        if (cube.row(3, 0, 11, 1)[0] != cell_tag(3, 0, kInnings - 1, 1)) {
+            std::cerr << "extra innings not clamped to the last row\n";
+            return 1;
+        }
+        if (sample_cumulative(cube.row(0, 0, 1, 0), 0.6f) != RATE_TRIPLE) {
+            std::cerr << "sample_cumulative picked the wrong outcome\n";
+            return 1;
+        }
+    }
+
+    // Games drawn from the cube: every PA comes from its own context's row.
+    // Both starters throw left; the home side bats left (same hand), the away
+    // side right.
+    write_cube(path, context_row);
+    {
+        const ProbabilityCube cube = ProbabilityCube::open(path);
+        RosterStore roster;
+        std::vector<PlayerId> batters;
+        for (int t = 0; t < 2; ++t) {
+            const Handedness bats = t == 0 ? Handedness::LEFT : Handedness::RIGHT;
+            for (std::size_t s = 0; s < kLineupSize; ++s) batters.push_back(roster.add(make_player(0.5f, bats)));
+        }
+        const std::vector<PlayerId> pitchers = {roster.add(make_player(0.5f, Handedness::LEFT)),
+                                                roster.add(make_player(0.5f, Handedness::LEFT))};
+        const CubeOutcomeTable table(cube, roster, batters, pitchers);
+        GameLineup home{};
+        GameLineup away{};
+        for (std::size_t s = 0; s < kLineupSize; ++s) {
+            home.batters[s] = static_cast<std::uint32_t>(s);
+            away.batters[s] = static_cast<std::uint32_t>(kLineupSize + s);
+        }
+        home.pitcher = 0;
+        away.pitcher = 1;
+
+        const std::string log_path = "probability_cube_test_events.bin";
+        std::remove(log_path.c_str());
+        {
+            EventLog log(log_path);
+            EventLogWriter writer = log.writer();
+            for (std::uint64_t seed = 0; seed < 200; ++seed) {
+                RNG rng(seed);
+                simulate_game(table, home, away, rng, GameEventTarget{&writer, batters.data(), pitchers.data(), seed});
+            }
+        }
+        std::uint64_t seen[kNumPlateAppearanceResults] = {};
+        bool traced = true;
+        for (const PlateAppearanceEvent& e : EventLogReader::open(log_path)) {
+            const auto result = static_cast<PlateAppearanceResult>(e.result);
+            const int same_hand = e.batter < batters[kLineupSize] ? 1 : 0;
+            traced = traced && allowed(GameState::from_raw(e.state), same_hand, result);
+            ++seen[e.result];
+        }
+        std::remove(log_path.c_str());
+        using R = PlateAppearanceResult;
+        if (!traced || !seen[static_cast<int>(R::WALK)] || !seen[static_cast<int>(R::HBP)] ||
+            !seen[static_cast<int>(R::SINGLE)] || !seen[static_cast<int>(R::OUT)]) {
+            std::cerr << "simulated PAs did not come from their context's cube row\n";
+            return 1;
+        }
+    }
+
+    std::ofstream(path, std::ios::binary | std::ios::trunc).write("3U3DCUBE", 8);
+    bool threw = false;
+    try {
+        ProbabilityCube::open(path);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    std::remove(path.c_str());
+    if (!threw) {
+        std::cerr << "truncated cube should be rejected\n";
+        return 1;
+    }
+
+    std::cout << "ProbabilityCube OK\n";
+    return 0;
+}
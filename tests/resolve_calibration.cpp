@@ -0,0 +1,103 @@
+#include "engine/sim/resolve_calibration.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+int main() {
+    // A league of ratings spread around the middle of the scale.
+    CalibrationPopulation population;
+    RNG rng(7);
+    for (int i = 0; i < 300; ++i) {
+        population.contact.push_back(0.2f + 0.6f * rng.uniform());
+        population.power.push_back(0.2f + 0.6f * rng.uniform());
+        population.eye.push_back(0.2f + 0.6f * rng.uniform());
+    }
+    for (int i = 0; i < 120; ++i) {
+        population.stuff.push_back(0.2f + 0.6f * rng.uniform());
+        population.control.push_back(0.2f + 0.6f * rng.uniform());
+        population.movement.push_back(0.2f + 0.6f * rng.uniform());
+    }
+
+    CalibrationOptions options;
+    options.pairs = 512;
+    options.draws_per_pair = 16;
+    options.candidates = 24;
+    options.max_generations = 150;
+    options.prior_weight = 1e-5;
+    options.threads = 1;
+    options.seed = 3;
+
+    // The sample resolves like outcome_distribution itself.
+    ResolveCalibration serial(population, options);
+    double rates[2][kNumOutcomeRates];
+    serial.rates(kResolveCoefficients, rates);
+    for (std::size_t side = 0; side < 2; ++side) {
+        double total = 0.0;
+        for (double r : rates[side]) total += r;
+        if (std::fabs(total - 1.0) > 1e-12 || rates[side][RATE_WALK] <= 0.0 || rates[side][RATE_HR] <= 0.0) {
+            std::cerr << "side " << side << " rates do not form a distribution\n";
+            return 1;
+        }
+    }
+
+    // Starting well off the league rates, the fit walks back onto them.
+    ResolveCoefficients off = kResolveCoefficients;
+    off[COEF_WALK_SCALE] *= 1.3f;
+    off[COEF_STRIKEOUT_SCALE] *= 0.75f;
+    off[COEF_HOMERUN_SCALE] *= 1.3f;
+    const CalibrationResult fit = serial.fit(off);
+    if (!(fit.loss <= fit.start_loss * 0.05) || fit.evaluations < options.candidates) {
+        std::cerr << "loss " << fit.start_loss << " -> " << fit.loss << "\n";
+        return 1;
+    }
+    for (std::size_t side = 0; side < 2; ++side) {
+        for (OutcomeRateIndex k : {RATE_WALK, RATE_STRIKEOUT, RATE_HR}) {
+            if (std::fabs(fit.rates[side][k] - kPlatoonOutcomeRates[side].prob[k]) > 0.004) {
+                std::cerr << "side " << side << " outcome " << k << ": fitted " << fit.rates[side][k] << " vs league "
+                          << kPlatoonOutcomeRates[side].prob[k] << "\n";
+                return 1;
+            }
+        }
+    }
+
+    // Same answer on more threads.
+    options.threads = 3;
+    ResolveCalibration parallel(population, options);
+    const CalibrationResult again = parallel.fit(off);
+    for (std::size_t i = 0; i < kNumResolveCoefficients; ++i) {
+        if (again.coefficients[i] != fit.coefficients[i] || again.loss != fit.loss) {
+            std::cerr << "coefficient " << kResolveCoefficientNames[i] << " depends on the thread count\n";
+            return 1;
+        }
+    }
+
+    // Round trip through the JSON the build bakes in.
+    const std::string path = "resolve_calibration_test.json";
+    write_resolve_coefficients_json(fit.coefficients, path);
+    std::ifstream in(path);
+    std::stringstream json;
+    json << in.rdbuf();
+    for (std::size_t i = 0; i < kNumResolveCoefficients; ++i) {
+        const std::string key = std::string("\"") + kResolveCoefficientNames[i] + "\": ";
+        const std::size_t at = json.str().find(key);
+        if (at == std::string::npos || std::strtof(json.str().c_str() + at + key.size(), nullptr) != fit.coefficients[i]) {
+            std::cerr << kResolveCoefficientNames[i] << " does not round-trip\n";
+            return 1;
+        }
+    }
+    std::remove(path.c_str());
+
+    try {
+        ResolveCalibration empty(CalibrationPopulation{}, options);
+        std::cerr << "empty population accepted\n";
+        return 1;
+    } catch (const std::invalid_argument&) {
+    }
+
+    std::cout << "ResolveCalibration OK (loss " << fit.start_loss << " -> " << fit.loss << " in " << fit.generations
+              << " generations)\n";
+    return 0;
+}
@@ -0,0 +1,59 @@
+#include "engine/core/rng.hpp"
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+int main() {
+    // Reference sequence from the PCG32 demo (seed 42, stream 54).
+    const std::uint32_t expected[] = {0xa15c02b7u, 0x7b47f409u, 0xba1d3330u, 0x83d2f293u, 0xbfa4784bu, 0xcbed606eu};
+    Pcg32 pcg(42, 54);
+    for (std::uint32_t e : expected) {
+        if (pcg() != e) {
+            std::cerr << "Pcg32 does not match the reference sequence\n";
+            return 1;
+        }
+    }
+
+    Pcg32 stepped(7, 3);
+    Pcg32 skipped(7, 3);
+    for (int i = 0; i < 1000; ++i) stepped();
+    skipped.advance(1000);
+    if (stepped != skipped) {
+        std::cerr << "Pcg32::advance disagrees with stepping\n";
+        return 1;
+    }
+
+    RNG a(99, 1);
+    RNG b(99, 1);
+    RNG other_stream(99, 2);
+    std::vector<float> bulk(1000);
+    a.fill_uniform(bulk.data(), bulk.size());
+    int same_as_other = 0;
+    for (float v : bulk) {
+        if (v != b.uniform()) {
+            std::cerr << "fill_uniform differs from repeated uniform()\n";
+            return 1;
+        }
+        if (v < 0.f || v >= 1.f) {
+            std::cerr << "uniform() out of [0, 1)\n";
+            return 1;
+        }
+        same_as_other += (v == other_stream.uniform());
+    }
+    if (same_as_other > 10) {
+        std::cerr << "distinct streams are correlated\n";
+        return 1;
+    }
+
+    BasicRNG<Xoshiro128Plus> x(5);
+    double sum = 0.0;
+    for (int i = 0; i < 100000; ++i) sum += x.uniform();
+    if (sum / 100000 < 0.49 || sum / 100000 > 0.51) {
+        std::cerr << "Xoshiro128Plus mean is off\n";
+        return 1;
+    }
+
+    std::cout << "RNG OK\n";
+    return 0;
+}
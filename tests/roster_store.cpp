@@ -0,0 +1,136 @@
+#include "engine/model/roster_store.hpp"
+#include "engine/sim/matchup_table.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+void write_file(const std::string& path, const std::string& contents) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << contents;
+}
+
+template <typename F>
+bool throws_runtime_error(F&& f) {
+    try {
+        f();
+    } catch (const std::runtime_error&) {
+        return true;
+    }
+    return false;
+}
+
+bool same_player(const Player& a, const Player& b) {
+    const bool same_mix = a.pitchTypeRatings.has_value() == b.pitchTypeRatings.has_value() &&
+        (!a.pitchTypeRatings || (a.pitchTypeRatings->fastball.has_value() == b.pitchTypeRatings->fastball.has_value() &&
+                                 a.pitchTypeRatings->slider.has_value() == b.pitchTypeRatings->slider.has_value() &&
+                                 (!a.pitchTypeRatings->slider ||
+                                  a.pitchTypeRatings->slider->usage == b.pitchTypeRatings->slider->usage)));
+    return a.name == b.name && a.age == b.age && a.is_pitcher == b.is_pitcher && a.bats == b.bats &&
+           a.throws == b.throws &&
+           std::memcmp(&a.batterRatings, &b.batterRatings, sizeof(a.batterRatings)) == 0 &&
+           std::memcmp(&a.pitcherRatings, &b.pitcherRatings, sizeof(a.pitcherRatings)) == 0 &&
+           std::memcmp(&a.defenseRatings, &b.defenseRatings, sizeof(a.defenseRatings)) == 0 &&
+           std::memcmp(&a.catcherRatings, &b.catcherRatings, sizeof(a.catcherRatings)) == 0 && same_mix;
+}
+
+}  // namespace
+
+int main() {
+    const std::string csv = "roster_test.csv";
+    const std::string snapshot = "roster_test.bin";
+
+    // Columns in any order, quoted names, optional columns left blank.
+    write_file(csv,
+        "throws,bats,name,age,is_pitcher,contact,power,eye,speed,contact_potential,stuff,control,movement,stamina,"
+        "range,fastball_velocity,fastball_movement,fastball_control,fastball_usage,"
+        "slider_velocity,slider_movement,slider_control,slider_usage\r\n"
+        "R,L,\"Smith, \"\"Smitty\"\" Jr.\",27,0,0.61,0.55,0.4,0.7,0.75,0.1,0.1,0.1,0.1,0.8,,,,,,,,\r\n"
+        "L,S,Ace Lefty,31,true,0.1,0.1,0.1,0.2,,0.82,0.64,0.71,0.9,0.3,0.95,0.4,0.6,0.65,0.85,0.7,0.5,0.35\n"
+        "\n");
+    const RosterStore loaded = load_roster_csv(csv);
+    if (loaded.size() != 2) {
+        std::cerr << "expected 2 players, got " << loaded.size() << "\n";
+        return 1;
+    }
+    const Player& batter = loaded.player(0);
+    const Player& pitcher = loaded.player(1);
+    if (batter.name != "Smith, \"Smitty\" Jr." || batter.bats != Handedness::LEFT || batter.age != 27 ||
+        batter.batterRatings.potential.contact != 0.75f || batter.batterRatings.potential.power != 0.55f ||
+        batter.defenseRatings.current.range != 0.8f || batter.pitchTypeRatings) {
+        std::cerr << "batter row parsed wrong\n";
+        return 1;
+    }
+    if (!pitcher.is_pitcher || pitcher.bats != Handedness::SWITCH || loaded.throws(1) != Handedness::LEFT ||
+        loaded.stuff()[1] != 0.82f || !pitcher.pitchTypeRatings || !pitcher.pitchTypeRatings->slider ||
+        pitcher.pitchTypeRatings->slider->usage != 0.35f || pitcher.pitchTypeRatings->curveball) {
+        std::cerr << "pitcher row parsed wrong\n";
+        return 1;
+    }
+
+    // Snapshot round trip: same columns, same cold data, same matchups.
+    loaded.save_snapshot(snapshot);
+    {
+        const RosterStore mapped = RosterStore::open_snapshot(snapshot);
+        if (!mapped.mapped() || mapped.size() != loaded.size()) {
+            std::cerr << "snapshot did not map\n";
+            return 1;
+        }
+        for (PlayerId id = 0; id < loaded.size(); ++id) {
+            if (mapped.contact()[id] != loaded.contact()[id] || mapped.stamina()[id] != loaded.stamina()[id] ||
+                mapped.bats(id) != loaded.bats(id) || !same_player(mapped.player(id), loaded.player(id))) {
+                std::cerr << "snapshot differs for player " << id << "\n";
+                return 1;
+            }
+        }
+        const MatchupTable a(loaded, {0, 1}, {1});
+        const MatchupTable b(mapped, {0, 1}, {1});
+        if (std::memcmp(&a.at(0, 0), &b.at(0, 0), sizeof(OutcomeDistribution)) != 0 ||
+            std::memcmp(&a.at(1, 0), &b.at(1, 0), sizeof(OutcomeDistribution)) != 0) {
+            std::cerr << "mapped roster gives different matchups\n";
+            return 1;
+        }
+
+        // Copies share the mapping; adding to one copies it out and leaves the other mapped.
+        RosterStore grown = mapped;
+        const PlayerId id = grown.add(loaded.player(0));
+        if (id != 2 || grown.mapped() || !mapped.mapped() || grown.size() != 3 ||
+            grown.contact()[2] != loaded.contact()[0] || grown.player(1).name != "Ace Lefty") {
+            std::cerr << "adding to a mapped roster went wrong\n";
+            return 1;
+        }
+    }
+
+    // Malformed input is refused with a runtime_error.
+    write_file(csv, "name,bats,throws,contact,power,eye,speed,stuff,control,movement\nA,R,R,1,1,1,1,1,1,1\n");
+    if (!throws_runtime_error([&] { load_roster_csv(csv); })) {
+        std::cerr << "missing stamina column accepted\n";
+        return 1;
+    }
+    write_file(csv, "name,bats,throws,contact,power,eye,speed,stuff,control,movement,stamina\nA,X,R,1,1,1,1,1,1,1,1\n");
+    if (!throws_runtime_error([&] { load_roster_csv(csv); })) {
+        std::cerr << "bad handedness accepted\n";
+        return 1;
+    }
+    write_file(csv, "name,bats,throws,contact,power,eye,speed,stuff,control,movement,stamina\nA,R,R,1,1,oops,1,1,1,1,1\n");
+    if (!throws_runtime_error([&] { load_roster_csv(csv); })) {
+        std::cerr << "bad number accepted\n";
+        return 1;
+    }
+    write_file(snapshot, std::string(200, 'x'));
+    if (!throws_runtime_error([&] { RosterStore::open_snapshot(snapshot); })) {
+        std::cerr << "garbage snapshot accepted\n";
+        return 1;
+    }
+    std::remove(csv.c_str());
+    std::remove(snapshot.c_str());
+
+    std::cout << "roster_store ok\n";
+    return 0;
+}
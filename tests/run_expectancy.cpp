@@ -0,0 +1,95 @@
+#include "engine/sim/run_expectancy.hpp"
+#include "tests/test_league.hpp"
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+int main() {
+    RosterStore roster;
+    std::vector<PlayerId> batters;
+    GameLineup lineup{};
+    for (std::size_t s = 0; s < kLineupSize; ++s) {
+        const float r = 0.15f + 0.09f * s;
+        batters.push_back(roster.add(make_player(BatterRatings{r, 1.0f - r, r, 0.5f, 0.5f, 0.5f}, pitcher_ratings(r))));
+        lineup.batters[s] = static_cast<std::uint32_t>(s);
+    }
+    const std::vector<PlayerId> pitchers{roster.add(make_player(0.45f))};
+    const MatchupTable table(roster, batters, pitchers);
+    const RunExpectancySolver solver(table, lineup, 0);
+
+    for (std::size_t s = 0; s < kLineupSize; ++s) {
+        const InningDistribution& inn = solver.half_inning(s);
+        double total = 0.0;
+        double leadoff = 0.0;
+        for (double p : inn.runs) total += p;
+        for (double p : inn.next_leadoff) leadoff += p;
+        if (std::fabs(total - 1.0) > 1e-9 || std::fabs(leadoff - 1.0) > 1e-9 || inn.truncated > 1e-12) {
+            std::cerr << "half-inning distribution does not sum to one\n";
+            return 1;
+        }
+        if (std::fabs(solver.run_expectancy(s)[0] - inn.expected_runs) > 1e-12) {
+            std::cerr << "RE24 empty state disagrees with half_inning\n";
+            return 1;
+        }
+    }
+
+    // Monte Carlo agrees with the exact answer, per half-inning and over nine innings.
+    RNG rng(3);
+    const int trials = 200000;
+    double sum = 0.0;
+    double sum_sq = 0.0;
+    int zero = 0;
+    for (int i = 0; i < trials; ++i) {
+        std::size_t slot = 4;
+        const double runs = simulate_half_inning(table, lineup, 0, slot, -1, rng).runs;
+        sum += runs;
+        sum_sq += runs * runs;
+        zero += runs == 0.0;
+    }
+    const double mean = sum / trials;
+    const double se = std::sqrt((sum_sq / trials - mean * mean) / trials);
+    const InningDistribution& fifth = solver.half_inning(4);
+    if (std::fabs(mean - fifth.expected_runs) > 4 * se) {
+        std::cerr << "MC half-inning mean " << mean << " vs exact " << fifth.expected_runs << "\n";
+        return 1;
+    }
+    const double p0 = static_cast<double>(zero) / trials;
+    if (std::fabs(p0 - fifth.runs[0]) > 4 * std::sqrt(p0 * (1 - p0) / trials)) {
+        std::cerr << "MC scoreless rate " << p0 << " vs exact " << fifth.runs[0] << "\n";
+        return 1;
+    }
+
+    double game_sum = 0.0;
+    double game_sq = 0.0;
+    const int games = 50000;
+    for (int g = 0; g < games; ++g) {
+        std::size_t slot = 0;
+        double runs = 0.0;
+        for (int inning = 0; inning < 9; ++inning) runs += simulate_half_inning(table, lineup, 0, slot, -1, rng).runs;
+        game_sum += runs;
+        game_sq += runs * runs;
+    }
+    const double game_mean = game_sum / games;
+    const double game_se = std::sqrt((game_sq / games - game_mean * game_mean) / games);
+    const double exact = solver.expected_runs();
+    if (std::fabs(game_mean - exact) > 4 * game_se) {
+        std::cerr << "MC nine-inning mean " << game_mean << " vs exact " << exact << "\n";
+        return 1;
+    }
+
+    const std::vector<double> dist = solver.game_runs();
+    double dist_mean = 0.0;
+    double dist_total = 0.0;
+    for (std::size_t r = 0; r < dist.size(); ++r) {
+        dist_mean += r * dist[r];
+        dist_total += dist[r];
+    }
+    if (std::fabs(dist_total - 1.0) > 1e-9 || std::fabs(dist_mean - exact) > 1e-9) {
+        std::cerr << "game run distribution inconsistent with expected_runs\n";
+        return 1;
+    }
+
+    std::cout << "run_expectancy ok (" << exact << " runs / 9, MC " << game_mean << ")\n";
+    return 0;
+}
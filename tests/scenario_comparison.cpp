@@ -0,0 +1,72 @@
+#include "engine/sim/scenario_comparison.hpp"
+#include "tests/test_league.hpp"
+
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+int main() {
+    const int num_teams = 4;
+    RosterStore roster;
+    const std::vector<Team> teams =
+        make_teams(roster, num_teams, [](int, std::size_t) { return 0.5f; }, [](int) { return 0.5f; });
+    const std::vector<ScheduledGame> schedule = round_robin(num_teams, 10);
+    // The what-if: team 0 upgrades its cleanup hitter.
+    std::vector<Team> traded = teams;
+    traded[0].lineup[3] = roster.add(make_player(0.7f));
+
+    const SeasonSimulator before(roster, teams, schedule);
+    const SeasonSimulator after(roster, traded, schedule);
+    SeasonConfig config;
+    config.seed = 11;
+    config.replications = 200;
+    config.threads = 2;
+
+    // A scenario against itself differs by exactly nothing.
+    const ScenarioComparison same = compare_seasons(before, before, config);
+    if (same.wins[0].difference != 0.0 || same.wins[0].standard_error != 0.0 || same.a.replications != 200) {
+        std::cerr << "identical scenarios should not differ\n";
+        return 1;
+    }
+
+    // Common random numbers resolve the trade far better than independent runs would.
+    const ScenarioComparison crn = compare_seasons(before, after, config);
+    const ScenarioDifference& gain = crn.runs_scored[0];
+    if (gain.difference <= 0.0 || gain.variance_reduction < 5.0 || crn.wins[0].variance_reduction < 2.0) {
+        std::cerr << "common random numbers: runs +" << gain.difference << " reduction " << gain.variance_reduction
+                  << ", wins reduction " << crn.wins[0].variance_reduction << "\n";
+        return 1;
+    }
+    // The paired estimate agrees with the independently simulated means.
+    if (std::fabs(crn.a.teams[0].runs_scored / 200.0 - gain.a_mean) > 1e-9 ||
+        std::fabs(gain.b_mean - gain.a_mean - gain.difference) > 1e-9) {
+        std::cerr << "paired means disagree with the season totals\n";
+        return 1;
+    }
+
+    // Each scenario's totals are exactly what running it alone gives.
+    const SeasonResults alone = before.run(config);
+    if (crn.a.teams[0].season_runs_scored.m2() != alone.teams[0].season_runs_scored.m2() ||
+        crn.a.batters[3].on_base_pct.mean() != alone.batters[3].on_base_pct.mean()) {
+        std::cerr << "scenario totals differ from a plain run\n";
+        return 1;
+    }
+
+    // Same teams and game count, but home and away swapped: not the same league.
+    std::vector<ScheduledGame> flipped = schedule;
+    std::swap(flipped[0].home, flipped[0].away);
+    const SeasonSimulator reversed(roster, teams, flipped);
+    try {
+        compare_seasons(before, reversed, config);
+        std::cerr << "scenarios with different schedules compared\n";
+        return 1;
+    } catch (const std::invalid_argument&) {
+    }
+
+    std::cout << "ScenarioComparison OK (runs +" << gain.difference << " +/- " << gain.standard_error
+              << ", reduction x" << gain.variance_reduction << "; wins x" << crn.wins[0].variance_reduction << ")\n";
+    return 0;
+}
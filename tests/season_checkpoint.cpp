@@ -0,0 +1,125 @@
+#include "engine/sim/season_checkpoint.hpp"
+#include "tests/test_league.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+bool same_projection(const SeasonProjection& a, const SeasonProjection& b) {
+    for (std::size_t t = 0; t < a.final_wins.size(); ++t) {
+        if (std::fabs(a.final_wins[t].mean() - b.final_wins[t].mean()) > 1e-9 ||
+            a.final_wins[t].max() != b.final_wins[t].max() || std::fabs(a.playoff_odds[t] - b.playoff_odds[t]) > 1e-12) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+int main() {
+    const int num_teams = 4;
+    RosterStore roster;
+    const std::vector<Team> teams = make_teams(
+        roster, num_teams, [](int t, std::size_t s) { return 0.4f + 0.05f * t + 0.01f * s; },
+        [](int) { return 0.5f; });
+    const std::vector<ScheduledGame> schedule = round_robin(num_teams, 6);
+    const SeasonSimulator sim(roster, teams, schedule);
+    const std::size_t reps = 300;
+    ProjectionConfig config;
+    config.playoff_spots = 2;
+    config.threads = 2;
+
+    // Opening day: the projection is the full-season Monte Carlo, game for game.
+    SeasonCheckpoint checkpoint(sim, 5, reps);
+    const SeasonProjection opening = checkpoint.project(sim, config);
+    SeasonConfig season;
+    season.seed = 5;
+    season.replications = reps;
+    const SeasonResults full = sim.run(season);
+    double odds = 0.0;
+    for (int t = 0; t < num_teams; ++t) {
+        odds += opening.playoff_odds[t];
+        if (std::fabs(opening.final_wins[t].mean() - full.mean_wins(t)) > 1e-9) {
+            std::cerr << "opening-day projection differs from the season run for team " << t << "\n";
+            return 1;
+        }
+    }
+    if (std::fabs(odds - 2.0) > 1e-9 || opening.games_simulated != schedule.size() * reps || opening.games_reused != 0) {
+        std::cerr << "opening-day projection accounting is off\n";
+        return 1;
+    }
+
+    // A day of real games: the nightly update only tallies.
+    for (std::size_t g = 0; g < 6; ++g) checkpoint.record_result(g, g % 2 ? 2 : 5, 3);
+    const SeasonProjection nightly = checkpoint.project(sim, config);
+    const std::size_t remaining = schedule.size() - 6;
+    if (nightly.games_simulated != 0 || nightly.games_reused != remaining * reps || checkpoint.games_played() != 6 ||
+        checkpoint.standings()[0].wins + checkpoint.standings()[0].losses == 0) {
+        std::cerr << "nightly update re-simulated unchanged games\n";
+        return 1;
+    }
+    SeasonCheckpoint scratch(sim, 5, reps);
+    for (std::size_t g = 0; g < 6; ++g) scratch.record_result(g, g % 2 ? 2 : 5, 3);
+    if (!same_projection(nightly, scratch.project(sim, config))) {
+        std::cerr << "incremental projection differs from a fresh one\n";
+        return 1;
+    }
+
+    // Through a file: same state, still nothing to re-simulate.
+    const std::string path = "season_checkpoint_test.bin";
+    checkpoint.save(path);
+    SeasonCheckpoint loaded = SeasonCheckpoint::load(path);
+
+    // A count the file can't hold is refused before anything is allocated for it.
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        const std::uint64_t replications = std::uint64_t{1} << 40;
+        file.seekp(8 + 4 + 8);  // magic, version, seed
+        file.write(reinterpret_cast<const char*>(&replications), sizeof(replications));
+    }
+    try {
+        SeasonCheckpoint::load(path);
+        std::cerr << "checkpoint with an absurd replication count loaded\n";
+        return 1;
+    } catch (const std::runtime_error&) {
+    }
+    std::remove(path.c_str());
+    const SeasonProjection resumed = loaded.project(sim, config);
+    if (resumed.games_simulated != 0 || !same_projection(resumed, nightly) || loaded.seed() != 5) {
+        std::cerr << "checkpoint did not survive a save/load\n";
+        return 1;
+    }
+
+    // A trade for team 0: only its remaining games are replayed.
+    std::vector<Team> traded = teams;
+    traded[0].lineup[2] = roster.add(make_player(0.8f));
+    const SeasonSimulator after(roster, traded, schedule);
+    std::size_t team0_games = 0;
+    for (std::size_t g = 6; g < schedule.size(); ++g) team0_games += schedule[g].home == 0 || schedule[g].away == 0;
+    const SeasonProjection updated = loaded.project(after, config);
+    SeasonCheckpoint rebuilt(after, 5, reps);
+    for (std::size_t g = 0; g < 6; ++g) rebuilt.record_result(g, g % 2 ? 2 : 5, 3);
+    if (updated.games_simulated != team0_games * reps || !same_projection(updated, rebuilt.project(after, config)) ||
+        updated.final_wins[0].mean() <= nightly.final_wins[0].mean()) {
+        std::cerr << "trade update replayed " << updated.games_simulated / reps << " games, expected " << team0_games << "\n";
+        return 1;
+    }
+
+    try {
+        loaded.record_result(0, 1, 0);
+        std::cerr << "recorded a game twice\n";
+        return 1;
+    } catch (const std::invalid_argument&) {
+    }
+
+    std::cout << "SeasonCheckpoint OK (team 3 playoff odds " << nightly.playoff_odds[3] << ")\n";
+    return 0;
+}
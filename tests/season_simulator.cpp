@@ -0,0 +1,206 @@
+#include "engine/sim/season_simulator.hpp"
+#include "tests/test_league.hpp"
+
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+bool same_stats(const RunningStats& a, const RunningStats& b) {
+    return a.count() == b.count() && a.mean() == b.mean() && a.m2() == b.m2() && a.min() == b.min() &&
+           a.max() == b.max();
+}
+
+bool same_line(const BattingLine& a, const BattingLine& b) {
+    for (std::size_t r = 0; r < kNumPlateAppearanceResults; ++r) {
+        if (a.results[r] != b.results[r]) return false;
+    }
+    return a.runs_batted_in == b.runs_batted_in;
+}
+
+// Bit for bit, spreads included.
+bool same_results(const SeasonResults& a, const SeasonResults& b) {
+    if (a.replications != b.replications || a.teams.size() != b.teams.size() ||
+        a.batters.size() != b.batters.size() || a.pitchers.size() != b.pitchers.size()) {
+        return false;
+    }
+    for (std::size_t t = 0; t < a.teams.size(); ++t) {
+        const auto& x = a.teams[t];
+        const auto& y = b.teams[t];
+        if (x.wins != y.wins || x.losses != y.losses || x.runs_scored != y.runs_scored ||
+            x.runs_allowed != y.runs_allowed || x.win_histogram != y.win_histogram ||
+            !same_stats(x.season_wins, y.season_wins) || !same_stats(x.season_runs_scored, y.season_runs_scored)) {
+            return false;
+        }
+    }
+    for (std::size_t i = 0; i < a.batters.size(); ++i) {
+        const auto& x = a.batters[i];
+        const auto& y = b.batters[i];
+        if (!same_line(x.line, y.line) || !same_stats(x.batting_average, y.batting_average) ||
+            !same_stats(x.on_base_pct, y.on_base_pct) || !same_stats(x.slugging, y.slugging) ||
+            !same_stats(x.strikeout_rate, y.strikeout_rate) || !same_stats(x.walk_rate, y.walk_rate)) {
+            return false;
+        }
+    }
+    for (std::size_t i = 0; i < a.pitchers.size(); ++i) {
+        const auto& x = a.pitchers[i];
+        const auto& y = b.pitchers[i];
+        if (!same_line(x.against, y.against) || x.games_started != y.games_started ||
+            x.runs_allowed != y.runs_allowed || !same_stats(x.strikeout_rate, y.strikeout_rate) ||
+            !same_stats(x.walk_rate, y.walk_rate) || !same_stats(x.season_runs_allowed, y.season_runs_allowed)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+int main() {
+    const int num_teams = 4;
+    RosterStore roster;
+    const std::vector<Team> teams = make_teams(
+        roster, num_teams, [](int t, std::size_t s) { return 0.3f + 0.1f * t + 0.01f * s; },
+        [](int t) { return 0.4f + 0.05f * t; });
+    const std::vector<ScheduledGame> schedule = round_robin(num_teams, 10);
+
+    SeasonSimulator sim(roster, teams, schedule);
+    SeasonConfig config;
+    config.seed = 7;
+    config.replications = 64;
+
+    config.threads = 1;
+    const SeasonResults serial = sim.run(config);
+    config.threads = 4;
+    const SeasonResults parallel = sim.run(config);
+    if (!same_results(serial, parallel)) {
+        std::cerr << "season results depend on thread count\n";
+        return 1;
+    }
+    // The fold is fixed by replication index, so one replication per node gives
+    // the same bits as run()'s chunks.
+    ReplicationFold by_replication;
+    for (std::size_t rep = 0; rep < config.replications; ++rep) {
+        SeasonResults one = sim.empty_results();
+        sim.simulate_replication(config.seed, rep, one);
+        by_replication.push({rep, 0, std::move(one)});
+    }
+    if (!same_results(serial, by_replication.result(sim.empty_results()))) {
+        std::cerr << "season results depend on chunking\n";
+        return 1;
+    }
+    // A ragged count (partial last chunk, several windows) still ignores threads.
+    config.replications = 75;
+    config.threads = 1;
+    const SeasonResults ragged_serial = sim.run(config);
+    config.threads = 3;
+    if (!same_results(ragged_serial, sim.run(config))) {
+        std::cerr << "ragged season results depend on thread count\n";
+        return 1;
+    }
+    config.replications = 64;
+
+    std::uint64_t decided = 0;
+    for (const auto& team : serial.teams) decided += team.wins;
+    if (serial.replications != 64 || decided == 0 || decided > 64 * schedule.size()) {
+        std::cerr << "season totals look wrong\n";
+        return 1;
+    }
+
+    // Player lines: every PA has a batter and a pitcher, and every run was driven in.
+    std::uint64_t batter_pas = 0;
+    std::uint64_t pitcher_pas = 0;
+    std::uint64_t rbi = 0;
+    std::uint64_t runs = 0;
+    std::uint64_t starts = 0;
+    for (const auto& b : serial.batters) {
+        batter_pas += b.line.plate_appearances();
+        rbi += b.line.runs_batted_in;
+    }
+    for (const auto& p : serial.pitchers) {
+        pitcher_pas += p.against.plate_appearances();
+        starts += p.games_started;
+    }
+    for (const auto& t : serial.teams) runs += t.runs_scored;
+    if (serial.batters.size() != num_teams * kLineupSize || batter_pas == 0 || batter_pas != pitcher_pas ||
+        rbi != runs || starts != 2 * 64 * schedule.size()) {
+        std::cerr << "player totals do not add up\n";
+        return 1;
+    }
+    for (const auto& b : serial.batters) {
+        if (b.on_base_pct.count() != 64) {
+            std::cerr << "batter rate spreads miss seasons\n";
+            return 1;
+        }
+    }
+    const TeamSeasonTotals& team = serial.teams[3];
+    if (std::fabs(team.season_wins.mean() - serial.mean_wins(3)) > 1e-9 ||
+        std::fabs(team.season_runs_scored.mean() - static_cast<double>(team.runs_scored) / 64) > 1e-9 ||
+        team.game_runs.total() != 2 * 10 * (num_teams - 1) * 64) {
+        std::cerr << "team distributions disagree with the totals\n";
+        return 1;
+    }
+
+    // Without player lines the games play the loop with no per-PA hook: the same
+    // team results and starts, and no lines.
+    config.player_lines = false;
+    const SeasonResults lean = sim.run(config);
+    config.player_lines = true;
+    bool lean_ok = lean.replications == serial.replications;
+    for (std::size_t t = 0; t < serial.teams.size(); ++t) {
+        const TeamSeasonTotals& x = serial.teams[t];
+        const TeamSeasonTotals& y = lean.teams[t];
+        lean_ok = lean_ok && x.wins == y.wins && x.runs_scored == y.runs_scored && x.win_histogram == y.win_histogram &&
+                  same_stats(x.season_runs_scored, y.season_runs_scored);
+    }
+    for (const auto& b : lean.batters) lean_ok = lean_ok && b.line.plate_appearances() == 0 && b.on_base_pct.count() == 0;
+    for (std::size_t i = 0; i < serial.pitchers.size(); ++i) {
+        lean_ok = lean_ok && lean.pitchers[i].games_started == serial.pitchers[i].games_started &&
+                  lean.pitchers[i].against.plate_appearances() == 0;
+    }
+    if (!lean_ok) {
+        std::cerr << "season without player lines played differently\n";
+        return 1;
+    }
+
+    // Through the backend interface, the same season.
+    const SeasonRunner& runner = sim;
+    if (!same_results(serial, runner.run(config)) || runner.num_teams() != sim.num_teams() ||
+        runner.fingerprint() != sim.fingerprint()) {
+        std::cerr << "SeasonRunner::run differs from SeasonSimulator::run\n";
+        return 1;
+    }
+
+    // Policies reach the table: league-average matchups ignore every rating.
+    const SeasonSimulator league(roster, teams, schedule, SimulationMode::PLATE_APPEARANCE, FatigueModel(),
+                                 LeagueOutcomes{}, NoPlatoon{});
+    const OutcomeDistribution average = league_outcome_distribution(kLeagueOutcomeRates);
+    const MatchupTable& league_table = league.matchup_table();
+    for (std::size_t p = 0; p < league_table.num_pitchers(); ++p) {
+        for (std::size_t b = 0; b < league_table.num_batters(); ++b) {
+            for (std::size_t i = 0; i + 1 < kNumPlateAppearanceResults; ++i) {
+                if (league_table.at(b, p).cumulative[i] != average.cumulative[i]) {
+                    std::cerr << "league-outcome season read the ratings\n";
+                    return 1;
+                }
+            }
+        }
+    }
+    if (league.fingerprint() == sim.fingerprint()) {
+        std::cerr << "outcome policy missing from the fingerprint\n";
+        return 1;
+    }
+
+    // Each game is reproducible on its own from (seed, replication, game id).
+    RNG a = game_rng(7, 3, 11);
+    RNG b = game_rng(7, 3, 11);
+    if (a.uniform() != b.uniform()) {
+        std::cerr << "game_rng is not deterministic\n";
+        return 1;
+    }
+
+    std::cout << "SeasonSimulator OK (team 3 mean wins " << serial.mean_wins(3) << ")\n";
+    return 0;
+}
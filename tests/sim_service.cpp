@@ -0,0 +1,199 @@
+#include "engine/sim/sim_service.hpp"
+
+#include "engine/sim/game_state.hpp"
+#include "engine/sim/season_simulator.hpp"
+#include "tests/test_league.hpp"
+
+#include <arpa/inet.h>
+#include <cmath>
+#include <iostream>
+#include <netinet/in.h>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+// The service's games one at a time, straight from outcome_distribution.
+MatchupEstimate reference(const RosterStore& roster, const MatchupQuery& q, std::size_t games) {
+    RunningStats wins;
+    MatchupEstimate out;
+    for (std::size_t g = 0; g < games; ++g) {
+        RNG rng = game_rng(q.seed, 0, g);
+        GameState state;
+        while (!state.final()) {
+            const bool bottom = state.bottom();
+            const PlayerId b = (bottom ? q.home_lineup : q.away_lineup)[state.batting_slot()];
+            const PlayerId p = bottom ? q.away_pitcher : q.home_pitcher;
+            const OutcomeDistribution dist = outcome_distribution(
+                roster.contact()[b], roster.power()[b], roster.eye()[b], roster.stuff()[p], roster.control()[p],
+                roster.movement()[p], platoon_same(roster.bats(b), roster.throws(p)));
+            state.apply(sample_outcome(dist, rng.uniform()));
+        }
+        const int h = state.home_score();
+        const int a = state.away_score();
+        wins.add(h > a ? 1.0 : h == a ? 0.5 : 0.0);
+        out.home_runs.add(h);
+        out.away_runs.add(a);
+    }
+    out.games = games;
+    out.home_win_probability = wins.mean();
+    return out;
+}
+
+bool same_estimate(const MatchupEstimate& a, const MatchupEstimate& b) {
+    return a.games == b.games && a.home_win_probability == b.home_win_probability &&
+           a.home_runs.mean() == b.home_runs.mean() && a.away_runs.mean() == b.away_runs.mean();
+}
+
+std::string http_get(std::uint16_t port, const std::string& target) {
+    const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(port);
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        ::close(fd);
+        return "";
+    }
+    const std::string request = "GET " + target + " HTTP/1.1\r\nHost: localhost\r\n\r\n";
+    ::send(fd, request.data(), request.size(), MSG_NOSIGNAL);
+    std::string response;
+    char buf[1024];
+    for (ssize_t got; (got = ::recv(fd, buf, sizeof(buf), 0)) > 0;) response.append(buf, static_cast<std::size_t>(got));
+    ::close(fd);
+    return response;
+}
+
+std::string ids(const std::array<PlayerId, kLineupSize>& lineup) {
+    std::string out;
+    for (PlayerId id : lineup) out += (out.empty() ? "" : ",") + std::to_string(id);
+    return out;
+}
+
+}  // namespace
+
+int main() {
+    RosterStore roster;
+    MatchupQuery strong;
+    MatchupQuery close;
+    for (std::size_t s = 0; s < kLineupSize; ++s) {
+        const Handedness hand = s % 3 ? Handedness::RIGHT : Handedness::LEFT;
+        strong.home_lineup[s] = roster.add(make_player(0.7f + 0.01f * s, hand));
+        strong.away_lineup[s] = roster.add(make_player(0.35f + 0.01f * s, hand));
+    }
+    strong.home_pitcher = roster.add(make_player(0.6f, Handedness::RIGHT));
+    strong.away_pitcher = roster.add(make_player(0.4f, Handedness::LEFT));
+    strong.seed = 11;
+    strong.max_games = 600;
+    close = strong;
+    close.away_lineup = strong.home_lineup;
+    close.away_pitcher = strong.home_pitcher;
+    close.seed = 12;
+    close.max_games = 900;
+    const RosterStore reference_roster = roster;
+
+    // Small lanes, so games of both queries share (and queue for) batches.
+    SimServiceOptions options;
+    options.lanes = 64;
+    SimService service(std::move(roster), options);
+
+    // Alone, or coalesced with another query: game for game the same answer.
+    const MatchupEstimate alone = service.submit(strong).wait();
+    QueryHandle a = service.submit(strong);
+    QueryHandle b = service.submit(close);
+    const MatchupEstimate together = a.wait();
+    const MatchupEstimate other = b.wait();
+    if (alone.status != QueryStatus::COMPLETE || !same_estimate(alone, together) ||
+        !same_estimate(alone, reference(reference_roster, strong, strong.max_games)) ||
+        !same_estimate(other, reference(reference_roster, close, close.max_games))) {
+        std::cerr << "coalesced queries differ from playing them one at a time\n";
+        return 1;
+    }
+    if (alone.home_win_probability < 0.6 || std::fabs(other.home_win_probability - 0.5) > 0.1) {
+        std::cerr << "implausible win probabilities " << alone.home_win_probability << ", "
+                  << other.home_win_probability << "\n";
+        return 1;
+    }
+    const SimServiceStats stats = service.stats();
+    if (stats.queries != 3 || stats.plate_appearances < stats.batches * 32) {
+        std::cerr << "batches are not being filled (" << stats.plate_appearances << " PAs in " << stats.batches << ")\n";
+        return 1;
+    }
+
+    // Early stop: the first prefix of games that meets the target, wherever it ran.
+    MatchupQuery quick = close;
+    quick.max_games = 100000;
+    quick.target_standard_error = 0.03;
+    const MatchupEstimate converged = service.submit(quick).wait();
+    QueryHandle busy = service.submit(strong);
+    const MatchupEstimate again = service.submit(quick).wait();
+    busy.wait();
+    if (converged.status != QueryStatus::CONVERGED || converged.standard_error > 0.03 ||
+        converged.games < quick.min_games || converged.games > 1000 || !same_estimate(converged, again) ||
+        !same_estimate(converged, reference(reference_roster, quick, converged.games))) {
+        std::cerr << "converged after " << converged.games << " games (s.e. " << converged.standard_error << ")\n";
+        return 1;
+    }
+
+    // Cancel: a query far too big to finish comes back with what it has.
+    MatchupQuery huge = strong;
+    huge.max_games = 50000000;
+    QueryHandle running = service.submit(huge);
+    if (running.wait_for(50)) {
+        std::cerr << "huge query finished\n";
+        return 1;
+    }
+    running.cancel();
+    const MatchupEstimate cancelled = running.wait();
+    if (cancelled.status != QueryStatus::CANCELLED || cancelled.games >= huge.max_games) {
+        std::cerr << "cancel did not stop the query\n";
+        return 1;
+    }
+
+    MatchupQuery unknown = strong;
+    unknown.away_pitcher = 999;
+    try {
+        service.submit(unknown);
+        std::cerr << "unknown player accepted\n";
+        return 1;
+    } catch (const std::invalid_argument&) {
+    }
+
+    // The HTTP front, more requests at once than it has connection threads.
+    SimHttpFront front(service, 2);
+    const std::uint16_t port = front.listen(0, "127.0.0.1");
+    std::thread serve([&] { front.serve(); });
+    const std::string target = "/matchup?home=" + ids(strong.home_lineup) + "&away=" + ids(strong.away_lineup) +
+                               "&home_pitcher=" + std::to_string(strong.home_pitcher) +
+                               "&away_pitcher=" + std::to_string(strong.away_pitcher) + "&seed=11&games=600";
+    std::vector<std::string> responses(4);
+    std::vector<std::thread> clients;
+    for (std::string& r : responses) clients.emplace_back([&, port] { r = http_get(port, target); });
+    for (std::thread& t : clients) t.join();
+    const std::string bad = http_get(port, "/matchup?home=1,2&away=3");
+    const std::string partial = http_get(port, target + "0000&budget_ms=20");
+    const std::string missing = http_get(port, "/nowhere");
+    front.stop();
+    serve.join();
+
+    int status = 0;
+    for (const std::string& r : responses) {
+        if (r.rfind("HTTP/1.1 200 OK\r\n", 0) != 0 || r.find("\"status\":\"complete\",\"games\":600,") == std::string::npos) {
+            std::cerr << "bad /matchup response: " << r << "\n";
+            status = 1;
+        }
+    }
+    if (bad.rfind("HTTP/1.1 400", 0) != 0 || missing.rfind("HTTP/1.1 404", 0) != 0 ||
+        partial.find("\"status\":\"cancelled\"") == std::string::npos) {
+        std::cerr << "bad error / partial responses:\n" << bad << "\n" << missing << "\n" << partial << "\n";
+        status = 1;
+    }
+    if (status == 0) {
+        std::cout << "SimService OK (p(home) " << alone.home_win_probability << ", converged after " << converged.games
+                  << " games)\n";
+    }
+    return status;
+}
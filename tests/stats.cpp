@@ -0,0 +1,81 @@
+#include "engine/core/rng.hpp"
+#include "engine/core/stats.hpp"
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+bool close(double a, double b, double tol = 1e-9) {
+    return std::fabs(a - b) <= tol * (1.0 + std::fabs(b));
+}
+
+}  // namespace
+
+int main() {
+    // Known values: 2, 4, 4, 4, 5, 5, 7, 9 has mean 5 and sample variance 32/7.
+    RunningStats small;
+    for (double x : {2.0, 4.0, 4.0, 4.0, 5.0, 5.0, 7.0, 9.0}) small.add(x);
+    if (small.count() != 8 || !close(small.mean(), 5.0) || !close(small.variance(), 32.0 / 7.0) ||
+        small.min() != 2.0 || small.max() != 9.0) {
+        std::cerr << "RunningStats gives the wrong moments\n";
+        return 1;
+    }
+
+    // Chunks merged as a tree match one pass over the whole stream.
+    RNG rng(11, 0);
+    std::vector<double> values(10000);
+    for (double& v : values) v = 1e6 + rng.uniform();  // large offset: naive sums would lose the variance
+    RunningStats whole;
+    for (double v : values) whole.add(v);
+    std::vector<RunningStats> chunks(7);
+    Histogram hist_whole(1e6, 1e6 + 1.0, 20);
+    std::vector<Histogram> hist_chunks(7, Histogram(1e6, 1e6 + 1.0, 20));
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        chunks[i * chunks.size() / values.size()].add(values[i]);
+        hist_whole.add(values[i]);
+        hist_chunks[i % hist_chunks.size()].add(values[i]);
+    }
+    for (std::size_t stride = 1; stride < chunks.size(); stride *= 2) {
+        for (std::size_t i = 0; i + stride < chunks.size(); i += 2 * stride) {
+            chunks[i].merge(chunks[i + stride]);
+            hist_chunks[i].merge(hist_chunks[i + stride]);
+        }
+    }
+    const RunningStats& merged = chunks[0];
+    if (merged.count() != whole.count() || !close(merged.mean(), whole.mean()) ||
+        !close(merged.variance(), whole.variance(), 1e-6) || merged.min() != whole.min() ||
+        !close(whole.variance(), 1.0 / 12.0, 0.05)) {
+        std::cerr << "merged RunningStats disagree with a single pass\n";
+        return 1;
+    }
+    for (std::size_t b = 0; b < hist_whole.bins(); ++b) {
+        if (hist_chunks[0][b] != hist_whole[b]) {
+            std::cerr << "merged histogram differs in bin " << b << "\n";
+            return 1;
+        }
+    }
+
+    Histogram runs(0.0, 10.0, 10);
+    for (double x : {-1.0, 0.0, 0.5, 3.0, 3.0, 9.99, 10.0, 42.0}) runs.add(x);
+    if (runs.underflow() != 1 || runs.overflow() != 2 || runs[0] != 2 || runs[3] != 2 || runs[9] != 1 ||
+        runs.total() != 8 || runs.quantile(0.5) != 3.0) {
+        std::cerr << "histogram binning is off\n";
+        return 1;
+    }
+
+    bool threw = false;
+    try {
+        runs.merge(Histogram(0.0, 5.0, 10));
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    if (!threw) {
+        std::cerr << "histograms with different bins merged\n";
+        return 1;
+    }
+
+    std::cout << "stats ok (sd " << whole.stddev() << ")\n";
+    return 0;
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+// Fixtures shared by the tests: players built from a rating or two, and small
+// leagues of them.
+
+#include "engine/model/roster_store.hpp"
+#include "engine/model/team.hpp"
+#include "engine/sim/season_simulator.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Contact, power and eye at `r`; speed and batted-ball tendencies neutral.
+inline BatterRatings batter_ratings(float r) {
+    return BatterRatings{r, r, r, 0.5f, 0.5f, 0.5f};
+}
+
+// Stuff, control and movement at `r`.
+inline PitcherRatings pitcher_ratings(float r, float stamina = 0.5f) {
+    return PitcherRatings{r, r, r, stamina};
+}
+
+// A 27-year-old with the given ratings as both current and potential, neutral
+// defense and no pitch mix.
+inline Player make_player(
+    const BatterRatings& bat,
+    const PitcherRatings& pit,
+    Handedness bats = Handedness::RIGHT,
+    Handedness throws = Handedness::RIGHT) {
+    const DefenseRatings def{0.5f, 0.5f, 0.5f, 0.5f, 0.5f};
+    const CatcherRatings cat{0.5f, 0.5f, 0.5f, 0.5f};
+    return Player{
+        "Test Player", 27, false, false,
+        bats, throws,
+        Ratings<BatterRatings>{bat, bat},
+        Ratings<PitcherRatings>{pit, pit},
+        Ratings<DefenseRatings>{def, def},
+        Ratings<CatcherRatings>{cat, cat},
+        std::nullopt
+    };
+}
+
+// Batting and pitching both at `r`; bats and throws with `hand`.
+inline Player make_player(float r, Handedness hand = Handedness::RIGHT) {
+    return make_player(batter_ratings(r), pitcher_ratings(r), hand, hand);
+}
+
+// "Team 0", "Team 1", ...: slot s of team t bats at batter(t, s) and the
+// starter pitches at starter(t); no bullpens. Players are added team by team,
+// the lineup before the starter.
+template <typename BatterRating, typename StarterRating>
+std::vector<Team> make_teams(RosterStore& roster, int num_teams, BatterRating batter, StarterRating starter) {
+    std::vector<Team> teams(static_cast<std::size_t>(num_teams));
+    for (int t = 0; t < num_teams; ++t) {
+        Team& team = teams[static_cast<std::size_t>(t)];
+        team.name = "Team " + std::to_string(t);
+        for (std::size_t s = 0; s < kLineupSize; ++s) team.lineup.push_back(roster.add(make_player(batter(t, s))));
+        team.starting_pitcher = roster.add(make_player(starter(t)));
+    }
+    return teams;
+}
+
+// Every ordered (home, away) pair once per round, home-major.
+inline std::vector<ScheduledGame> round_robin(std::uint32_t num_teams, int rounds = 1) {
+    std::vector<ScheduledGame> schedule;
+    for (int round = 0; round < rounds; ++round) {
+        for (std::uint32_t h = 0; h < num_teams; ++h) {
+            for (std::uint32_t a = 0; a < num_teams; ++a) {
+                if (h != a) schedule.push_back({h, a});
+            }
+        }
+    }
+    return schedule;
+}
@@ -0,0 +1,139 @@
+#include "engine/sim/win_probability.hpp"
+#include "tests/test_league.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+GameState make_state(int inning, bool bottom, unsigned base_out, int away, int home, unsigned away_slot, unsigned home_slot) {
+    GameState s;
+    s.set_inning(inning, bottom);
+    s.set_base_out(base_out);
+    s.set_score(away, home);
+    s.set_lineup_slot(false, away_slot);
+    s.set_lineup_slot(true, home_slot);
+    return s;
+}
+
+}  // namespace
+
+int main() {
+    RosterStore roster;
+    std::vector<PlayerId> batters;
+    for (std::size_t s = 0; s < 2 * kLineupSize; ++s) {
+        const float r = (s < kLineupSize ? 0.5f : 0.45f) + 0.02f * static_cast<float>(s % kLineupSize);
+        batters.push_back(roster.add(make_player(r, s % 3 ? Handedness::RIGHT : Handedness::LEFT)));
+    }
+    const std::vector<PlayerId> pitchers = {roster.add(make_player(0.55f, Handedness::RIGHT)),
+                                            roster.add(make_player(0.5f, Handedness::LEFT))};
+    const MatchupTable table(roster, batters, pitchers);
+    const PitchMatchupTable pitches(roster, table, batters, pitchers);
+    GameLineup home{};
+    GameLineup away{};
+    for (std::size_t s = 0; s < kLineupSize; ++s) {
+        home.batters[s] = static_cast<std::uint32_t>(s);
+        away.batters[s] = static_cast<std::uint32_t>(kLineupSize + s);
+    }
+    home.pitcher = 0;
+    away.pitcher = 1;
+    const WinProbabilityTable wp(table, pitches, home, away);
+
+    // One PA of lookahead: a state's value is the outcome-weighted value of the
+    // states it can move to. Covers walk-offs, the skipped bottom of the 9th and
+    // extra innings.
+    const std::vector<GameState> states = {
+        GameState(),
+        make_state(3, false, 13, 1, 2, 4, 7),
+        make_state(7, true, 0, 4, 1, 2, 8),
+        make_state(9, false, 21, 3, 4, 5, 0),
+        make_state(9, true, 23, 2, 2, 1, 6),
+        make_state(9, true, 5, 5, 3, 8, 3),
+        make_state(12, true, 10, 6, 6, 0, 2),
+        make_state(kMaxInnings, true, 0, 7, 7, 3, 3),
+    };
+    for (const GameState& s : states) {
+        const bool bottom = s.bottom();
+        const OutcomeDistribution& dist = table.at((bottom ? home : away).batters[s.batting_slot()], bottom ? away.pitcher : home.pitcher);
+        float p[kNumPlateAppearanceResults];
+        outcome_probabilities(dist, p);
+        double total = 0.0;
+        for (float v : p) total += v;
+        double expected = 0.0;
+        for (std::size_t k = 0; k < kNumPlateAppearanceResults; ++k) {
+            GameState next = s;
+            next.apply(static_cast<PlateAppearanceResult>(k));
+            expected += p[k] / total * wp.lookup(next).home_win;
+        }
+        const WinProbability got = wp.lookup(s);
+        if (got.source != WinProbabilitySource::TABLE || std::fabs(got.home_win - expected) > 1e-9) {
+            std::cerr << "inning " << s.inning() << (bottom ? " bottom" : " top") << ": " << got.home_win
+                      << " but one PA ahead gives " << expected << "\n";
+            return 1;
+        }
+    }
+
+    // Against Monte Carlo from the same states. Rollouts stop counting runs at a
+    // walk-off and the table's RE24 doesn't, so runs are compared before the 9th.
+    for (const GameState& s : {states[0], states[2], states[4]}) {
+        const WinProbability exact = wp.lookup(s);
+        const WinProbability mc = wp.rollout(s, 20000);
+        const double se = std::sqrt(0.25 / 20000.0);
+        if (std::fabs(exact.home_win - mc.home_win) > 4.0 * se ||
+            (s.inning() < 9 && std::fabs(exact.expected_inning_runs - mc.expected_inning_runs) > 0.05)) {
+            std::cerr << "inning " << s.inning() << ": table " << exact.home_win << " vs rollouts " << mc.home_win << " (runs "
+                      << exact.expected_inning_runs << " vs " << mc.expected_inning_runs << ")\n";
+            return 1;
+        }
+    }
+
+    // Mid-PA counts: exact from the count chain, and the hitter's count is worth
+    // more to the batting (home) side.
+    GameState full = states[4];
+    full.set_count_id(3 * 4 + 0);
+    GameState behind = states[4];
+    behind.set_count_id(0 * 4 + 2);
+    const WinProbability ahead_in_count = wp.lookup(full);
+    const WinProbability behind_in_count = wp.lookup(behind);
+    const WinProbability count_mc = wp.rollout(full, 20000);
+    if (ahead_in_count.source != WinProbabilitySource::TABLE ||
+        ahead_in_count.home_win <= behind_in_count.home_win + 0.05 ||
+        std::fabs(ahead_in_count.home_win - count_mc.home_win) > 4.0 * std::sqrt(0.25 / 20000.0)) {
+        std::cerr << "count 3-0: " << ahead_in_count.home_win << " (rollouts " << count_mc.home_win << "), 0-2: "
+                  << behind_in_count.home_win << "\n";
+        return 1;
+    }
+
+    // Outside the table: rollouts. Final states: exact.
+    const GameState blowout = make_state(5, false, 0, 0, 35, 0, 0);
+    GameState over = states[4];
+    over.set_final(true);
+    over.set_score(2, 3);
+    if (wp.in_table(blowout) || wp.lookup(blowout).source != WinProbabilitySource::ROLLOUT ||
+        wp.lookup(blowout).home_win != 1.0 || wp.lookup(over).source != WinProbabilitySource::FINAL ||
+        wp.lookup(over).home_win != 1.0) {
+        std::cerr << "fallback / final states wrong\n";
+        return 1;
+    }
+
+    // Per-pitch graphics budget: well under a millisecond a lookup, even unoptimized.
+    const auto begin = std::chrono::steady_clock::now();
+    double sink = 0.0;
+    const int lookups = 2000;
+    for (int i = 0; i < lookups; ++i) {
+        GameState s = states[1 + i % (states.size() - 1)];
+        s.set_count_id(static_cast<unsigned>(i % 3));
+        sink += wp.lookup(s).home_win;
+    }
+    const double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count() / lookups;
+    if (us > 1000.0 || !(sink > 0.0)) {
+        std::cerr << "lookup took " << us << " us\n";
+        return 1;
+    }
+
+    std::cout << "WinProbability OK (home " << wp.lookup(GameState()).home_win << " at first pitch, " << us
+              << " us/lookup)\n";
+    return 0;
+}
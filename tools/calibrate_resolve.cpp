@@ -0,0 +1,107 @@
+// Fits the outcome_distribution() rating coefficients to the league rates baked
+// in from baseball_stats/pa_outcome_rates*.json and writes them out for the
+// build to bake in next time. Meant to run nightly right after pa_model.py:
+//
+//   python baseball_stats/pa_model.py
+//   cmake --build build --target threeup3down_calibrate
+//   build/threeup3down_calibrate --roster league.csv --out baseball_stats/resolve_coefficients.json
+//   cmake --build build    # regenerates engine/generated/resolve_coefficients_data.hpp
+//
+// --roster takes a roster CSV (load_roster_csv) or a snapshot (.snap), and is
+// the rating population the league rates are averaged over.
+
+#include "engine/sim/resolve_calibration.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <string>
+
+namespace {
+
+void usage() {
+    std::cerr << "usage: threeup3down_calibrate --roster <csv|snap> [--out <json>] [--threads N] [--generations N]\n"
+                 "                              [--candidates N] [--pairs N] [--draws N] [--prior W] [--seed S]\n"
+                 "                              [--fit-clamps]\n";
+}
+
+bool ends_with(const std::string& s, const std::string& suffix) {
+    return s.size() >= suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::string roster_path;
+    std::string out_path = "resolve_coefficients.json";
+    CalibrationOptions options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--fit-clamps") {
+            options.fit_clamp_bounds = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            usage();
+            return 2;
+        }
+        const char* value = argv[++i];
+        if (arg == "--roster") {
+            roster_path = value;
+        } else if (arg == "--out") {
+            out_path = value;
+        } else if (arg == "--threads") {
+            options.threads = std::strtoull(value, nullptr, 10);
+        } else if (arg == "--generations") {
+            options.max_generations = std::strtoull(value, nullptr, 10);
+        } else if (arg == "--candidates") {
+            options.candidates = std::strtoull(value, nullptr, 10);
+        } else if (arg == "--pairs") {
+            options.pairs = std::strtoull(value, nullptr, 10);
+        } else if (arg == "--draws") {
+            options.draws_per_pair = std::strtoull(value, nullptr, 10);
+        } else if (arg == "--prior") {
+            options.prior_weight = std::strtod(value, nullptr);
+        } else if (arg == "--seed") {
+            options.seed = std::strtoull(value, nullptr, 10);
+        } else {
+            usage();
+            return 2;
+        }
+    }
+    if (roster_path.empty()) {
+        usage();
+        return 2;
+    }
+
+    try {
+        const RosterStore roster =
+            ends_with(roster_path, ".snap") ? RosterStore::open_snapshot(roster_path) : load_roster_csv(roster_path);
+        const auto begin = std::chrono::steady_clock::now();
+        ResolveCalibration calibration(calibration_population(roster), options);
+        const CalibrationResult fit = calibration.fit();
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        write_resolve_coefficients_json(fit.coefficients, out_path);
+
+        std::printf("loss %.3g -> %.3g after %zu generations (%zu candidates of %zu PAs, %.1f s)\n", fit.start_loss,
+                    fit.loss, fit.generations, fit.evaluations, calibration.sample_size(), seconds);
+        for (std::size_t i = 0; i < kNumResolveCoefficients; ++i) {
+            std::printf("  %-21s %.6g -> %.6g\n", kResolveCoefficientNames[i], kResolveCoefficients[i],
+                        fit.coefficients[i]);
+        }
+        const char* sides[2] = {"opposite", "same"};
+        for (std::size_t side = 0; side < 2; ++side) {
+            std::printf("  %-8s  walk %.4f (league %.4f)  K %.4f (%.4f)  HR %.4f (%.4f)\n", sides[side],
+                        fit.rates[side][RATE_WALK], kPlatoonOutcomeRates[side].prob[RATE_WALK],
+                        fit.rates[side][RATE_STRIKEOUT], kPlatoonOutcomeRates[side].prob[RATE_STRIKEOUT],
+                        fit.rates[side][RATE_HR], kPlatoonOutcomeRates[side].prob[RATE_HR]);
+        }
+        std::printf("wrote %s\n", out_path.c_str());
+    } catch (const std::exception& e) {
+        std::cerr << "threeup3down_calibrate: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}